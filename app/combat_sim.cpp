@@ -0,0 +1,467 @@
+#include "bak/character.hpp"
+#include "bak/combat/combat.hpp"
+#include "bak/combat/ICombatUI.hpp"
+#include "bak/combat/mechanics.hpp"
+#include "bak/gameState.hpp"
+#include "bak/inventory.hpp"
+#include "bak/types.hpp"
+
+#include "game/combat/combatManager.hpp"
+#include "game/combat/gridAlgorithms.hpp"
+#include "game/combat/ICombatStage.hpp"
+
+extern "C" {
+#include "com/getopt.h"
+}
+
+#include "com/bits.hpp"
+#include "com/logger.hpp"
+#include "com/path.hpp"
+#include "com/random.hpp"
+#include "com/threadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Fights a combat from a save many times over without rendering it, and
+// reports how often the party wins and how quickly battles are simulated.
+//
+// Battles run in parallel on the shared thread pool. Battle i uses its own
+// random stream seeded with seed + i, so results are repeatable regardless
+// of how many threads there are.
+//
+// There is no enemy AI yet, so every combatant, party or enemy, plays the
+// same policy: thrust at the nearest opponent, moving next to it if need
+// be, otherwise move towards it.
+//
+// Usage: combat_sim [-n battles] [-s seed] [-m max turns] [-g game data] <savefile> <combat index>
+
+namespace {
+
+using Game::Combat::CombatManager;
+using Game::Combat::Combatant;
+using Game::Combat::GridPos;
+
+struct Options
+{
+    std::string mInputFile{};
+    std::string mGameData{};
+    unsigned mCombatIndex{0};
+    unsigned mBattles{1000};
+    std::uint64_t mSeed{1};
+    unsigned mMaxTurns{500};
+};
+
+Options Parse(int argc, char** argv)
+{
+    Options values{};
+
+    struct option options[] = {
+        {"help", no_argument, 0, 'h'},
+        {"battles", required_argument, 0, 'n'},
+        {"seed", required_argument, 0, 's'},
+        {"max-turns", required_argument, 0, 'm'},
+        {"game-data", required_argument, 0, 'g'},
+    };
+    int optionIndex = 0;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "hn:s:m:g:", options, &optionIndex)) != -1)
+    {
+        if (opt == 'h')
+        {
+            std::cout << "Simulates a combat from a save file many times and reports the outcomes.\n";
+            std::cout << "\t--battles,-n    :: number of battles to fight (default 1000)\n";
+            std::cout << "\t--seed,-s       :: seed of the first battle (default 1)\n";
+            std::cout << "\t--max-turns,-m  :: turns before a battle is abandoned (default 500)\n";
+            std::cout << "\t--game-data,-g  :: path to game data directory\n";
+            std::cout << "\t<savefile>      :: .GAM save file to load the party and enemies from\n";
+            std::cout << "\t<combat index>  :: combat entity list to fight\n";
+            exit(0);
+        }
+        else if (opt == 'n')
+        {
+            values.mBattles = std::stoul(optarg);
+        }
+        else if (opt == 's')
+        {
+            values.mSeed = std::stoull(optarg);
+        }
+        else if (opt == 'm')
+        {
+            values.mMaxTurns = std::stoul(optarg);
+        }
+        else if (opt == 'g')
+        {
+            values.mGameData = optarg;
+        }
+    }
+
+    if (optind < argc)
+    {
+        values.mInputFile = argv[optind++];
+    }
+
+    if (optind < argc)
+    {
+        values.mCombatIndex = std::stoul(argv[optind++]);
+    }
+
+    return values;
+}
+
+// Starting state of one side's combatant. Each battle fights with copies,
+// including of the inventory, as attacks dull weapons and armour.
+struct SimCombatant
+{
+    BAK::Character mCharacter;
+    BAK::Inventory mInventory;
+    BAK::MonsterIndex mMonster;
+    GridPos mGridPos;
+};
+
+// Completes each animation as soon as it is started. Completions are queued
+// rather than called directly so that the combat manager is never re-entered.
+class SimStage : public Game::Combat::ICombatStage
+{
+public:
+    void MoveCombatant(BAK::EntityIndex, glm::uvec2, glm::uvec2 targetGrid) override
+    {
+        mPending.emplace_back([targetGrid](auto& manager){
+            manager.CompleteMove(GridPos{targetGrid});
+        });
+    }
+
+    void SetCombatantAction(BAK::EntityIndex, BAK::AnimationType) override {}
+    void SetCombatantDirection(BAK::EntityIndex, BAK::Direction) override {}
+    void SetCombatantUpdateIdle(BAK::EntityIndex, bool) override {}
+    void AnimateCombatant(BAK::EntityIndex) override {}
+
+    void AnimateCombatant(BAK::EntityIndex, std::function<void()> callback) override
+    {
+        mPending.emplace_back([callback = std::move(callback)](auto&){
+            callback();
+        });
+    }
+
+    void AnimateAttack(BAK::EntityIndex, glm::uvec2 targetGrid) override
+    {
+        mPending.emplace_back([targetGrid](auto& manager){
+            manager.CompleteAttack(GridPos{targetGrid});
+        });
+    }
+
+    void FlashCombatant(BAK::EntityIndex, glm::vec4) override {}
+
+    void CombatFinished(BAK::CombatResult result) override
+    {
+        mResult = result;
+    }
+
+    void DisplayText(BAK::EntityIndex, std::string, TextColor) override {}
+
+    bool HasPending() const { return !mPending.empty(); }
+
+    void RunPending(CombatManager& manager)
+    {
+        while (!mPending.empty())
+        {
+            auto next = std::move(mPending.front());
+            mPending.pop_front();
+            next(manager);
+        }
+    }
+
+    const std::optional<BAK::CombatResult>& GetResult() const { return mResult; }
+
+private:
+    std::deque<std::function<void(CombatManager&)>> mPending{};
+    std::optional<BAK::CombatResult> mResult{};
+};
+
+class NullCombatUI : public BAK::ICombatUI
+{
+public:
+    void SetSelectedCharacter(BAK::CharIndex) override {}
+    void DisplayMeleeInfo(BAK::MeleeInfo) override {}
+    void ResetDisplay() override {}
+};
+
+const Combatant* FindNearestOpponent(
+    const std::vector<Combatant>& combatants,
+    const Combatant& me)
+{
+    const Combatant* nearest = nullptr;
+    auto nearestDistance = std::numeric_limits<unsigned>::max();
+    for (const auto& combatant : combatants)
+    {
+        if (combatant.IsDead()
+            || combatant.mCharacter->IsEnemy() == me.mCharacter->IsEnemy())
+        {
+            continue;
+        }
+
+        const auto distance = Game::Combat::ChebyshevDistance(me.mGridPos, combatant.mGridPos);
+        if (distance < nearestDistance)
+        {
+            nearest = &combatant;
+            nearestDistance = distance;
+        }
+    }
+    return nearest;
+}
+
+std::optional<GridPos> SelectApproach(const Game::Combat::Grid& grid, GridPos target)
+{
+    std::optional<GridPos> best{};
+    auto bestDistance = std::numeric_limits<unsigned>::max();
+    for (unsigned x = 0; x < grid.GetCols(); x++)
+    {
+        for (unsigned y = 0; y < grid.GetRows(); y++)
+        {
+            const auto cell = GridPos{static_cast<int>(x), static_cast<int>(y)};
+            if (!grid.CanMoveTo(cell))
+            {
+                continue;
+            }
+
+            const auto distance = Game::Combat::ChebyshevDistance(cell, target);
+            if (distance < bestDistance)
+            {
+                best = cell;
+                bestDistance = distance;
+            }
+        }
+    }
+    return best;
+}
+
+void TakeTurn(CombatManager& manager, SimStage& stage)
+{
+    const auto& me = manager.GetActiveCombatant();
+    const auto* target = FindNearestOpponent(manager.GetCombatants(), me);
+    // Attacking without a weapon is not handled by the combat manager
+    const bool canAttack = me.mCharacter->GetMeleeWeapon() != nullptr;
+    const auto& grid = manager.GetGrid();
+
+    if (target && canAttack && grid.CanAttack(me.mGridPos, target->mGridPos))
+    {
+        manager.GridCellClicked(target->mGridPos, false);
+    }
+    else if (target)
+    {
+        if (auto cell = SelectApproach(grid, target->mGridPos))
+        {
+            manager.GridCellClicked(*cell, false);
+        }
+    }
+
+    if (!stage.HasPending())
+    {
+        manager.DoDefend();
+    }
+}
+
+enum class Outcome
+{
+    Won,
+    Lost,
+    Unfinished
+};
+
+struct BattleResult
+{
+    Outcome mOutcome;
+    unsigned mTurns;
+};
+
+BattleResult FightBattle(
+    const std::vector<SimCombatant>& scenario,
+    std::uint64_t seed,
+    unsigned maxTurns)
+{
+    auto random = Random{seed};
+    auto scope = ScopedRandom{random};
+
+    std::vector<BAK::Inventory> inventories{};
+    std::vector<BAK::Character> characters{};
+    inventories.reserve(scenario.size());
+    characters.reserve(scenario.size());
+
+    auto stage = SimStage{};
+    auto ui = NullCombatUI{};
+    auto manager = CombatManager{stage, ui};
+    for (unsigned i = 0; i < scenario.size(); i++)
+    {
+        auto& inventory = inventories.emplace_back(scenario[i].mInventory);
+        auto& character = characters.emplace_back(scenario[i].mCharacter);
+        character.mInventory = &inventory;
+        manager.AddCombatant(Combatant{
+            &character,
+            scenario[i].mMonster,
+            scenario[i].mGridPos,
+            BAK::Combat::CombatantState::Alive,
+            BAK::EntityIndex{i}});
+    }
+
+    manager.BeginCombat();
+
+    unsigned turns = 0;
+    while (!stage.GetResult() && turns < maxTurns)
+    {
+        TakeTurn(manager, stage);
+        stage.RunPending(manager);
+        turns++;
+    }
+
+    if (!stage.GetResult())
+    {
+        return BattleResult{Outcome::Unfinished, turns};
+    }
+
+    // CheckCombatFinished reports a win either way
+    for (const auto& combatant : manager.GetCombatants())
+    {
+        if (!combatant.mCharacter->IsEnemy() && !combatant.IsDead())
+        {
+            return BattleResult{Outcome::Won, turns};
+        }
+    }
+    return BattleResult{Outcome::Lost, turns};
+}
+
+std::vector<SimCombatant> LoadScenario(
+    BAK::GameState& gameState,
+    BAK::CombatIndex combatIndex,
+    const Logging::Logger& logger)
+{
+    std::vector<SimCombatant> scenario{};
+
+    for (auto combatantIndex : gameState.GetCombatEntityList(combatIndex).mCombatants)
+    {
+        const auto& cgl = gameState.GetCombatantGridLocation(combatantIndex);
+        if (CheckBitSet(cgl.mState, BAK::Combat::CombatantState::Dead))
+        {
+            continue;
+        }
+
+        auto* character = gameState.GetCombatantCharacter(combatantIndex);
+        if (!character || !character->mInventory)
+        {
+            logger.Warn() << "Skipping combatant #" << combatantIndex
+                << " which has no inventory\n";
+            continue;
+        }
+
+        scenario.emplace_back(SimCombatant{
+            *character,
+            *character->mInventory,
+            cgl.mMonster,
+            GridPos{cgl.mGridPos}});
+    }
+
+    gameState.GetParty().ForEachActiveCharacter([&](auto& character)
+    {
+        scenario.emplace_back(SimCombatant{
+            character,
+            character.GetInventory(),
+            character.GetMonsterIndex(),
+            GridPos{character.GetGridPos()}});
+        return BAK::Loop::Continue;
+    });
+
+    return scenario;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const auto& logger = Logging::LogState::GetLogger("main");
+    Logging::LogState::SetLevel(Logging::LogLevel::Info);
+    Logging::LogState::SetLogTime(false);
+    Logging::LogState::Disable("CreateFileBuffer");
+
+    const auto options = Parse(argc, argv);
+
+    if (options.mInputFile.empty())
+    {
+        logger.Error() << "No input file specified\n";
+        return 1;
+    }
+
+    if (!options.mGameData.empty())
+    {
+        Paths::Get().SetBakDirectory(options.mGameData);
+    }
+
+    logger.Info() << "Loading save: " << options.mInputFile << std::endl;
+    auto gameState = BAK::GameState{};
+    gameState.LoadGame(options.mInputFile);
+
+    const auto scenario = LoadScenario(
+        gameState,
+        BAK::CombatIndex{options.mCombatIndex},
+        logger);
+    const auto enemies = std::count_if(scenario.begin(), scenario.end(),
+        [](const auto& combatant){ return combatant.mCharacter.IsEnemy(); });
+    if (enemies == 0 || static_cast<std::size_t>(enemies) == scenario.size())
+    {
+        logger.Error() << "Combat #" << options.mCombatIndex
+            << " needs both enemies and party members, has " << enemies
+            << " of " << scenario.size() << " combatants as enemies\n";
+        return 1;
+    }
+
+    logger.Info() << "Fighting combat #" << options.mCombatIndex << " "
+        << options.mBattles << " times with " << enemies << " enemies on "
+        << ThreadPool::Get().GetThreadCount() << " threads\n";
+
+    // Every turn of every battle logs, which would dominate the run time
+    Logging::LogState::SetLevel(Logging::LogLevel::Warn);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto results = ThreadPool::Get().Map(
+        options.mBattles,
+        [&](std::size_t i){
+            return FightBattle(scenario, options.mSeed + i, options.mMaxTurns);
+        });
+    const auto elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    Logging::LogState::SetLevel(Logging::LogLevel::Info);
+
+    unsigned won = 0;
+    unsigned lost = 0;
+    unsigned unfinished = 0;
+    std::uint64_t turns = 0;
+    for (const auto& result : results)
+    {
+        switch (result.mOutcome)
+        {
+        case Outcome::Won: won++; break;
+        case Outcome::Lost: lost++; break;
+        case Outcome::Unfinished: unfinished++; break;
+        }
+        turns += result.mTurns;
+    }
+
+    const auto battles = std::max(options.mBattles, 1u);
+    logger.Info() << "Won: " << won << " (" << (100.0 * won / battles) << "%)"
+        << " lost: " << lost << " (" << (100.0 * lost / battles) << "%)"
+        << " unfinished: " << unfinished << "\n";
+    logger.Info() << "Average turns per battle: "
+        << (static_cast<double>(turns) / battles) << "\n";
+    logger.Info() << "Simulated " << turns << " turns in " << elapsed << "s, "
+        << (turns / elapsed) << " turns/s, "
+        << (options.mBattles / elapsed) << " battles/s\n";
+
+    return 0;
+}
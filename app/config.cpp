@@ -18,6 +18,7 @@ Paths LoadPaths(const nlohmann::json& config)
         paths.mSaves = c.value("Saves", "");
         paths.mGameData = c.value("GameData", "");
         paths.mGraphicsOverrides = c.value("GraphicsOverrides", "");
+        paths.mZoneCache = c.value("ZoneCache", "");
         paths.mDialogMods = c.value("DialogMods", "");
         paths.mLuaMods = c.value("LuaMods", "");
     }
@@ -47,6 +48,7 @@ Logging LoadLogging(const nlohmann::json& config)
     {
         const auto& c = config["Logging"];
         logging.mLogToFile = c.value("LogToFile", true);
+        logging.mAsyncLogging = c.value("AsyncLogging", true);
         logging.mLogFilePath = c.value("LogFilePath", "");
         logging.mLogLevel = c.value("LogLevel", "Debug");
         if (c.contains("DisabledLoggers"))
@@ -92,6 +94,7 @@ Game LoadGame(const nlohmann::json& config)
         game.mWallSlide = c.value("WallSlide", false);
         game.mNonRotatingMap = c.value("NonRotatingMap", false);
         game.mMoveUnitsPerSecond = c.value("MoveUnitsPerSecond", 6400.0);
+        game.mAsyncZoneLoading = c.value("AsyncZoneLoading", true);
     }
     return game;
 }
@@ -11,6 +11,7 @@ struct Paths
     std::string mSaves{};
     std::string mGameData{};
     std::string mGraphicsOverrides{};
+    std::string mZoneCache{};
     std::string mDialogMods{};
     std::string mLuaMods{};
 };
@@ -28,6 +29,7 @@ struct Graphics
 struct Logging
 {
     bool mLogToFile{true};
+    bool mAsyncLogging{true};
     bool mLogTime{true};
     bool mLogColours{false};
     std::string mLogFilePath{};
@@ -51,6 +53,7 @@ struct Game
     bool mWallSlide{false};
     bool mNonRotatingMap{false};
     double mMoveUnitsPerSecond{6400.0};
+    bool mAsyncZoneLoading{true};
 };
 
 struct Config
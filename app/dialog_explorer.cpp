@@ -97,7 +97,8 @@ int main(int argc, char** argv)
                 ImGui::TextWrapped(ss.str().c_str());
             }
 
-            ImGui::TextWrapped("Text:\n %s", snippet.GetText().data());
+            ImGui::TextWrapped("Text:\n %.*s",
+                static_cast<int>(snippet.GetText().size()), snippet.GetText().data());
 
             for (const auto& choice : snippet.GetChoices())
             {
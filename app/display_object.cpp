@@ -83,8 +83,8 @@ int main(int argc, char** argv)
     auto renderData = Graphics::RenderData{};
     renderData.LoadData(
         zoneData->mObjects,
-        zoneData->mZoneTextures.GetTextures(),
-        zoneData->mZoneTextures.GetMaxDim());
+        zoneData->mZoneTextures.GetAtlas().GetLayers(),
+        zoneData->mZoneTextures.GetAtlas().GetLayerDim());
 
     Camera lightCamera{
         glm::vec2{nativeWidth, nativeHeight},
@@ -112,8 +112,8 @@ int main(int argc, char** argv)
     auto systems = Systems{};
 
     std::vector<std::string> objectNames;
-    objectNames.reserve(zoneData->mObjects.mObjects.size());
-    for (const auto& [name, offsetAndLength] : zoneData->mObjects.mObjects)
+    objectNames.reserve(zoneData->mObjects.GetObjects().size());
+    for (const auto& [name, offsetAndLength] : zoneData->mObjects.GetObjects())
         objectNames.emplace_back(name);
     std::sort(objectNames.begin(), objectNames.end());
 
@@ -308,9 +308,12 @@ int main(int argc, char** argv)
         // Dark blue background
         glClearColor(0.15f, 0.31f, 0.36f, 0.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        renderer.BeginPass();
+        const auto models = renderer.AddDrawList(systems.GetRenderables(), *cameraPtr);
+        renderer.EndPass();
         renderer.DrawWithShadow(
             renderData,
-            systems.GetRenderables(),
+            models,
             light,
             lightCamera,
             *cameraPtr,
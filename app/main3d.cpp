@@ -42,12 +42,16 @@ extern "C" {
 
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <functional>
 #include <memory>
 #include <numbers>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #undef main
 struct Options
@@ -149,6 +153,7 @@ int main(int argc, char** argv)
     const auto config = LoadConfigFile(options.configFile);
     Logging::LogState::SetLogTime(config.mLogging.mLogTime);
     Logging::LogState::SetLogColor(config.mLogging.mLogColours);
+    Logging::LogState::SetAsync(config.mLogging.mAsyncLogging);
     if (options.logLevel != "")
     {
         Logging::LogState::SetLevel(options.logLevel);
@@ -206,6 +211,11 @@ int main(int argc, char** argv)
         Paths::Get().SetModDirectory(config.mPaths.mGraphicsOverrides);
     }
 
+    if (!config.mPaths.mZoneCache.empty())
+    {
+        Paths::Get().SetZoneCacheDirectory(config.mPaths.mZoneCache);
+    }
+
     {
         const auto defaultDialog = (Paths::Get().GetBakDirectoryPath() / "dialogMods").string();
         auto dialogsDir = config.mPaths.mDialogMods.empty()
@@ -327,12 +337,54 @@ int main(int argc, char** argv)
 
     gameRunner.GetMovementManager().SetClipEnabled(config.mGame.mClipEnabled);
     gameRunner.GetMovementManager().SetWallSlide(config.mGame.mWallSlide);
+    gameRunner.SetAsyncZoneLoading(config.mGame.mAsyncZoneLoading);
 
     // Wire up the zone loader to the GUI manager
     guiManager.SetZoneLoader(&gameRunner);
 
     bool imGuiInitialised = false;
 
+    // Reused each frame so culling does not allocate
+    VisibleRenderables lightVisible{};
+    VisibleRenderables cameraVisible{};
+    // For draw lists that are empty in the current view
+    const auto noVisible = std::vector<const Renderable*>{};
+    const auto noRenderables = std::vector<Renderable>{};
+    // Dynamic renderables are drawn in a list per render data. They are
+    // bucketed by render data in one pass over them, and the buckets are
+    // reused each frame so this does not allocate.
+    std::vector<std::pair<const Graphics::RenderData*, std::vector<const DynamicRenderable*>>> dynamicBuckets{};
+    std::unordered_map<const Graphics::RenderData*, std::size_t> dynamicBucketIndices{};
+    std::vector<std::pair<const Graphics::RenderData*, Graphics::Renderer::DrawList>> dynamicLists{};
+    const auto AddDynamicLists = [&](auto&& addList)
+    {
+        dynamicBucketIndices.clear();
+        std::size_t bucketCount = 0;
+        for (const auto& obj : gameRunner.mSystems->GetDynamicRenderables())
+        {
+            const auto* renderData = obj.GetRenderData();
+            const auto [it, inserted] = dynamicBucketIndices.try_emplace(renderData, bucketCount);
+            if (inserted)
+            {
+                if (bucketCount == dynamicBuckets.size())
+                {
+                    dynamicBuckets.emplace_back();
+                }
+                dynamicBuckets[bucketCount].first = renderData;
+                dynamicBuckets[bucketCount].second.clear();
+                bucketCount++;
+            }
+            dynamicBuckets[it->second].second.emplace_back(&obj);
+        }
+
+        dynamicLists.clear();
+        for (std::size_t i = 0; i < bucketCount; i++)
+        {
+            const auto& [renderData, renderables] = dynamicBuckets[i];
+            dynamicLists.emplace_back(renderData, addList(renderables));
+        }
+    };
+
     Graphics::Light light{
         .mDirection =     glm::vec3{.0, -.25,  .00},
         .mAmbientColor =  glm::vec3{.5,  .5,   .5 },
@@ -624,20 +676,39 @@ int main(int argc, char** argv)
             };
             light.mFogColor = ambient * glm::vec3{.15, .31, .36};
 
-            if (gameRunner.GetClipDisplayMode() != Game::ClipDisplayMode::OnlyClips)
+            const auto CullFor = [&](const Camera& camera, VisibleRenderables& visible)
             {
+                gameRunner.mSystems->CullRenderables(
+                    camera.GetProjectionMatrix() * camera.GetViewMatrix(),
+                    camera.GetPosition(),
+                    static_cast<float>(renderer.GetDrawDistance()),
+                    visible);
+            };
+            CullFor(lightCamera, lightVisible);
+            CullFor(GetRenderCamera(), cameraVisible);
+
+            const bool overheadView = gameRunner.mGameState.GetOverheadView();
+            const bool drawZone = gameRunner.GetClipDisplayMode() != Game::ClipDisplayMode::OnlyClips;
+            const bool drawClips = gameRunner.GetClipDisplayMode() != Game::ClipDisplayMode::Vanilla;
+
+            if (drawZone)
+            {
+                renderer.BeginPass();
+                const auto models = renderer.AddDrawList(lightVisible.mRenderables, lightCamera);
+                const auto sprites = overheadView
+                    ? renderer.AddDrawList(noVisible, lightCamera)
+                    : renderer.AddDrawList(lightVisible.mSprites, lightCamera);
+                renderer.EndPass();
+
                 renderer.BeginDepthMapDraw();
                 renderer.DrawDepthMap(
                     gameRunner.GetZoneRenderData(),
-                    gameRunner.mSystems->GetRenderables(),
+                    models,
+                    lightCamera);
+                renderer.DrawDepthMap(
+                    gameRunner.GetZoneRenderData(),
+                    sprites,
                     lightCamera);
-                if (!gameRunner.mGameState.GetOverheadView())
-                {
-                    renderer.DrawDepthMap(
-                        gameRunner.GetZoneRenderData(),
-                        gameRunner.mSystems->GetSprites(),
-                        lightCamera);
-                }
                 renderer.EndDepthMapDraw();
             }
 
@@ -653,68 +724,87 @@ int main(int argc, char** argv)
             }
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-            if (gameRunner.GetClipDisplayMode() != Game::ClipDisplayMode::OnlyClips)
+            const auto& renderCamera = GetRenderCamera();
+            renderer.BeginPass();
+            const auto models = renderer.AddDrawList(
+                drawZone ? cameraVisible.mRenderables : noVisible,
+                renderCamera);
+            const auto sprites = renderer.AddDrawList(
+                drawZone && !overheadView ? cameraVisible.mSprites : noVisible,
+                renderCamera);
+            const auto partyMarker = renderer.AddDrawList(
+                drawZone && overheadView ? gameRunner.GetPartyMarker() : noRenderables,
+                renderCamera);
+            const auto clips = renderer.AddDrawList(
+                drawClips ? gameRunner.GetClipRenderables() : noRenderables,
+                renderCamera);
+            if (drawZone && !overheadView)
+            {
+                AddDynamicLists([&](const auto& renderables){
+                    return renderer.AddDrawList(renderables, renderCamera);
+                });
+            }
+            renderer.EndPass();
+
+            if (drawZone)
             {
                 renderer.DrawWithShadow(
                     gameRunner.GetZoneRenderData(),
-                    gameRunner.mSystems->GetRenderables(),
+                    models,
                     light,
                     lightCamera,
-                    GetRenderCamera(),
+                    renderCamera,
                     false,
                     gameRunner.IsCombatCameraActive());
 
-                if (!gameRunner.mGameState.GetOverheadView())
+                if (!overheadView)
                 {
                     renderer.DrawWithShadow(
                         gameRunner.GetZoneRenderData(),
-                        gameRunner.mSystems->GetSprites(),
+                        sprites,
                         light,
                         lightCamera,
-                        GetRenderCamera(),
+                        renderCamera,
                         true);
 
-                    const auto& dynamicRenderables = gameRunner.mSystems->GetDynamicRenderables();
-                    for (const auto& obj : dynamicRenderables)
+                    for (const auto& [renderData, list] : dynamicLists)
                     {
-                        std::vector<DynamicRenderable> data{};
-                        data.emplace_back(obj);
                         renderer.DrawWithShadow(
-                            *obj.GetRenderData(),
-                            data,
+                            *renderData,
+                            list,
                             light,
                             lightCamera,
-                            GetRenderCamera(),
+                            renderCamera,
                             true);
                     }
 
                     renderer.DrawText3D(
                         gameRunner.mGlyphStore.GetRenderData(),
                         gameRunner.mSystems->GetTextRenderables(),
-                        GetRenderCamera());
+                        renderCamera);
                 }
                 else
                 {
                     glDisable(GL_DEPTH_TEST);
                     renderer.DrawWithShadow(
                         gameRunner.GetMapIconsRenderData(),
-                        gameRunner.GetPartyMarker(),
+                        partyMarker,
                         light,
                         lightCamera,
-                        GetRenderCamera(),
+                        renderCamera,
                         false);
                     glEnable(GL_DEPTH_TEST);
                 }
             }
 
-            if (gameRunner.GetClipDisplayMode() != Game::ClipDisplayMode::Vanilla)
+            if (drawClips)
             {
                 renderer.DrawWithShadow(
                     gameRunner.GetZoneRenderData(),
-                    gameRunner.GetClipRenderables(),
+                    clips,
                     light,
                     lightCamera,
-                    GetRenderCamera(),
+                    renderCamera,
                     false);
             }
         }
@@ -724,26 +814,53 @@ int main(int argc, char** argv)
             glDisable(GL_BLEND);
             glDisable(GL_MULTISAMPLE);
 
+            const auto& renderCamera = GetRenderCamera();
+            renderer.BeginPass();
             if (gameRunner.mCombatManager.IsCombatActive())
             {
-                auto emptyRenderables = std::vector<Renderable>{};
-                auto emptyDynamicRenderables = std::vector<DynamicRenderable>{};
+                const auto gridCells = renderer.AddPickList(
+                    gameRunner.mGridCellRenderables,
+                    renderCamera);
+                renderer.EndPass();
+
+                renderer.BeginPickDraw();
                 renderer.DrawForPicking(
                     gameRunner.GetZoneRenderData(),
-                    gameRunner.mGridCellRenderables,
-                    emptyRenderables,
-                    emptyDynamicRenderables,
-                    GetRenderCamera());
+                    gridCells,
+                    renderCamera,
+                    false);
+                renderer.EndPickDraw();
             }
             else
             {
+                const auto models = renderer.AddPickList(cameraVisible.mRenderables, renderCamera);
+                const auto sprites = renderer.AddPickList(cameraVisible.mSprites, renderCamera);
+                AddDynamicLists([&](const auto& renderables){
+                    return renderer.AddPickList(renderables, renderCamera);
+                });
+                renderer.EndPass();
+
+                renderer.BeginPickDraw();
                 renderer.DrawForPicking(
                     gameRunner.GetZoneRenderData(),
-                    gameRunner.mSystems->GetRenderables(),
-                    gameRunner.mSystems->GetSprites(),
-                    gameRunner.mSystems->GetDynamicRenderables(),
-                    GetRenderCamera(),
+                    models,
+                    renderCamera,
+                    false,
                     gameRunner.IsCombatCameraActive());
+                renderer.DrawForPicking(
+                    gameRunner.GetZoneRenderData(),
+                    sprites,
+                    renderCamera,
+                    true);
+                for (const auto& [renderData, list] : dynamicLists)
+                {
+                    renderer.DrawForPicking(
+                        *renderData,
+                        list,
+                        renderCamera,
+                        true);
+                }
+                renderer.EndPickDraw();
             }
             renderer.StartPickReadback({pointerPosX, pointerPosY});
 
@@ -853,8 +970,12 @@ int main(int argc, char** argv)
         ImguiWrapper::Shutdown();
     }
 
+    // Write out queued lines while the log file is still open
+    Logging::LogState::SetAsync(false);
+
     if (logFileStream && logFileStream->is_open())
     {
+        Logging::LogState::RemoveStream(logFileStream.get());
         logFileStream->close();
     }
 
@@ -39,6 +39,11 @@ public:
     {
     }
 
+    bool IsZoneLoading() const override
+    {
+        return false;
+    }
+
 };
 
 #undef main
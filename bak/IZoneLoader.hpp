@@ -13,6 +13,9 @@ public:
     // Load zone based on zone info in DEF_ZONE.DAT
     virtual void DoTeleport(BAK::Encounter::Teleport) = 0;
     virtual void LoadGame(std::string, std::optional<Chapter>) = 0;
+    // While a zone loads the game state still describes the zone being
+    // left, so it must not be saved
+    virtual bool IsZoneLoading() const = 0;
 };
 
 }
@@ -16,7 +16,9 @@
 
 #include "com/logger.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <vector>
 
 namespace BAK {
@@ -208,6 +210,40 @@ TEST_F(CombatCalcFixture, CalculateMeleeResult_DefendingMiss)
     EXPECT_EQ(result, MeleeResult::Miss);
 }
 
+TEST_F(CombatCalcFixture, CalculateMeleeResult_RepeatablePerSeed)
+{
+    const auto fight = [&]{
+        auto attacker = MakeCombatant(10, 50, 0);
+        auto defender = MakeCombatant(10, 0, 0);
+        CombatState defenderState{};
+
+        auto random = Random{42};
+        auto scope = ScopedRandom{random};
+        std::vector<MeleeResult> results{};
+        for (unsigned i = 0; i < 64; i++)
+        {
+            results.emplace_back(CalculateMeleeResult(
+                *attacker.mCharacter,
+                *defender.mCharacter,
+                defenderState,
+                0));
+        }
+        return results;
+    };
+
+    // Forced returns apply to this thread's own stream, not the seeded one
+    Random::Get().SetReturn(40);
+    const auto first = fight();
+    std::vector<MeleeResult> second{};
+    std::thread{[&]{ second = fight(); }}.join();
+    Random::Get().SetReturn(std::nullopt);
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(
+        std::count(first.begin(), first.end(), MeleeResult::Hit),
+        std::ssize(first));
+}
+
 TEST_F(CombatCalcFixture, CalculateMeleeDamage_Base)
 {
     auto weapon = MakeItem("Sword", 100);
@@ -6,6 +6,8 @@
 
 #include "com/assert.hpp"
 
+#include <algorithm>
+
 namespace BAK {
 
 Keywords::Keywords()
@@ -355,9 +357,7 @@ DialogSnippet::DialogSnippet(FileBuffer& fb, std::uint8_t dialogFile)
     Replacements::ReplaceActions(OffsetTarget{dialogFile, fileOffset}, mActions);
     
     if (length > 0)
-        mText = fb.GetString(length);
-    else
-        mText = "";
+        mText = fb.GetStringView(length);
 }
 
 std::ostream& operator<<(std::ostream& os, const DialogSnippet& d)
@@ -384,31 +384,50 @@ std::ostream& operator<<(std::ostream& os, const DialogSnippet& d)
     return os;
 }
 
+struct DialogStore::DialogFile
+{
+    // The snippet texts view this buffer
+    FileBuffer mBuffer;
+    // Snippets are laid out in offset order, so this is sorted
+    std::vector<std::uint32_t> mOffsets;
+    std::vector<DialogSnippet> mSnippets;
+};
+
 DialogStore& DialogStore::Get()
 {
     static DialogStore dialogStore{};
     return dialogStore;
 }
 
-void DialogStore::InjectDialog(KeyTarget key, DialogSnippet snippet)
+void DialogStore::InjectDialog(KeyTarget key, DialogSnippet snippet, std::string text)
 {
-    mOverrideDialogs.emplace(key, std::move(snippet));
+    const auto [it, emplaced] = mOverrideDialogs.emplace(
+        key,
+        InjectedDialog{std::move(text), std::move(snippet)});
+    if (emplaced)
+    {
+        it->second.mSnippet.mText = it->second.mText;
+    }
 }
 
 DialogStore::DialogStore()
 :
     mDialogMap{},
-    mSnippetMap{},
+    mDialogFileLoaded{},
+    mDialogFiles{},
+    mOverrideDialogs{},
     mLogger{Logging::LogState::GetLogger("DialogStore")}
 {
-    Load();
+    LoadKeys();
 }
 
-void DialogStore::Load()
+DialogStore::~DialogStore() = default;
+
+void DialogStore::LoadKeys()
 {
-    for (std::uint8_t dialogFile = 0; dialogFile < 32; dialogFile++)
+    for (std::uint8_t dialogFile = 0; dialogFile < sDialogFileCount; dialogFile++)
     {
-        auto fname = GetDialogFile(dialogFile);
+        auto fname = GetDialogFileName(dialogFile);
         auto fb = FileBufferFactory::Get().CreateDataBuffer(fname);
         unsigned dialogs = fb.GetUint16LE();
         mLogger.Debug() << "Dialog " << fname << " has: " << dialogs << " dialogs" << "\n";
@@ -425,15 +444,65 @@ void DialogStore::Load()
             mLogger.Spam() << std::hex << "0x" << it->first 
                 << " -> 0x" << checkV << std::dec << "\n";
         }
+    }
+}
+
+const DialogStore::DialogFile& DialogStore::GetDialogFile(std::uint8_t dialogFile) const
+{
+    ASSERT(dialogFile < sDialogFileCount);
+    std::call_once(mDialogFileLoaded[dialogFile], [&]{
+        auto fname = GetDialogFileName(dialogFile);
+        auto file = std::make_unique<DialogFile>(
+            FileBufferFactory::Get().CreateDataBuffer(fname));
+        auto& fb = file->mBuffer;
+        unsigned dialogs = fb.GetUint16LE();
+        fb.Skip(dialogs * 8);
 
         while (fb.GetBytesLeft() > 0)
         {
-            const auto offset = OffsetTarget{dialogFile, fb.Tell()};
-            auto snippet = DialogSnippet{fb, dialogFile};
-            mLogger.Spam() << offset << " @ " << snippet << "\n";
-            const auto& [it, emplaced] = mSnippetMap.emplace(offset, snippet);
+            const auto offset = fb.Tell();
+            file->mOffsets.emplace_back(offset);
+            const auto& snippet = file->mSnippets.emplace_back(fb, dialogFile);
+            mLogger.Spam() << OffsetTarget{dialogFile, offset} << " @ " << snippet << "\n";
         }
+        mLogger.Debug() << "Loaded " << file->mSnippets.size() << " snippets from "
+            << fname << "\n";
+
+        mDialogFiles[dialogFile] = std::move(file);
+    });
+    return *mDialogFiles[dialogFile];
+}
+
+const DialogSnippet* DialogStore::FindSnippet(KeyTarget dialogKey) const
+{
+    auto overrideIt = mOverrideDialogs.find(dialogKey);
+    if (overrideIt != mOverrideDialogs.end())
+    {
+        return &overrideIt->second.mSnippet;
+    }
+
+    auto it = mDialogMap.find(dialogKey);
+    if (it == mDialogMap.end())
+    {
+        return nullptr;
+    }
+    return FindSnippet(it->second);
+}
+
+const DialogSnippet* DialogStore::FindSnippet(OffsetTarget snippetKey) const
+{
+    if (snippetKey.dialogFile >= sDialogFileCount)
+    {
+        return nullptr;
+    }
+
+    const auto& file = GetDialogFile(snippetKey.dialogFile);
+    auto it = std::lower_bound(file.mOffsets.begin(), file.mOffsets.end(), snippetKey.value);
+    if (it == file.mOffsets.end() || *it != snippetKey.value)
+    {
+        return nullptr;
     }
+    return &file.mSnippets[std::distance(file.mOffsets.begin(), it)];
 }
 
 void DialogStore::ShowAllDialogs()
@@ -466,16 +535,9 @@ const DialogSnippet& DialogStore::GetSnippet(Target target) const
 
 bool DialogStore::HasSnippet(Target target) const
 {
-    try
-    {
-        std::visit(*this, target);
-        return true;
-    }
-    catch (std::runtime_error& e)
-    {
-        mLogger.Error() << __FUNCTION__ << " " << e.what() << std::endl;
-        return false;
-    }
+    return std::visit(
+        [&](const auto& target){ return FindSnippet(target) != nullptr; },
+        target);
 }
 
 OffsetTarget DialogStore::GetTarget(KeyTarget dialogKey) const
@@ -509,7 +571,7 @@ const DialogSnippet& DialogStore::operator()(KeyTarget dialogKey) const
     auto overrideIt = mOverrideDialogs.find(dialogKey);
     if (overrideIt != mOverrideDialogs.end())
     {
-        return overrideIt->second;
+        return overrideIt->second.mSnippet;
     }
 
     auto it = mDialogMap.find(dialogKey);
@@ -524,17 +586,17 @@ const DialogSnippet& DialogStore::operator()(KeyTarget dialogKey) const
 
 const DialogSnippet& DialogStore::operator()(OffsetTarget snippetKey) const
 {
-    auto snip = mSnippetMap.find(snippetKey);
-    if (snip == mSnippetMap.end())
+    const auto* snippet = FindSnippet(snippetKey);
+    if (!snippet)
     {
         std::stringstream err{};
         err << "Offset not found: " << std::hex << snippetKey << std::dec;
         throw std::runtime_error(err.str());
     }
-    return snip->second;
+    return *snippet;
 }
 
-std::string DialogStore::GetDialogFile(std::uint8_t i)
+std::string DialogStore::GetDialogFileName(std::uint8_t i) const
 {
     std::stringstream ss{};
     ss << "DIAL_Z" << std::setw(2) << std::setfill('0') << +i << ".DDX";
@@ -7,8 +7,13 @@
 #include "com/logger.hpp"
 #include "com/visit.hpp"
 
+#include <array>
 #include <iosfwd>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace BAK {
@@ -118,7 +123,9 @@ public:
 
     std::vector<DialogChoice> mChoices;
     std::vector<DialogAction> mActions;
-    std::string mText;
+    // Views the dialog file's buffer, or for injected dialogs, text owned
+    // by the DialogStore
+    std::string_view mText;
 };
 
 std::ostream& operator<<(std::ostream& os, const DialogSnippet& d);
@@ -128,12 +135,14 @@ class DialogStore
 public:
     static DialogStore& Get();
 
+    ~DialogStore();
+
     void ShowAllDialogs();
     void ShowDialog(Target dialogKey);
 
     const DialogSnippet& GetSnippet(Target target) const;
 
-    void InjectDialog(KeyTarget key, DialogSnippet snippet);
+    void InjectDialog(KeyTarget key, DialogSnippet snippet, std::string text);
 
     bool HasSnippet(Target target) const;
 
@@ -145,23 +154,38 @@ public:
     const DialogSnippet& operator()(OffsetTarget snippetKey) const;
 
 private:
+    static constexpr std::uint8_t sDialogFileCount = 32;
+
+    struct DialogFile;
+
+    struct InjectedDialog
+    {
+        std::string mText;
+        DialogSnippet mSnippet;
+    };
+
     DialogStore();
 
-    void Load();
+    void LoadKeys();
+
+    // Parses the snippets of a dialog file the first time it is used
+    const DialogFile& GetDialogFile(std::uint8_t dialogFile) const;
 
-    std::string GetDialogFile(std::uint8_t i);
+    const DialogSnippet* FindSnippet(KeyTarget dialogKey) const;
+    const DialogSnippet* FindSnippet(OffsetTarget snippetKey) const;
+
+    std::string GetDialogFileName(std::uint8_t i) const;
 
     std::unordered_map<
         KeyTarget,
         OffsetTarget> mDialogMap;
 
-    std::unordered_map<
-        OffsetTarget,
-        DialogSnippet> mSnippetMap;
+    mutable std::array<std::once_flag, sDialogFileCount> mDialogFileLoaded;
+    mutable std::array<std::unique_ptr<DialogFile>, sDialogFileCount> mDialogFiles;
 
     std::unordered_map<
         KeyTarget,
-        DialogSnippet> mOverrideDialogs;
+        InjectedDialog> mOverrideDialogs;
 
     const Logging::Logger& mLogger;
 };
@@ -192,6 +192,7 @@ DialogAction ParseAction(const nlohmann::json& json)
     }
 }
 
+// The text is owned by the DialogStore, so is injected alongside the snippet
 DialogSnippet ParseSnippet(const nlohmann::json& json)
 {
     DialogSnippet snippet;
@@ -199,7 +200,6 @@ DialogSnippet ParseSnippet(const nlohmann::json& json)
     snippet.mActor = json.value("actor", 0);
     snippet.mDisplayStyle2 = static_cast<std::uint8_t>(json.value("displayStyle2", 0));
     snippet.mDisplayStyle3 = static_cast<std::uint8_t>(json.value("displayStyle3", 0));
-    snippet.mText = json.value("text", "");
 
     if (json.contains("actions"))
     {
@@ -258,8 +258,11 @@ void LoadAllFromDirectory(const std::string& dir)
         for (const auto& dialog : data["dialogs"])
         {
             auto key = dialog["key"].get<std::uint32_t>();
-            auto snippet = ParseSnippet(dialog["snippet"]);
-            store.InjectDialog(KeyTarget{key}, std::move(snippet));
+            const auto& snippetJson = dialog["snippet"];
+            store.InjectDialog(
+                KeyTarget{key},
+                ParseSnippet(snippetJson),
+                snippetJson.value("text", ""));
             injected++;
         }
 
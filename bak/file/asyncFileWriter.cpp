@@ -0,0 +1,135 @@
+#include "bak/file/asyncFileWriter.hpp"
+
+#include <exception>
+#include <utility>
+
+namespace BAK::File {
+
+AsyncFileWriter::AsyncFileWriter()
+:
+    mWriter{},
+    mMutex{},
+    mCondition{},
+    mIdle{},
+    mJobs{},
+    mCompletions{},
+    mBusy{false},
+    mStopping{false},
+    mThread{},
+    mLogger{Logging::LogState::GetLogger("AsyncFileWriter")}
+{
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    {
+        auto lock = std::unique_lock{mMutex};
+        mStopping = true;
+    }
+    mCondition.notify_all();
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+void AsyncFileWriter::SetBase(
+    const std::string& path,
+    std::span<const std::uint8_t> contents)
+{
+    auto lock = std::unique_lock{mMutex};
+    mIdle.wait(lock, [&]{ return mJobs.empty() && !mBusy; });
+    mWriter.SetBase(path, contents);
+}
+
+std::future<bool> AsyncFileWriter::Write(
+    std::string path,
+    std::vector<std::uint8_t> contents,
+    OnWritten&& onWritten)
+{
+    auto job = Job{
+        std::move(path),
+        std::move(contents),
+        std::move(onWritten),
+        std::promise<bool>{}};
+    auto result = job.mResult.get_future();
+    {
+        auto lock = std::unique_lock{mMutex};
+        // Started on first use so that loading a save for inspection
+        // doesn't start a thread
+        if (!mThread.joinable())
+        {
+            mThread = std::thread{[this]{ Run(); }};
+        }
+        mJobs.emplace_back(std::move(job));
+    }
+    mCondition.notify_one();
+    return result;
+}
+
+void AsyncFileWriter::Flush()
+{
+    auto lock = std::unique_lock{mMutex};
+    mIdle.wait(lock, [&]{ return mJobs.empty() && !mBusy; });
+}
+
+bool AsyncFileWriter::IsWriting() const
+{
+    auto lock = std::unique_lock{mMutex};
+    return !mJobs.empty() || mBusy;
+}
+
+void AsyncFileWriter::RunCompletions()
+{
+    std::vector<Completion> completions{};
+    {
+        auto lock = std::unique_lock{mMutex};
+        std::swap(completions, mCompletions);
+    }
+    for (auto& completion : completions)
+    {
+        completion.mOnWritten(completion.mSucceeded);
+    }
+}
+
+void AsyncFileWriter::Run()
+{
+    auto lock = std::unique_lock{mMutex};
+    while (true)
+    {
+        mCondition.wait(lock, [&]{ return mStopping || !mJobs.empty(); });
+        if (mJobs.empty())
+        {
+            return;
+        }
+
+        auto job = std::move(mJobs.front());
+        mJobs.pop_front();
+        mBusy = true;
+        lock.unlock();
+
+        bool succeeded = false;
+        try
+        {
+            const auto written = mWriter.Write(job.mPath, job.mContents);
+            mLogger.Debug() << "Wrote " << written << " of " << job.mContents.size()
+                << " bytes to: " << job.mPath << "\n";
+            succeeded = true;
+        }
+        catch (const std::exception& e)
+        {
+            mLogger.Error() << "Failed to write: " << job.mPath << " " << e.what() << std::endl;
+        }
+
+        lock.lock();
+        mBusy = false;
+        if (job.mOnWritten)
+        {
+            mCompletions.emplace_back(Completion{std::move(job.mOnWritten), succeeded});
+        }
+        job.mResult.set_value(succeeded);
+        mIdle.notify_all();
+    }
+}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "bak/file/incrementalFileWriter.hpp"
+
+#include "com/logger.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace BAK::File {
+
+// Writes files with an IncrementalFileWriter on its own thread, so that the
+// caller only pays for copying the contents.
+//
+// Writes happen one at a time in the order they were queued, so two writes
+// to the same file always leave the contents of the later one.
+class AsyncFileWriter
+{
+public:
+    using OnWritten = std::function<void(bool)>;
+
+    AsyncFileWriter();
+    // Finishes every queued write
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+    AsyncFileWriter(AsyncFileWriter&&) = delete;
+    AsyncFileWriter& operator=(AsyncFileWriter&&) = delete;
+
+    // Waits for queued writes, see IncrementalFileWriter::SetBase
+    void SetBase(const std::string& path, std::span<const std::uint8_t> contents);
+
+    // The result is whether the write succeeded. If given, onWritten is
+    // called with the same value from RunCompletions.
+    std::future<bool> Write(
+        std::string path,
+        std::vector<std::uint8_t> contents,
+        OnWritten&& onWritten = nullptr);
+
+    // Waits until every queued write has finished
+    void Flush();
+    bool IsWriting() const;
+
+    // Calls onWritten for each finished write, on the calling thread
+    void RunCompletions();
+
+private:
+    struct Job
+    {
+        std::string mPath;
+        std::vector<std::uint8_t> mContents;
+        OnWritten mOnWritten;
+        std::promise<bool> mResult;
+    };
+
+    struct Completion
+    {
+        OnWritten mOnWritten;
+        bool mSucceeded;
+    };
+
+    void Run();
+
+    IncrementalFileWriter mWriter;
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::condition_variable mIdle;
+    std::deque<Job> mJobs;
+    std::vector<Completion> mCompletions;
+    bool mBusy;
+    bool mStopping;
+    std::thread mThread;
+    const Logging::Logger& mLogger;
+};
+
+}
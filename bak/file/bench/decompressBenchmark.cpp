@@ -0,0 +1,236 @@
+#include "benchmark/benchmark.h"
+
+#include "bak/dataTags.hpp"
+#include "bak/file/chunkIndex.hpp"
+#include "bak/file/decompress.hpp"
+#include "bak/file/packedFileProvider.hpp"
+
+#include "com/logger.hpp"
+#include "com/path.hpp"
+
+#include <span>
+#include <string>
+#include <vector>
+
+// Decodes every compressed payload in krondor.001 and reports throughput
+// in decompressed bytes per second.
+//
+// Usage: decompressBenchmark [benchmark flags] [krondor.001 krondor.rmf]
+
+namespace {
+
+enum class Method
+{
+    LZW,
+    LZSS,
+    RLE
+};
+
+struct CompressedResource
+{
+    std::string mName;
+    Method mMethod;
+    std::span<const std::uint8_t> mInput;
+    std::vector<std::uint8_t> mOutput;
+};
+
+std::span<const std::uint8_t> Remaining(BAK::FileBuffer& fb)
+{
+    return {fb.GetCurrent(), fb.GetBytesLeft()};
+}
+
+bool HasExtension(const std::string& name, std::string_view ext)
+{
+    return name.size() > ext.size()
+        && name.compare(name.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+// Mirrors the header parsing of the loaders that decompress each kind of
+// resource (LoadImagesNormal, LoadImagesTagged, LoadScreenResource,
+// DecompressSCR, DecompressTT3 and LoadFont)
+void AddCompressedPayloads(
+    const std::string& name,
+    BAK::FileBuffer& fb,
+    std::vector<CompressedResource>& resources)
+{
+    const auto add = [&](Method method, BAK::FileBuffer& input, unsigned size)
+    {
+        resources.emplace_back(CompressedResource{
+            name, method, Remaining(input), std::vector<std::uint8_t>(size)});
+    };
+
+    const auto& chunkIndex = fb.GetChunkIndex();
+    if (chunkIndex.Find(static_cast<std::uint32_t>(BAK::DataTag::BIN)))
+    {
+        auto bin = fb.Find(BAK::DataTag::BIN);
+        bin.GetUint8();
+        const auto size = bin.GetUint32LE();
+        add(Method::LZW, bin, size);
+    }
+    if (chunkIndex.Find(static_cast<std::uint32_t>(BAK::DataTag::SCR)))
+    {
+        auto scr = fb.Find(BAK::DataTag::SCR);
+        if (scr.GetUint8() == 0x02)
+        {
+            const auto size = scr.GetUint32LE();
+            add(Method::LZW, scr, size);
+        }
+    }
+    if (chunkIndex.Find(static_cast<std::uint32_t>(BAK::DataTag::TT3)))
+    {
+        auto tt3 = fb.Find(BAK::DataTag::TT3);
+        if (tt3.GetUint8() == 1)
+        {
+            const auto size = tt3.GetUint32LE();
+            add(Method::RLE, tt3, size);
+        }
+    }
+    if (chunkIndex.Find(static_cast<std::uint32_t>(BAK::DataTag::FNT)))
+    {
+        auto fnt = fb.Find(BAK::DataTag::FNT);
+        fnt.Skip(8);
+        if (fnt.GetUint8() == 0x01)
+        {
+            const auto size = fnt.GetUint32LE();
+            add(Method::RLE, fnt, size);
+        }
+    }
+
+    if (HasExtension(name, ".BMX") && !chunkIndex.Find(static_cast<std::uint32_t>(BAK::DataTag::BIN)))
+    {
+        fb.Rewind();
+        const unsigned compression = fb.GetUint16LE();
+        const unsigned numImages = fb.GetUint16LE();
+        fb.Skip(2);
+        unsigned size = fb.GetUint32LE();
+        fb.Skip(8 * numImages);
+        if (compression == BAK::COMPRESSION_LZW)
+        {
+            if (fb.GetUint8() != 0x02) return;
+            size = fb.GetUint32LE();
+            add(Method::LZW, fb, size);
+        }
+        else if (compression == BAK::COMPRESSION_LZSS)
+        {
+            add(Method::LZSS, fb, size * 2);
+        }
+        else if (compression == BAK::COMPRESSION_RLE)
+        {
+            add(Method::RLE, fb, size);
+        }
+    }
+    else if (HasExtension(name, ".SCX"))
+    {
+        fb.Rewind();
+        if (fb.GetUint16LE() != 0x27b6)
+        {
+            fb.Rewind();
+        }
+        if (fb.GetUint8() != 0x02) return;
+        const auto size = fb.GetUint32LE();
+        add(Method::LZW, fb, size);
+    }
+}
+
+std::size_t Decompress(CompressedResource& resource)
+{
+    switch (resource.mMethod)
+    {
+    case Method::LZW:
+        return BAK::File::DecompressLZW(resource.mInput, 0, resource.mOutput).mOutputBytes;
+    case Method::LZSS:
+        return BAK::File::DecompressLZSS(resource.mInput, resource.mOutput).mOutputBytes;
+    case Method::RLE:
+        return BAK::File::DecompressRLE(resource.mInput, resource.mOutput).mOutputBytes;
+    default:
+        return 0;
+    }
+}
+
+void BM_Decompress(benchmark::State& state, std::vector<CompressedResource>* resources)
+{
+    std::size_t inputBytes = 0;
+    for (const auto& resource : *resources)
+    {
+        inputBytes += resource.mInput.size();
+    }
+
+    std::size_t outputBytes = 0;
+    for (auto _ : state)
+    {
+        for (auto& resource : *resources)
+        {
+            outputBytes += Decompress(resource);
+            benchmark::DoNotOptimize(resource.mOutput.data());
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(outputBytes);
+    state.counters["resources"] = resources->size();
+    state.counters["inputBytes"] = inputBytes;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    Logging::LogState::SetLevel(Logging::LogLevel::Warn);
+    const auto& logger = Logging::LogState::GetLogger("decompressBenchmark");
+
+    const auto dataPath = Paths::Get().GetBakDirectoryPath() / "data";
+    const auto resourceFile = argc > 2 ? std::string{argv[1]} : (dataPath / "krondor.001").string();
+    const auto resourceIndexFile = argc > 2 ? std::string{argv[2]} : (dataPath / "krondor.rmf").string();
+
+    auto packed = BAK::File::PackedFileDataProvider{resourceFile, resourceIndexFile};
+
+    std::vector<CompressedResource> lzw{};
+    std::vector<CompressedResource> lzss{};
+    std::vector<CompressedResource> rle{};
+    {
+        std::vector<CompressedResource> resources{};
+        for (auto& [name, buffer] : packed.GetCache())
+        {
+            auto fb = buffer.MakeSubBuffer(0, buffer.GetSize());
+            try
+            {
+                AddCompressedPayloads(name, fb, resources);
+            }
+            catch (const std::exception& e)
+            {
+                logger.Warn() << "Skipping " << name << ": " << e.what() << "\n";
+            }
+        }
+
+        for (auto& resource : resources)
+        {
+            // Drop anything that doesn't decode so failures aren't timed
+            try
+            {
+                Decompress(resource);
+            }
+            catch (const std::exception& e)
+            {
+                logger.Warn() << "Skipping " << resource.mName << ": " << e.what() << "\n";
+                continue;
+            }
+
+            switch (resource.mMethod)
+            {
+            case Method::LZW: lzw.emplace_back(std::move(resource)); break;
+            case Method::LZSS: lzss.emplace_back(std::move(resource)); break;
+            case Method::RLE: rle.emplace_back(std::move(resource)); break;
+            }
+        }
+    }
+
+    benchmark::RegisterBenchmark("DecompressLZW", BM_Decompress, &lzw);
+    benchmark::RegisterBenchmark("DecompressLZSS", BM_Decompress, &lzss);
+    benchmark::RegisterBenchmark("DecompressRLE", BM_Decompress, &rle);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "bak/file/chunkIndex.hpp"
+
+#include <cctype>
+#include <cstring>
+
+namespace BAK::File {
+
+namespace {
+
+static constexpr std::uint32_t sChunkHeaderSize = 8;
+static constexpr std::uint32_t sContainerFlag = 0x80000000;
+
+bool IsTag(const std::uint8_t* data)
+{
+    return std::isalnum(data[0])
+        && std::isalnum(data[1])
+        && std::isalnum(data[2])
+        && data[3] == ':';
+}
+
+}
+
+ChunkIndex::ChunkIndex(const std::uint8_t* buffer, std::uint32_t size)
+:
+    mChunks{},
+    mComplete{true}
+{
+    std::uint32_t offset = 0;
+    while (offset < size)
+    {
+        if (size - offset < sChunkHeaderSize || !IsTag(buffer + offset))
+        {
+            mComplete = false;
+            return;
+        }
+
+        std::uint32_t tag{};
+        std::uint32_t chunkSize{};
+        std::memcpy(&tag, buffer + offset, sizeof(tag));
+        std::memcpy(&chunkSize, buffer + offset + sizeof(tag), sizeof(chunkSize));
+
+        const bool isContainer = (chunkSize & sContainerFlag) != 0;
+        chunkSize &= ~sContainerFlag;
+        const auto dataOffset = offset + sChunkHeaderSize;
+
+        if (chunkSize > size - dataOffset)
+        {
+            mComplete = false;
+            return;
+        }
+
+        mChunks.emplace(tag, Chunk{dataOffset, chunkSize});
+
+        // Children of a container immediately follow its header
+        offset = isContainer
+            ? dataOffset
+            : dataOffset + chunkSize;
+    }
+}
+
+std::optional<ChunkIndex::Chunk> ChunkIndex::Find(std::uint32_t tag) const
+{
+    const auto it = mChunks.find(tag);
+    if (it == mChunks.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+bool ChunkIndex::IsComplete() const
+{
+    return mComplete;
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+namespace BAK::File {
+
+// Index of the tagged chunks ("TAG:" + uint32 size + payload) in a resource.
+// Chunks whose size has the high bit set are containers and their
+// children are indexed too. Only the first chunk with a given tag is kept,
+// which matches what a linear scan from the start of the buffer finds.
+class ChunkIndex
+{
+public:
+    struct Chunk
+    {
+        std::uint32_t mOffset;
+        std::uint32_t mSize;
+    };
+
+    ChunkIndex(const std::uint8_t* buffer, std::uint32_t size);
+
+    std::optional<Chunk> Find(std::uint32_t tag) const;
+
+    // False if the buffer was not made up entirely of well formed chunks,
+    // e.g. it has trailing raw data. Tags missing from an incomplete index
+    // may still exist somewhere in the buffer.
+    bool IsComplete() const;
+
+private:
+    std::unordered_map<std::uint32_t, Chunk> mChunks;
+    bool mComplete;
+};
+
+}
@@ -0,0 +1,302 @@
+#include "bak/file/decompress.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <SDL2/SDL_endian.h>
+
+namespace BAK::File {
+
+namespace {
+
+[[noreturn]] void ThrowBufferEmpty(const char* function, std::size_t position)
+{
+    std::stringstream ss{};
+    ss << function << " BufferEmpty! Input exhausted at: " << position;
+    throw std::runtime_error(ss.str());
+}
+
+[[noreturn]] void ThrowBufferFull(const char* function, std::size_t position, std::size_t requested)
+{
+    std::stringstream ss{};
+    ss << function << " BufferFull! Requested: " << requested << " @" << position;
+    throw std::runtime_error(ss.str());
+}
+
+// LSB first bit reader, loading a word at a time where possible
+class BitReader
+{
+public:
+    BitReader(std::span<const std::uint8_t> data, unsigned startBit)
+    :
+        mData{data.data()},
+        mSize{data.size()},
+        mPosition{startBit}
+    {}
+
+    bool AtEnd() const
+    {
+        return (mPosition >> 3) >= mSize;
+    }
+
+    unsigned GetBits(unsigned n)
+    {
+        if (mPosition + n > mSize * 8)
+        {
+            ThrowBufferEmpty(__FUNCTION__, mPosition >> 3);
+        }
+
+        const auto byte = mPosition >> 3;
+        const auto shift = mPosition & 7;
+        std::uint32_t word = 0;
+        if (byte + sizeof(word) <= mSize)
+        {
+            std::memcpy(&word, mData + byte, sizeof(word));
+            word = SDL_SwapLE32(word);
+        }
+        else
+        {
+            for (std::size_t i = 0; byte + i < mSize; i++)
+            {
+                word |= static_cast<std::uint32_t>(mData[byte + i]) << (8 * i);
+            }
+        }
+
+        mPosition += n;
+        return (word >> shift) & ((1u << n) - 1);
+    }
+
+    // Move to the start of the next byte if part way through one
+    void SkipBits()
+    {
+        mPosition = (mPosition + 7) & ~std::size_t{7};
+    }
+
+    // Skips are ignored if they would go past the end, as in FileBuffer::Skip
+    void SkipBytes(std::size_t n)
+    {
+        if ((mPosition >> 3) + n <= mSize)
+        {
+            mPosition += n * 8;
+        }
+    }
+
+    std::size_t GetBytePosition() const { return mPosition >> 3; }
+    unsigned GetBitPosition() const { return mPosition & 7; }
+
+private:
+    const std::uint8_t* mData;
+    std::size_t mSize;
+    std::size_t mPosition;
+};
+
+constexpr unsigned sLzwClearCode = 256;
+constexpr unsigned sLzwMaxCodes = 4096;
+
+}
+
+DecompressResult DecompressLZW(
+    std::span<const std::uint8_t> input,
+    unsigned inputBit,
+    std::span<std::uint8_t> output)
+{
+    // Every string in the table is a previous string plus one byte, and is
+    // always emitted contiguously, so it can be stored as a reference into
+    // the output already written and copied out in one go.
+    std::array<std::uint32_t, sLzwMaxCodes> stringOffsets;
+    std::array<std::uint32_t, sLzwMaxCodes> stringLengths;
+
+    auto bits = BitReader{input, inputBit};
+    auto* const out = output.data();
+    const auto outSize = output.size();
+
+    unsigned n_bits = 9;
+    unsigned free_entry = 257;
+    unsigned bitpos = 0;
+
+    const unsigned firstCode = bits.GetBits(n_bits);
+    if (outSize == 0)
+    {
+        ThrowBufferFull(__FUNCTION__, 0, 1);
+    }
+    out[0] = static_cast<std::uint8_t>(firstCode);
+    std::size_t outPos = 1;
+    std::size_t prevOffset = 0;
+    std::size_t prevLength = 1;
+
+    while (!bits.AtEnd() && outPos < outSize)
+    {
+        const unsigned newcode = bits.GetBits(n_bits);
+        bitpos += n_bits;
+        if (newcode == sLzwClearCode)
+        {
+            bits.SkipBits();
+            bits.SkipBytes((((bitpos-1)+((n_bits<<3)-(bitpos-1+(n_bits<<3))%(n_bits<<3)))-bitpos)>>3);
+            n_bits = 9;
+            free_entry = 256;
+            bitpos = 0;
+            continue;
+        }
+
+        const auto start = outPos;
+        if (newcode >= free_entry)
+        {
+            // Previous string followed by its own first byte
+            const auto length = prevLength + 1;
+            if (outPos + length > outSize)
+            {
+                ThrowBufferFull(__FUNCTION__, outPos, length);
+            }
+            std::memcpy(out + outPos, out + prevOffset, prevLength);
+            out[outPos + prevLength] = out[prevOffset];
+            outPos += length;
+        }
+        else if (newcode < 256)
+        {
+            out[outPos++] = static_cast<std::uint8_t>(newcode);
+        }
+        else
+        {
+            const auto length = stringLengths[newcode];
+            if (outPos + length > outSize)
+            {
+                ThrowBufferFull(__FUNCTION__, outPos, length);
+            }
+            std::memcpy(out + outPos, out + stringOffsets[newcode], length);
+            outPos += length;
+        }
+
+        if (free_entry < sLzwMaxCodes)
+        {
+            stringOffsets[free_entry] = prevOffset;
+            stringLengths[free_entry] = prevLength + 1;
+            free_entry++;
+            if ((free_entry >= (1u << n_bits)) && (n_bits < 12))
+            {
+                n_bits++;
+                bitpos = 0;
+            }
+        }
+
+        prevOffset = start;
+        prevLength = outPos - start;
+    }
+
+    return DecompressResult{
+        bits.GetBytePosition(),
+        bits.GetBitPosition(),
+        outPos};
+}
+
+DecompressResult DecompressLZSS(
+    std::span<const std::uint8_t> input,
+    std::span<std::uint8_t> output)
+{
+    const auto* const in = input.data();
+    const auto inSize = input.size();
+    auto* const out = output.data();
+    const auto outSize = output.size();
+
+    std::size_t inPos = 0;
+    std::size_t outPos = 0;
+    std::uint8_t code = 0;
+    std::uint8_t mask = 0;
+    while (inPos < inSize && outPos < outSize)
+    {
+        if (!mask)
+        {
+            code = in[inPos++];
+            mask = 0x01;
+        }
+
+        if (code & mask)
+        {
+            if (inPos >= inSize) ThrowBufferEmpty(__FUNCTION__, inPos);
+            out[outPos++] = in[inPos++];
+        }
+        else
+        {
+            if (inPos + 3 > inSize) ThrowBufferEmpty(__FUNCTION__, inPos);
+            const std::size_t off = in[inPos] | (in[inPos + 1] << 8);
+            std::size_t len = in[inPos + 2] + 5;
+            inPos += 3;
+
+            if (outPos + len > outSize || off + len > outSize)
+            {
+                ThrowBufferFull(__FUNCTION__, outPos, len);
+            }
+
+            auto* dst = out + outPos;
+            const auto* src = out + off;
+            outPos += len;
+            if (off + len <= static_cast<std::size_t>(dst - out))
+            {
+                std::memcpy(dst, src, len);
+            }
+            else if (src < dst)
+            {
+                // Overlapping back reference repeats the bytes between src
+                // and dst. Each copy doubles the length of valid pattern.
+                while (len > 0)
+                {
+                    const auto chunk = std::min(len, static_cast<std::size_t>(dst - src));
+                    std::memcpy(dst, src, chunk);
+                    dst += chunk;
+                    len -= chunk;
+                }
+            }
+            else
+            {
+                std::memmove(dst, src, len);
+            }
+        }
+        mask <<= 1;
+    }
+
+    return DecompressResult{inPos, 0, outPos};
+}
+
+DecompressResult DecompressRLE(
+    std::span<const std::uint8_t> input,
+    std::span<std::uint8_t> output)
+{
+    const auto* const in = input.data();
+    const auto inSize = input.size();
+    auto* const out = output.data();
+    const auto outSize = output.size();
+
+    std::size_t inPos = 0;
+    std::size_t outPos = 0;
+    while (inPos < inSize && outPos < outSize)
+    {
+        const std::uint8_t control = in[inPos++];
+        if (control & 0x80)
+        {
+            if (inPos >= inSize) ThrowBufferEmpty(__FUNCTION__, inPos);
+            const std::size_t n = control & 0x7f;
+            if (outPos + n > outSize) ThrowBufferFull(__FUNCTION__, outPos, n);
+            std::memset(out + outPos, in[inPos++], n);
+            outPos += n;
+        }
+        else
+        {
+            const std::size_t n = control;
+            // Runs that don't fit in the output are dropped without
+            // consuming their input, as FileBuffer::CopyFrom does
+            if (n && outPos + n <= outSize)
+            {
+                if (inPos + n > inSize) ThrowBufferEmpty(__FUNCTION__, inPos);
+                std::memcpy(out + outPos, in + inPos, n);
+                inPos += n;
+                outPos += n;
+            }
+        }
+    }
+
+    return DecompressResult{inPos, 0, outPos};
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace BAK::File {
+
+// Decoders for the compression schemes used in the resource files.
+// These write straight into the output span and throw std::runtime_error
+// if the input is truncated or the output would overflow.
+
+struct DecompressResult
+{
+    // Input consumed, as whole bytes plus the bit offset into the next byte
+    std::size_t mInputBytes;
+    unsigned mInputBit;
+    std::size_t mOutputBytes;
+};
+
+DecompressResult DecompressLZW(
+    std::span<const std::uint8_t> input,
+    unsigned inputBit,
+    std::span<std::uint8_t> output);
+
+DecompressResult DecompressLZSS(
+    std::span<const std::uint8_t> input,
+    std::span<std::uint8_t> output);
+
+DecompressResult DecompressRLE(
+    std::span<const std::uint8_t> input,
+    std::span<std::uint8_t> output);
+
+}
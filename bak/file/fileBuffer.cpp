@@ -1,5 +1,8 @@
 #include "bak/file/fileBuffer.hpp"
 
+#include "bak/file/chunkIndex.hpp"
+#include "bak/file/decompress.hpp"
+
 #include "com/logger.hpp"
 #include "com/path.hpp"
 
@@ -8,6 +11,7 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <mutex>
 
 #include <cassert>
 #include <cstring>
@@ -18,6 +22,12 @@
 
 namespace BAK {
 
+struct FileBuffer::LazyChunkIndex
+{
+    std::once_flag mBuilt{};
+    std::unique_ptr<const File::ChunkIndex> mIndex{};
+};
+
 FileBuffer::FileBuffer(
     std::uint8_t* buf,
     std::uint8_t* current,
@@ -28,7 +38,8 @@ FileBuffer::FileBuffer(
     mCurrent{current},
     mSize{size},
     mNextBit{nb},
-    mOwnBuffer{false}
+    mOwnBuffer{false},
+    mChunkIndex{}
 {
 }
 
@@ -42,7 +53,8 @@ FileBuffer::FileBuffer(const unsigned n)
     mCurrent{mBuffer},
     mSize{n},
     mNextBit{0},
-    mOwnBuffer{true}
+    mOwnBuffer{true},
+    mChunkIndex{}
 {
 }
 
@@ -53,6 +65,11 @@ FileBuffer::FileBuffer(FileBuffer&& fb) noexcept
 
 FileBuffer& FileBuffer::operator=(FileBuffer&& fb) noexcept
 {
+    if (this == &fb)
+    {
+        return *this;
+    }
+
     bool wasOwnBuffer = fb.mOwnBuffer;
     fb.mOwnBuffer = false;
 
@@ -61,6 +78,13 @@ FileBuffer& FileBuffer::operator=(FileBuffer&& fb) noexcept
     mSize = fb.mSize;
     mNextBit = fb.mNextBit;
     mOwnBuffer = wasOwnBuffer;
+    mChunkIndex.store(fb.mChunkIndex.exchange(nullptr));
+
+    // Left empty, so that it no longer refers to the moved buffer
+    fb.mBuffer = nullptr;
+    fb.mCurrent = nullptr;
+    fb.mSize = 0;
+    fb.mNextBit = 0;
     return *this;
 }
 
@@ -102,22 +126,61 @@ FileBuffer::Fill(FileBuffer *buf)
     }
 }
 
+std::shared_ptr<FileBuffer::LazyChunkIndex> FileBuffer::GetLazyChunkIndex() const
+{
+    auto index = mChunkIndex.load(std::memory_order_acquire);
+    if (!index)
+    {
+        // If another thread got there first, index is set to its one
+        auto created = std::make_shared<LazyChunkIndex>();
+        if (mChunkIndex.compare_exchange_strong(index, created, std::memory_order_acq_rel))
+        {
+            index = std::move(created);
+        }
+    }
+    return index;
+}
+
+const File::ChunkIndex& FileBuffer::GetChunkIndex() const
+{
+    const auto index = GetLazyChunkIndex();
+    std::call_once(index->mBuilt, [&]{
+        index->mIndex = std::make_unique<const File::ChunkIndex>(mBuffer, mSize);
+    });
+    // Kept alive by this buffer, which only gives it up when moved from
+    return *index->mIndex;
+}
+
 FileBuffer FileBuffer::Find(std::uint32_t tag) const
 {
-    auto *search = mBuffer;
-    for (; search < (mBuffer + mSize - sizeof(std::uint32_t)); search++)
+    const auto& chunkIndex = GetChunkIndex();
+    if (const auto chunk = chunkIndex.Find(tag))
+    {
+        return FileBuffer{
+            mBuffer + chunk->mOffset,
+            mBuffer + chunk->mOffset,
+            chunk->mSize,
+            0};
+    }
+
+    // Only resources with untagged data after their chunks need a scan
+    if (!chunkIndex.IsComplete() && mSize > 2 * sizeof(std::uint32_t))
     {
-        auto current = *reinterpret_cast<std::uint32_t*>(search);
-        if (current == tag)
+        const auto* end = mBuffer + mSize - 2 * sizeof(std::uint32_t);
+        for (auto* search = mBuffer; search <= end; search++)
         {
-            search += 4;
-            const auto mBufferSize = *reinterpret_cast<std::uint32_t*>(search);
-            search += 4;
-            return FileBuffer{
-                search,
-                search,
-                mBufferSize,
-                0};
+            std::uint32_t current{};
+            std::memcpy(&current, search, sizeof(current));
+            if (current == tag)
+            {
+                std::uint32_t size{};
+                std::memcpy(&size, search + 4, sizeof(size));
+                return FileBuffer{
+                    search + 8,
+                    search + 8,
+                    size,
+                    0};
+            }
         }
     }
 
@@ -137,11 +200,25 @@ FileBuffer FileBuffer::MakeSubBuffer(std::uint32_t offset, std::uint32_t size) c
         throw std::runtime_error(ss.str());
     }
 
-    return FileBuffer{
+    auto subBuffer = FileBuffer{
         mBuffer + offset,
         mBuffer + offset,
         size,
         0};
+    if (offset == 0 && size == mSize)
+    {
+        subBuffer.mChunkIndex.store(GetLazyChunkIndex());
+    }
+    return subBuffer;
+}
+
+FileBuffer FileBuffer::MakeView(std::uint8_t* buffer, std::uint32_t size)
+{
+    return FileBuffer{
+        buffer,
+        buffer,
+        size,
+        0};
 }
 
 void
@@ -554,74 +631,18 @@ FileBuffer::Compress(FileBuffer *result, const unsigned method)
     }
 }
 
-typedef struct _CodeTableEntry
-{
-    uint16_t prefix;
-    uint8_t  append;
-}
-CodeTableEntry;
-
 unsigned
 FileBuffer::DecompressLZW(FileBuffer *result)
 {
     try
     {
-        CodeTableEntry *codetable = new CodeTableEntry[4096];
-        uint8_t *decodestack = new uint8_t[4096];
-        uint8_t *stackptr = decodestack;
-        unsigned n_bits = 9;
-        unsigned free_entry = 257;
-        unsigned oldcode = GetBits(n_bits);
-        unsigned lastbyte = oldcode;
-        unsigned bitpos = 0;
-        result->PutUint8(oldcode);
-        while (!AtEnd() && !result->AtEnd())
-        {
-            unsigned newcode = GetBits(n_bits);
-            bitpos += n_bits;
-            if (newcode == 256)
-            {
-                SkipBits();
-                Skip((((bitpos-1)+((n_bits<<3)-(bitpos-1+(n_bits<<3))%(n_bits<<3)))-bitpos)>>3);
-                n_bits = 9;
-                free_entry = 256;
-                bitpos = 0;
-            }
-            else
-            {
-                unsigned code = newcode;
-                if (code >= free_entry)
-                {
-                    *stackptr++ = lastbyte;
-                    code = oldcode;
-                }
-                while (code >= 256)
-                {
-                    *stackptr++ = codetable[code].append;
-                    code = codetable[code].prefix;
-                }
-                *stackptr++ = code;
-                lastbyte = code;
-                while (stackptr > decodestack)
-                {
-                    result->PutUint8(*--stackptr);
-                }
-                if (free_entry < 4096)
-                {
-                    codetable[free_entry].prefix = oldcode;
-                    codetable[free_entry].append = lastbyte;
-                    free_entry++;
-                    if ((free_entry >= (unsigned)(1 << n_bits)) && (n_bits < 12))
-                    {
-                        n_bits++;
-                        bitpos = 0;
-                    }
-                }
-                oldcode = newcode;
-            }
-        }
-        delete[] decodestack;
-        delete[] codetable;
+        const auto decoded = File::DecompressLZW(
+            {mCurrent, GetBytesLeft()},
+            mNextBit,
+            {result->mCurrent, result->GetBytesLeft()});
+        mCurrent += decoded.mInputBytes;
+        mNextBit = decoded.mInputBit;
+        result->mCurrent += decoded.mOutputBytes;
         unsigned res = result->GetBytesDone();
         result->Rewind();
         return res;
@@ -640,28 +661,11 @@ FileBuffer::DecompressLZSS(FileBuffer *result)
 {
     try
     {
-        uint8_t *data = result->GetCurrent();
-        uint8_t code = 0;
-        uint8_t mask = 0;
-        while (!AtEnd() && !result->AtEnd())
-        {
-            if (!mask)
-            {
-                code = GetUint8();
-                mask = 0x01;
-            }
-            if (code & mask)
-            {
-                result->PutUint8(GetUint8());
-            }
-            else
-            {
-                unsigned off = GetUint16LE();
-                unsigned len = GetUint8() + 5;
-                result->PutData(data + off, len);
-            }
-            mask <<= 1;
-        }
+        const auto decoded = File::DecompressLZSS(
+            {mCurrent, GetBytesLeft()},
+            {result->mCurrent, result->GetBytesLeft()});
+        mCurrent += decoded.mInputBytes;
+        result->mCurrent += decoded.mOutputBytes;
         unsigned res = result->GetBytesDone();
         result->Rewind();
         return res;
@@ -680,18 +684,11 @@ FileBuffer::DecompressRLE(FileBuffer *result)
 {
     try
     {
-        while (!AtEnd() && !result->AtEnd())
-        {
-            uint8_t control = GetUint8();
-            if (control & 0x80)
-            {
-                result->PutData(GetUint8(), control & 0x7f);
-            }
-            else
-            {
-                result->CopyFrom(this, control);
-            }
-        }
+        const auto decoded = File::DecompressRLE(
+            {mCurrent, GetBytesLeft()},
+            {result->mCurrent, result->GetBytesLeft()});
+        mCurrent += decoded.mInputBytes;
+        result->mCurrent += decoded.mOutputBytes;
         unsigned res = result->GetBytesDone();
         result->Rewind();
         return res;
@@ -909,6 +906,24 @@ FileBuffer::GetString(const unsigned len)
     return "";
 }
 
+std::string_view
+FileBuffer::GetStringView(const unsigned len)
+{
+    if ((mCurrent) && (mCurrent + len <= mBuffer + mSize))
+    {
+        const auto* chars = reinterpret_cast<const char*>(mCurrent);
+        mCurrent += len;
+        return std::string_view{chars, strnlen(chars, len)};
+    }
+    else
+    {
+        std::stringstream ss{};
+        ss << __FILE__ << ":" << __LINE__ << " " << __FUNCTION__ << " BufferEmpty!";
+        Logging::LogFatal("FileBuffer") << ss.str() << std::endl;
+        throw std::runtime_error(ss.str());
+    }
+}
+
 void
 FileBuffer::GetData(void *data,
                     const unsigned n)
@@ -3,13 +3,20 @@
 #include <glm/glm.hpp>
 
 #include <array>
+#include <atomic>
 #include <fstream>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include <cstdint>
 #include <ostream>
 
+namespace BAK::File {
+class ChunkIndex;
+}
+
 namespace BAK {
 
 static constexpr auto COMPRESSION_LZW  = 0;
@@ -36,7 +43,14 @@ public:
     {
         return Find(static_cast<std::uint32_t>(tag));
     }
+    // Sub buffers covering the whole of this buffer share its chunk index
     FileBuffer MakeSubBuffer(std::uint32_t offset, std::uint32_t size) const;
+    // Non-owning view over memory owned elsewhere (e.g. a File::MappedFile)
+    static FileBuffer MakeView(std::uint8_t* buffer, std::uint32_t size);
+    // Index of the tagged chunks in this buffer, built once on first use
+    // by whichever thread asks for it first. It is not updated by later
+    // writes, so a buffer must be filled before it is searched by tag.
+    const File::ChunkIndex& GetChunkIndex() const;
 
     void Load(std::ifstream &ifs);
     void Save(std::ofstream &ofs);
@@ -143,6 +157,9 @@ public:
 
     std::string GetString();
     std::string GetString(unsigned len);
+    // As GetString(len) but without a copy, so only valid while the
+    // underlying data is alive
+    std::string_view GetStringView(unsigned len);
     void GetData(void * data, unsigned n);
     unsigned GetBits(unsigned n);
 
@@ -169,6 +186,11 @@ private:
     unsigned mSize;
     unsigned mNextBit;
     bool mOwnBuffer;
+    struct LazyChunkIndex;
+    // Only made when first needed, most sub buffers are never searched
+    mutable std::atomic<std::shared_ptr<LazyChunkIndex>> mChunkIndex;
+
+    std::shared_ptr<LazyChunkIndex> GetLazyChunkIndex() const;
 
     FileBuffer(
         std::uint8_t*,
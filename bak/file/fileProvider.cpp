@@ -26,7 +26,10 @@ FileBuffer* FileDataProvider::GetDataBuffer(const std::string& path)
     {
         if (!mCache.contains(path))
         {
-            const auto [it, emplaced] = mCache.emplace(path, CreateFileBuffer((mBasePath / path).string()));
+            const auto [mappedIt, mapped] = mMappedFiles.emplace(
+                path, MappedFile{(mBasePath / path).string()});
+            assert(mapped);
+            const auto [it, emplaced] = mCache.emplace(path, mappedIt->second.GetFileBuffer());
             assert(emplaced);
         }
         return &mCache.at(path);
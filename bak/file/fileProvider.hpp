@@ -2,6 +2,7 @@
 
 #include "bak/fileBufferFactory.hpp"
 #include "bak/file/IDataBufferProvider.hpp"
+#include "bak/file/mappedFile.hpp"
 
 #include <filesystem>
 #include <string>
@@ -19,6 +20,9 @@ public:
 private:
     bool DataFileExists(const std::string& path) const;
 
+    // Files are mapped rather than read so that data is paged in on demand
+    // and shared with other running instances through the page cache.
+    std::unordered_map<std::string, MappedFile> mMappedFiles;
     std::unordered_map<std::string, FileBuffer> mCache;
     std::filesystem::path mBasePath;
 };
@@ -0,0 +1,228 @@
+#include "bak/file/incrementalFileWriter.hpp"
+
+#include "com/logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace BAK::File {
+
+namespace {
+
+[[noreturn]] void ThrowWriteError(const std::string& fileName, std::string_view what)
+{
+    std::stringstream ss{};
+    ss << __FILE__ << ":" << __LINE__ << " " << __FUNCTION__
+        << " Failed to write file: " << fileName << " (" << what << ")";
+    Logging::LogError("IncrementalFileWriter") << ss.str() << std::endl;
+    throw std::runtime_error(ss.str());
+}
+
+// Offset and size of each run of pages that differ
+std::vector<std::pair<std::size_t, std::size_t>> FindChangedRanges(
+    std::span<const std::uint8_t> base,
+    std::span<const std::uint8_t> contents)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> ranges{};
+    for (std::size_t offset = 0; offset < contents.size(); offset += IncrementalFileWriter::sPageSize)
+    {
+        const auto size = std::min(IncrementalFileWriter::sPageSize, contents.size() - offset);
+        if (std::memcmp(base.data() + offset, contents.data() + offset, size) == 0)
+        {
+            continue;
+        }
+
+        if (!ranges.empty() && ranges.back().first + ranges.back().second == offset)
+        {
+            ranges.back().second += size;
+        }
+        else
+        {
+            ranges.emplace_back(offset, size);
+        }
+    }
+    return ranges;
+}
+
+class OutputFile
+{
+public:
+    OutputFile(const std::string& fileName, bool truncate)
+    :
+        mFileName{fileName}
+#if defined(_WIN32)
+        ,mFile{fileName, std::ios::binary | std::ios::out
+            | (truncate ? std::ios::trunc : std::ios::in)}
+    {
+        if (!mFile.is_open())
+        {
+            ThrowWriteError(fileName, "open");
+        }
+    }
+#else
+        ,mFile{open(fileName.c_str(), O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0), 0644)}
+    {
+        if (mFile == -1)
+        {
+            ThrowWriteError(fileName, std::strerror(errno));
+        }
+    }
+#endif
+
+    OutputFile(const OutputFile&) = delete;
+    OutputFile& operator=(const OutputFile&) = delete;
+
+    ~OutputFile()
+    {
+#if !defined(_WIN32)
+        close(mFile);
+#endif
+    }
+
+    void WriteAt(std::size_t offset, std::span<const std::uint8_t> data)
+    {
+#if defined(_WIN32)
+        mFile.seekp(offset);
+        mFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!mFile)
+        {
+            ThrowWriteError(mFileName, "write");
+        }
+#else
+        while (!data.empty())
+        {
+            const auto written = pwrite(mFile, data.data(), data.size(), offset);
+            if (written == -1 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                ThrowWriteError(mFileName, std::strerror(errno));
+            }
+            data = data.subspan(written);
+            offset += written;
+        }
+#endif
+    }
+
+    // Makes sure the data is on disk before the file is renamed into place
+    void Sync()
+    {
+#if defined(_WIN32)
+        mFile.flush();
+        if (!mFile)
+        {
+            ThrowWriteError(mFileName, "flush");
+        }
+#else
+        if (fsync(mFile) == -1)
+        {
+            ThrowWriteError(mFileName, std::strerror(errno));
+        }
+#endif
+    }
+
+private:
+    std::string mFileName;
+#if defined(_WIN32)
+    std::fstream mFile;
+#else
+    int mFile;
+#endif
+};
+
+}
+
+IncrementalFileWriter::IncrementalFileWriter()
+:
+    mPath{},
+    mBase{},
+    mModified{}
+{
+}
+
+void IncrementalFileWriter::SetBase(
+    const std::string& path,
+    std::span<const std::uint8_t> contents)
+{
+    std::error_code error{};
+    mModified = std::filesystem::last_write_time(path, error);
+    mPath = error ? "" : path;
+    mBase.assign(contents.begin(), contents.end());
+}
+
+std::size_t IncrementalFileWriter::Write(
+    const std::string& path,
+    std::span<const std::uint8_t> contents)
+{
+    const auto tempPath = path + ".tmp";
+    std::size_t written = 0;
+
+    if (IsBaseCurrent(path, contents.size()))
+    {
+        // The file already holds contents, so there is nothing to replace
+        const auto ranges = FindChangedRanges(mBase, contents);
+        if (ranges.empty())
+        {
+            return 0;
+        }
+
+        std::filesystem::copy_file(
+            path,
+            tempPath,
+            std::filesystem::copy_options::overwrite_existing);
+
+        auto file = OutputFile{tempPath, false};
+        for (const auto& [offset, size] : ranges)
+        {
+            file.WriteAt(offset, contents.subspan(offset, size));
+            written += size;
+        }
+        file.Sync();
+    }
+    else
+    {
+        auto file = OutputFile{tempPath, true};
+        file.WriteAt(0, contents);
+        file.Sync();
+        written = contents.size();
+    }
+
+    std::filesystem::rename(tempPath, path);
+
+    SetBase(path, contents);
+    return written;
+}
+
+bool IncrementalFileWriter::IsBaseCurrent(const std::string& path, std::size_t size) const
+{
+    if (mPath.empty() || mPath != path || mBase.size() != size)
+    {
+        return false;
+    }
+
+    std::error_code error{};
+    const auto fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize != size)
+    {
+        return false;
+    }
+
+    const auto modified = std::filesystem::last_write_time(path, error);
+    return !error && modified == mModified;
+}
+
+}
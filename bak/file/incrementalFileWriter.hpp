@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace BAK::File {
+
+// Replaces whole files by writing a temporary file next to them and
+// renaming it over them, so that a crash leaves either the old or the new
+// contents, never a mix.
+//
+// Remembers the contents of the file it last read or wrote. When writing
+// that file again, and it has not been changed by anything else since, the
+// old file is copied and only the pages that differ are written to the copy.
+// Pages are compared byte for byte with the remembered contents, and if
+// none differ the file is left alone.
+class IncrementalFileWriter
+{
+public:
+    static constexpr std::size_t sPageSize = 4096;
+
+    IncrementalFileWriter();
+
+    // The file at path holds contents, e.g. as it was just read
+    void SetBase(const std::string& path, std::span<const std::uint8_t> contents);
+
+    // Returns the number of bytes of contents that were written, 0 if the
+    // file already held contents
+    std::size_t Write(const std::string& path, std::span<const std::uint8_t> contents);
+
+private:
+    bool IsBaseCurrent(const std::string& path, std::size_t size) const;
+
+    std::string mPath;
+    std::vector<std::uint8_t> mBase;
+    std::filesystem::file_time_type mModified;
+};
+
+}
@@ -0,0 +1,176 @@
+#include "bak/file/mappedFile.hpp"
+
+#include "com/logger.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BAK::File {
+
+namespace {
+
+[[noreturn]] void ThrowMapError(const std::string& fileName, std::string_view what)
+{
+    std::stringstream ss{};
+    ss << __FILE__ << ":" << __LINE__ << " " << __FUNCTION__
+        << " Failed to map file: " << fileName << " (" << what << ")";
+    Logging::LogFatal("MappedFile") << ss.str() << std::endl;
+    throw std::runtime_error(ss.str());
+}
+
+}
+
+MappedFile::MappedFile()
+:
+    mData{nullptr},
+    mSize{0}
+#if defined(_WIN32)
+    ,mFileHandle{nullptr},
+    mMappingHandle{nullptr}
+#endif
+{
+}
+
+MappedFile::MappedFile(const std::string& fileName)
+:
+    MappedFile{}
+{
+    Logging::LogInfo("MappedFile") << "Mapping: " << fileName << std::endl;
+#if defined(_WIN32)
+    auto file = CreateFileA(
+        fileName.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        ThrowMapError(fileName, "open");
+    }
+    mFileHandle = file;
+
+    auto size = LARGE_INTEGER{};
+    if (!GetFileSizeEx(file, &size))
+    {
+        Unmap();
+        ThrowMapError(fileName, "size");
+    }
+    mSize = static_cast<unsigned>(size.QuadPart);
+
+    // Zero length files can't be mapped, leave them as an empty view
+    if (mSize == 0) return;
+
+    mMappingHandle = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mMappingHandle == nullptr)
+    {
+        Unmap();
+        ThrowMapError(fileName, "CreateFileMapping");
+    }
+
+    mData = static_cast<std::uint8_t*>(
+        MapViewOfFile(mMappingHandle, FILE_MAP_COPY, 0, 0, 0));
+    if (mData == nullptr)
+    {
+        Unmap();
+        ThrowMapError(fileName, "MapViewOfFile");
+    }
+#else
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        ThrowMapError(fileName, "open");
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        ThrowMapError(fileName, "fstat");
+    }
+    mSize = static_cast<unsigned>(st.st_size);
+
+    if (mSize == 0)
+    {
+        close(fd);
+        return;
+    }
+
+    auto* data = mmap(nullptr, mSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // The mapping holds its own reference to the file
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        mSize = 0;
+        ThrowMapError(fileName, "mmap");
+    }
+    mData = static_cast<std::uint8_t*>(data);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+:
+    MappedFile{}
+{
+    (*this) = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Unmap();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+#if defined(_WIN32)
+        mFileHandle = std::exchange(other.mFileHandle, nullptr);
+        mMappingHandle = std::exchange(other.mMappingHandle, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    Unmap();
+}
+
+void MappedFile::Unmap()
+{
+#if defined(_WIN32)
+    if (mData != nullptr) UnmapViewOfFile(mData);
+    if (mMappingHandle != nullptr) CloseHandle(mMappingHandle);
+    if (mFileHandle != nullptr) CloseHandle(mFileHandle);
+    mFileHandle = nullptr;
+    mMappingHandle = nullptr;
+#else
+    if (mData != nullptr) munmap(mData, mSize);
+#endif
+    mData = nullptr;
+    mSize = 0;
+}
+
+FileBuffer MappedFile::GetFileBuffer() const
+{
+    return FileBuffer::MakeView(mData, mSize);
+}
+
+unsigned MappedFile::GetSize() const
+{
+    return mSize;
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "bak/file/fileBuffer.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace BAK::File {
+
+// Read-only view of a file mapped into memory. The mapping is private
+// (copy-on-write) so FileBuffers handed out over it may still be written
+// to without touching the file on disk, and untouched pages are shared
+// through the OS page cache with any other process mapping the same file.
+class MappedFile
+{
+public:
+    MappedFile();
+    explicit MappedFile(const std::string& fileName);
+
+    MappedFile(const MappedFile&) noexcept = delete;
+    MappedFile& operator=(const MappedFile&) noexcept = delete;
+
+    MappedFile(MappedFile&&) noexcept;
+    MappedFile& operator=(MappedFile&&) noexcept;
+
+    ~MappedFile();
+
+    // Non-owning FileBuffer over the whole mapping. Only valid for as
+    // long as this MappedFile is alive.
+    FileBuffer GetFileBuffer() const;
+    unsigned GetSize() const;
+
+private:
+    void Unmap();
+
+    std::uint8_t* mData;
+    unsigned mSize;
+#if defined(_WIN32)
+    void* mFileHandle;
+    void* mMappingHandle;
+#endif
+};
+
+}
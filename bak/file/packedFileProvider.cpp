@@ -104,6 +104,7 @@ bool ValidateSignatures(BAK::FileBuffer& rmfBuffer, BAK::FileBuffer& packedBuffe
 PackedFileDataProvider::PackedFileDataProvider(IDataBufferProvider& dataProvider)
 :
     mCache{},
+    mResourceFile{},
     mResourceFileFb{0},
     mLogger{Logging::LogState::GetLogger("PackedFileDataProvider")}
 {
@@ -140,7 +141,8 @@ PackedFileDataProvider::PackedFileDataProvider(
     std::string resourceIndexFile)
 :
     mCache{},
-    mResourceFileFb{CreateFileBuffer(resourceFile)},
+    mResourceFile{resourceFile},
+    mResourceFileFb{mResourceFile.GetFileBuffer()},
     mLogger{Logging::LogState::GetLogger("PackedFileDataProvider")}
 {
     FileBuffer resourceIndexFb = CreateFileBuffer(resourceIndexFile);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "bak/file/IDataBufferProvider.hpp"
+#include "bak/file/mappedFile.hpp"
 
 #include "com/logger.hpp"
 
@@ -28,8 +29,10 @@ private:
         BAK::FileBuffer* packedResource,
         const ResourceIndex& resourceIndex);
 
+    // Resources are views directly into the packed resource file
     std::unordered_map<std::string, FileBuffer> mCache;
 
+    MappedFile mResourceFile;
     FileBuffer mResourceFileFb;
     const Logging::Logger& mLogger;
 };
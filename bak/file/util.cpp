@@ -2,6 +2,8 @@
 
 #include "com/logger.hpp"
 
+#include <algorithm>
+
 namespace BAK::File {
 
 unsigned GetStreamSize(std::ifstream& ifs)
@@ -38,4 +40,30 @@ FileBuffer CreateFileBuffer(const std::string& fileName)
     return fb;
 }
 
+FileBuffer CreateFileBuffer(const std::string& fileName, unsigned size)
+{
+    Logging::LogDebug(__FUNCTION__) << "Opening: " << fileName
+        << " reading up to: " << size << " bytes" << std::endl;
+    std::ifstream in{};
+    in.open(fileName, std::ios::in | std::ios::binary);
+
+    if (!in.is_open())
+    {
+        std::stringstream ss{};
+        ss << __FILE__ << ":" << __LINE__ << " " << __FUNCTION__ << " OpenError!";
+        Logging::LogFatal("FileBuffer") << ss.str() << std::endl;
+        throw std::runtime_error(ss.str());
+    }
+    in.clear();
+
+    in.seekg(0, std::ios_base::end);
+    const auto fileSize = static_cast<unsigned>(in.tellg());
+    in.seekg(0, std::ios_base::beg);
+
+    FileBuffer fb{std::min(size, fileSize)};
+    fb.Load(in);
+    in.close();
+    return fb;
+}
+
 }
@@ -5,5 +5,8 @@ namespace BAK::File {
 unsigned GetStreamSize(std::ifstream& ifs);
 
 FileBuffer CreateFileBuffer(const std::string& fileName);
+// Reads only the first size bytes of the file, or all of it if it is
+// smaller, e.g. to load just a header
+FileBuffer CreateFileBuffer(const std::string& fileName, unsigned size);
 
 }
@@ -12,6 +12,7 @@ namespace BAK {
 FileBufferFactory::FileBufferFactory()
 :
     mDataPath{(std::filesystem::path{Paths::Get().GetBakDirectory()} / "data").string()},
+    mDataFileMutex{},
     mDataFileProvider{{
         (Paths::Get().GetBakDirectoryPath() / "data").string(),
         Paths::Get().GetBakDirectory()
@@ -31,9 +32,12 @@ void FileBufferFactory::SetDataPath(const std::string& dataPath)
 
 FileBuffer FileBufferFactory::CreateDataBuffer(const std::string& fileName)
 {
+    auto lock = std::unique_lock{mDataFileMutex};
     auto* dataBuffer = mDataFileProvider.GetDataBuffer(fileName);
     if (dataBuffer != nullptr)
     {
+        // Index once per data file, every buffer handed out shares it
+        dataBuffer->GetChunkIndex();
         return dataBuffer->MakeSubBuffer(0, dataBuffer->GetSize());
     }
     else
@@ -47,6 +51,7 @@ FileBuffer FileBufferFactory::CreateDataBuffer(const std::string& fileName)
 
 bool FileBufferFactory::DataBufferExists(const std::string& fileName)
 {
+    auto lock = std::unique_lock{mDataFileMutex};
     return mDataFileProvider.GetDataBuffer(fileName) != nullptr;
 }
 
@@ -2,6 +2,7 @@
 
 #include "bak/file/aggregateFileProvider.hpp"
 
+#include <mutex>
 #include <string>
 
 namespace BAK {
@@ -32,6 +33,8 @@ private:
 
     std::string mDataPath;
     std::string mSavePath;
+    // Providers cache the files they open, zones are loaded from worker threads
+    std::mutex mDataFileMutex;
     File::AggregateFileProvider mDataFileProvider;
 };
 
@@ -31,8 +31,8 @@ Graphics::Texture GlyphToTexture(const Glyph& glyph)
         for (unsigned c = 0; c < glyph.mWidth; c++)
         {
             const auto pixel = (glyph.mPoints[r] & (0x8000 >> c))
-                ? glm::vec4{0.0f, 0.0f, 0.0f, 1.0f}
-                : glm::vec4{0.0f, 0.0f, 0.0f, 0.0f};
+                ? Graphics::Pixel{0, 0, 0, 255}
+                : Graphics::Pixel{0, 0, 0, 0};
             
             data.push_back(pixel);
         }
@@ -144,7 +144,7 @@ Font LoadFont(FileBuffer& fb)
                     // FIXME: probably do this elsewhere...
                     float shade = static_cast<float>(index) / 128.0f;
                     auto color = glm::vec4{shade, 0, 0, index != 0 ? 1.0f : 0.0f};
-                    data.push_back(color);
+                    data.push_back(Graphics::ToPixel(color));
                 }
             }
             auto texture = Graphics::Texture{data, width, height, width, height};
@@ -6,6 +6,9 @@
 #include "bak/fileBufferFactory.hpp"
 #include "bak/types.hpp"
 
+#include <filesystem>
+#include <span>
+#include <vector>
 
 namespace BAK {
 
@@ -13,6 +16,7 @@ GameData::GameData()
 :
     mBuffer{1},
     mLogger{Logging::LogState::GetLogger("GameData")},
+    mSaveWriter{},
     mName{""},
     mChapter{1},
     mMapLocation{{20, 20}, 0},
@@ -43,6 +47,7 @@ GameData::GameData(const std::string& save)
 :
     mBuffer{FileBufferFactory::Get().CreateSaveBuffer(save)},
     mLogger{Logging::LogState::GetLogger("GameData")},
+    mSaveWriter{},
     mName{LoadSaveName(mBuffer)},
     mChapter{LoadChapter(mBuffer)},
     mMapLocation{LoadMapLocation(mBuffer)},
@@ -52,12 +57,15 @@ GameData::GameData(const std::string& save)
 {
     mLogger.Info() << "Loading save: " << mBuffer.GetString() << std::endl;
     LoadChapterOffsetP(mBuffer);
+    SetSaveBase(save);
     mIsLoaded = true;
 }
 
 void GameData::Load(const std::string& save)
 {
     mLogger.Info() << "Loading save: " << mBuffer.GetString() << std::endl;
+    // A save to this file may still be being written
+    mSaveWriter.Flush();
     mBuffer = FileBufferFactory::Get().CreateSaveBuffer(save);
     mName = LoadSaveName(mBuffer);
     mChapter = Chapter{LoadChapter(mBuffer)};
@@ -66,7 +74,56 @@ void GameData::Load(const std::string& save)
     mTime = LoadWorldTime(mBuffer);
     mParty = LoadParty(mBuffer);
     LoadChapterOffsetP(mBuffer);
+    SetSaveBase(save);
     mIsLoaded = true;
 }
 
+bool GameData::Save(
+    const std::string& saveName,
+    const std::string& savePath)
+{
+    return mSaveWriter.Write(savePath, SnapshotSave(saveName, savePath)).get();
+}
+
+void GameData::SaveAsync(
+    const std::string& saveName,
+    const std::string& savePath,
+    OnSaved&& onSaved)
+{
+    mSaveWriter.Write(savePath, SnapshotSave(saveName, savePath), std::move(onSaved));
+}
+
+bool GameData::IsSaving() const
+{
+    return mSaveWriter.IsWriting();
+}
+
+void GameData::RunSaveCompletions()
+{
+    mSaveWriter.RunCompletions();
+}
+
+std::vector<std::uint8_t> GameData::SnapshotSave(
+    const std::string& saveName,
+    const std::string& savePath)
+{
+    ASSERT(saveName.size() < 30);
+    mBuffer.Seek(0);
+    mBuffer.PutString(saveName);
+    mBuffer.Seek(0);
+
+    mLogger.Info() << "Saving [" << saveName << "] game to: " << savePath << std::endl;
+    const auto* data = mBuffer.GetCurrent();
+    return std::vector<std::uint8_t>(data, data + mBuffer.GetSize());
+}
+
+void GameData::SetSaveBase(const std::string& save)
+{
+    // A new game is loaded from the data files rather than a save
+    if (!std::filesystem::exists(save))
+        return;
+    mBuffer.Seek(0);
+    mSaveWriter.SetBase(save, std::span{mBuffer.GetCurrent(), mBuffer.GetSize()});
+}
+
 }
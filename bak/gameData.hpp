@@ -12,6 +12,7 @@
 #include "com/logger.hpp"
 
 #include "bak/fileBufferFactory.hpp"
+#include "bak/file/asyncFileWriter.hpp"
 
 namespace BAK {
 
@@ -25,31 +26,42 @@ public:
 
     void Load(const std::string& save);
 
-    void Save(const SaveFile& saveFile)
+    using OnSaved = File::AsyncFileWriter::OnWritten;
+
+    bool Save(const SaveFile& saveFile)
     {
-        Save(saveFile.mName, saveFile.mPath);
+        return Save(saveFile.mName, saveFile.mPath);
     }
 
-    void Save(
+    // Only the pages of the buffer that differ from what was last loaded
+    // or saved there are written, into a copy of the file that then
+    // replaces it. Nothing is written if no page differs.
+    bool Save(
         const std::string& saveName,
-        const std::string& savePath)
+        const std::string& savePath);
+
+    void SaveAsync(const SaveFile& saveFile, OnSaved&& onSaved)
     {
-        ASSERT(saveName.size() < 30);
-        mBuffer.Seek(0);
-        mBuffer.PutString(saveName);
-
-        mLogger.Info() << "Saving [" << saveName << "] game to: " << savePath << std::endl;
-        auto saveFile = std::ofstream{
-            savePath,
-            std::ios::binary | std::ios::out};
-        mBuffer.Save(saveFile);
+        SaveAsync(saveFile.mName, saveFile.mPath, std::move(onSaved));
     }
 
+    // Copies the buffer and writes it on a background thread, so the buffer
+    // can be changed straight away. Saves finish in the order they were
+    // made. onSaved is called from RunSaveCompletions.
+    void SaveAsync(
+        const std::string& saveName,
+        const std::string& savePath,
+        OnSaved&& onSaved);
+
+    bool IsSaving() const;
+    void RunSaveCompletions();
+
     FileBuffer& GetFileBuffer() { return mBuffer; }
     FileBuffer& GetFileBuffer() const { return mBuffer; }
 
     mutable FileBuffer mBuffer;
     Logging::Logger mLogger;
+    File::AsyncFileWriter mSaveWriter;
 
     std::string mName;
     Chapter mChapter;
@@ -58,6 +70,12 @@ public:
     WorldClock mTime;
     Party mParty;
     bool mIsLoaded{false};
+
+private:
+    std::vector<std::uint8_t> SnapshotSave(
+        const std::string& saveName,
+        const std::string& savePath);
+    void SetSaveBase(const std::string& save);
 };
 
 }
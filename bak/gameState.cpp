@@ -38,6 +38,15 @@
 
 namespace BAK {
 
+namespace {
+
+std::uint64_t PositionKey(GamePosition position)
+{
+    return (static_cast<std::uint64_t>(position.x) << 32) | position.y;
+}
+
+}
+
 GameState::GameState()
 :
     mDialogCharacter{},
@@ -52,6 +61,8 @@ GameState::GameState()
     mEndOfDialogState{0},
     mContainers{},
     mGDSContainers{},
+    mContainerIndices{},
+    mGDSContainerIndices{},
     mCombatContainers{},
     mTextVariableStore{},
     mFullMap{},
@@ -71,6 +82,7 @@ void GameState::LoadGame(std::string savePath)
     }
     mGDSContainers = LoadShops(mGameData.GetFileBuffer());
     mCombatContainers = LoadCombatInventories(mGameData.GetFileBuffer());
+    IndexContainers();
     mTimeExpiringState = LoadTimeExpiringState(mGameData.GetFileBuffer());
     mCombatEntityLists = LoadCombatEntityLists(mGameData.GetFileBuffer());
     mCombatWorldLocations = LoadCombatWorldLocations(mGameData.GetFileBuffer());
@@ -249,36 +261,55 @@ unsigned GameState::GetShopType_7542() const
 
 GenericContainer* GameState::GetContainerForGDSScene(HotspotRef ref)
 {
-    for (auto& shop : mGDSContainers)
-    {
-        if (shop.GetHeader().GetHotspotRef() == ref)
-            return &shop;
-    }
-    return nullptr;
+    const auto it = mGDSContainerIndices.find(ref);
+    if (it == mGDSContainerIndices.end())
+        return nullptr;
+    return &mGDSContainers[it->second];
 }
 
 GenericContainer* GameState::GetWorldContainer(ZoneNumber zone, GamePosition location)
 {
-    for (auto& container : GetContainers(zone))
-    {
-        if (container.GetHeader().GetPosition() == location)
-        {
-            return &container;
-        }
-    }
-    return nullptr;
+    const auto index = FindWorldContainer(zone, location);
+    return index ? &GetContainers(zone)[*index] : nullptr;
 }
 
 GenericContainer const* GameState::GetWorldContainer(ZoneNumber zone, GamePosition location) const
 {
-    for (auto& container : GetContainers(zone))
+    const auto index = FindWorldContainer(zone, location);
+    return index ? &GetContainers(zone)[*index] : nullptr;
+}
+
+std::optional<unsigned> GameState::FindWorldContainer(ZoneNumber zone, GamePosition location) const
+{
+    if (zone.mValue >= mContainerIndices.size())
+        return std::nullopt;
+    const auto& indices = mContainerIndices[zone.mValue];
+    const auto it = indices.find(PositionKey(location));
+    if (it == indices.end())
+        return std::nullopt;
+    return it->second;
+}
+
+void GameState::IndexContainers()
+{
+    // Lookups return the first container at a position, as a scan would
+    mContainerIndices.clear();
+    for (const auto& containers : mContainers)
     {
-        if (container.GetHeader().GetPosition() == location)
+        auto& indices = mContainerIndices.emplace_back();
+        indices.reserve(containers.size());
+        for (unsigned i = 0; i < containers.size(); i++)
         {
-            return &container;
+            indices.try_emplace(PositionKey(containers[i].GetHeader().GetPosition()), i);
         }
     }
-    return nullptr;
+
+    mGDSContainerIndices.clear();
+    mGDSContainerIndices.reserve(mGDSContainers.size());
+    for (unsigned i = 0; i < mGDSContainers.size(); i++)
+    {
+        mGDSContainerIndices.try_emplace(mGDSContainers[i].GetHeader().GetHotspotRef(), i);
+    }
 }
 
 std::optional<unsigned> GameState::GetActor(unsigned actor) const
@@ -1238,15 +1269,21 @@ bool GameState::Save(const SaveFile& saveFile)
 {
     if (!SaveState())
         return false;
-    mGameData.Save(saveFile);
-    return true;
+    return mGameData.Save(saveFile);
 }
 
 bool GameState::Save(const std::string& saveName)
 {
     if (!SaveState())
         return false;
-    mGameData.Save(saveName, saveName);
+    return mGameData.Save(saveName, saveName);
+}
+
+bool GameState::SaveAsync(const SaveFile& saveFile, GameData::OnSaved&& onSaved)
+{
+    if (!SaveState())
+        return false;
+    mGameData.SaveAsync(saveFile, std::move(onSaved));
     return true;
 }
 
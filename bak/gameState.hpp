@@ -23,6 +23,7 @@
 #include <functional>
 #include <memory>
 #include <type_traits>
+#include <unordered_map>
 
 namespace BAK {
 
@@ -191,6 +192,8 @@ public:
     bool SaveState();
     bool Save(const SaveFile& saveFile);
     bool Save(const std::string& saveName);
+    // Returns false without calling onSaved if no game is loaded
+    bool SaveAsync(const SaveFile& saveFile, GameData::OnSaved&& onSaved);
 
     std::vector<GenericContainer>& GetContainers(ZoneNumber zone);
     const std::vector<GenericContainer>& GetContainers(ZoneNumber zone) const;
@@ -216,6 +219,8 @@ public:
 
 private:
     std::vector<CombatEntityList> RegenerateCombatEntityLists();
+    void IndexContainers();
+    std::optional<unsigned> FindWorldContainer(ZoneNumber zone, GamePosition location) const;
 
     std::optional<CharIndex> mDialogCharacter{};
     CharIndex mActiveCharacter{};
@@ -251,6 +256,10 @@ private:
     std::vector<
         std::vector<GenericContainer>> mContainers{};
     std::vector<GenericContainer> mGDSContainers{};
+    // Index of the first container at each position of each zone, and of
+    // the container for each GDS scene. Built when the containers are loaded.
+    std::vector<std::unordered_map<std::uint64_t, unsigned>> mContainerIndices{};
+    std::unordered_map<HotspotRef, unsigned> mGDSContainerIndices{};
     std::vector<GenericContainer> mCombatContainers;
     std::vector<TimeExpiringState> mTimeExpiringState{};
     std::vector<TileVisibility> mTileVisibility{};
@@ -42,3 +42,14 @@ std::ostream& operator<<(std::ostream& os, const HotspotRef& hr)
 }
 
 }
+
+namespace std {
+
+std::size_t hash<BAK::HotspotRef>::operator()(const BAK::HotspotRef& t) const noexcept
+{
+    return std::hash<std::size_t>{}(
+        (static_cast<std::size_t>(t.mGdsNumber) << 8)
+        | static_cast<std::uint8_t>(t.mGdsChar));
+}
+
+}
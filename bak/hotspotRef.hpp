@@ -22,3 +22,12 @@ char MakeHotspotChar(std::uint8_t);
 std::ostream& operator<<(std::ostream&, const HotspotRef&);
 
 }
+
+namespace std {
+
+template<> struct hash<BAK::HotspotRef>
+{
+    std::size_t operator()(const BAK::HotspotRef& t) const noexcept;
+};
+
+}
@@ -1,8 +1,7 @@
 #include "bak/palette.hpp"
 
 #include "bak/dataTags.hpp"
-#include "bak/fileBufferFactory.hpp"
-
+#include "bak/file/fileBuffer.hpp"
 
 #include "com/assert.hpp"
 
@@ -10,17 +9,10 @@
 
 namespace BAK {
 
-Palette::Palette(const std::string& filename)
-:
-    mColors{}
-{
-    auto fb = FileBufferFactory::Get().CreateDataBuffer(filename);
-    *this = Palette{fb};
-}
-
 Palette::Palette(FileBuffer& fb)
 :
-    mColors{}
+    mColors{},
+    mColors8{}
 {
     auto palbuf = fb.Find(DataTag::VGA);
     const auto size = palbuf.GetSize() / 3;
@@ -38,7 +30,7 @@ Palette::Palette(FileBuffer& fb)
         const auto a = i == 0 ? 0.0 : 1.0;
         mColors.emplace_back(F(r), F(g), F(b) , a);
         std::uint8_t alpha = i == 0 ? 0 : 255;
-        mColors8.emplace_back(std::array<std::uint8_t, 4>{r, g, b, alpha});
+        mColors8.emplace_back(r, g, b, alpha);
     }
 }
 
@@ -51,6 +43,14 @@ Palette::Palette(const Palette& pal, const ColorSwap& cs)
             swappedPal.emplace_back(cs.GetColor(i, pal));
         }
         return swappedPal;
+    })},
+    mColors8{std::invoke([&](){
+        auto swappedPal = std::vector<glm::u8vec4>{};
+        for (unsigned i = 0; i < 256; i++)
+        {
+            swappedPal.emplace_back(cs.GetColor8(i, pal));
+        }
+        return swappedPal;
     })}
 {
 }
@@ -61,18 +61,22 @@ const glm::vec4& Palette::GetColor(unsigned i) const
     return mColors[i];
 }
 
-const std::vector<std::array<std::uint8_t, 4>>& Palette::GetColors8() const
+const glm::u8vec4& Palette::GetColor8(unsigned i) const
+{
+    ASSERT(i < mColors8.size());
+    return mColors8[i];
+}
+
+const std::vector<glm::u8vec4>& Palette::GetColors8() const
 {
     return mColors8;
 }
 
-ColorSwap::ColorSwap(const std::string& filename)
+ColorSwap::ColorSwap(FileBuffer& fb)
 :
     mIndices{}
 {
     mIndices.reserve(sSize);
-    auto fb = FileBufferFactory::Get().CreateDataBuffer(filename);
-
     for (unsigned i = 0; i < sSize; i++)
     {
         mIndices.emplace_back(fb.GetUint8());
@@ -85,4 +89,10 @@ const glm::vec4& ColorSwap::GetColor(unsigned i, const Palette& pal) const
     return pal.GetColor(mIndices[i]);
 }
 
+const glm::u8vec4& ColorSwap::GetColor8(unsigned i, const Palette& pal) const
+{
+    ASSERT(i < sSize);
+    return pal.GetColor8(mIndices[i]);
+}
+
 }
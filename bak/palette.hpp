@@ -1,9 +1,9 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
 
 #include <array>
-#include <string>
 #include <vector>
 
 namespace BAK {
@@ -16,9 +16,11 @@ class ColorSwap
 public:
     static constexpr auto sSize = 256;
 
-    ColorSwap(const std::string& filename);
+    // Files are loaded through ResourceCache::GetColorSwap
+    ColorSwap(FileBuffer& fb);
 
     const glm::vec4& GetColor(unsigned i, const Palette&) const;
+    const glm::u8vec4& GetColor8(unsigned i, const Palette&) const;
 
 private:
     std::vector<unsigned> mIndices;
@@ -27,15 +29,16 @@ private:
 class Palette
 {
 public:
-    Palette(const std::string& filename);
+    // Files are loaded through ResourceCache::GetPalette
     Palette(FileBuffer& fb);
     Palette(const Palette& pal, const ColorSwap& cs);
 
     const glm::vec4& GetColor(unsigned i) const;
-    const std::vector<std::array<std::uint8_t, 4>>& GetColors8() const;
+    const glm::u8vec4& GetColor8(unsigned i) const;
+    const std::vector<glm::u8vec4>& GetColors8() const;
 private:
     std::vector<glm::vec4> mColors;
-    std::vector<std::array<std::uint8_t, 4>> mColors8;
+    std::vector<glm::u8vec4> mColors8;
 };
 
 
@@ -0,0 +1,210 @@
+#include "bak/resourceCache.hpp"
+
+#include "bak/fileBufferFactory.hpp"
+#include "bak/font.hpp"
+#include "bak/image.hpp"
+#include "bak/imageStore.hpp"
+#include "bak/palette.hpp"
+#include "bak/screen.hpp"
+
+#include "com/logger.hpp"
+
+#include <utility>
+
+namespace BAK {
+
+ResourceCache::ResourceCache()
+:
+    mMutex{},
+    mEntries{},
+    mBudget{sDefaultBudget},
+    mUseCount{0},
+    mStats{}
+{
+}
+
+ResourceCache& ResourceCache::Get()
+{
+    static ResourceCache cache{};
+    return cache;
+}
+
+std::shared_ptr<const Palette> ResourceCache::GetPalette(const std::string& palette)
+{
+    return GetOrLoad<Palette>(
+        "PAL:" + palette,
+        [&]{
+            auto fb = FileBufferFactory::Get().CreateDataBuffer(palette);
+            auto result = std::make_shared<const Palette>(fb);
+            const auto bytes = result->GetColors8().size()
+                * (sizeof(glm::vec4) + sizeof(glm::u8vec4));
+            return std::make_pair(std::move(result), bytes);
+        });
+}
+
+std::shared_ptr<const Palette> ResourceCache::GetPalette(
+    const std::string& palette,
+    const std::string& colorSwap)
+{
+    return GetOrLoad<Palette>(
+        "PAL:" + palette + "+" + colorSwap,
+        [&]{
+            auto result = std::make_shared<const Palette>(
+                *GetPalette(palette),
+                *GetColorSwap(colorSwap));
+            const auto bytes = result->GetColors8().size()
+                * (sizeof(glm::vec4) + sizeof(glm::u8vec4));
+            return std::make_pair(std::move(result), bytes);
+        });
+}
+
+std::shared_ptr<const ColorSwap> ResourceCache::GetColorSwap(const std::string& colorSwap)
+{
+    return GetOrLoad<ColorSwap>(
+        "CS:" + colorSwap,
+        [&]{
+            auto fb = FileBufferFactory::Get().CreateDataBuffer(colorSwap);
+            return std::make_pair(
+                std::make_shared<const ColorSwap>(fb),
+                ColorSwap::sSize * sizeof(unsigned));
+        });
+}
+
+std::shared_ptr<const std::vector<Image>> ResourceCache::GetImages(const std::string& bmx)
+{
+    return GetOrLoad<std::vector<Image>>(
+        "BMX:" + bmx,
+        [&]{
+            auto fb = FileBufferFactory::Get().CreateDataBuffer(bmx);
+            auto result = std::make_shared<const std::vector<Image>>(LoadImages(fb));
+            std::size_t bytes = 0;
+            for (const auto& image : *result)
+            {
+                bytes += image.GetVector().size();
+            }
+            return std::make_pair(std::move(result), bytes);
+        });
+}
+
+std::shared_ptr<const Image> ResourceCache::GetScreen(const std::string& scx)
+{
+    return GetOrLoad<Image>(
+        "SCX:" + scx,
+        [&]{
+            auto fb = FileBufferFactory::Get().CreateDataBuffer(scx);
+            auto result = std::make_shared<const Image>(LoadScreenResource(fb));
+            const auto bytes = result->GetVector().size();
+            return std::make_pair(std::move(result), bytes);
+        });
+}
+
+std::shared_ptr<const Font> ResourceCache::GetFont(const std::string& fnt)
+{
+    return GetOrLoad<Font>(
+        "FNT:" + fnt,
+        [&]{
+            auto fb = FileBufferFactory::Get().CreateDataBuffer(fnt);
+            auto result = std::make_shared<const Font>(LoadFont(fb));
+            const auto bytes = result->GetCharacters().GetSizeInBytes();
+            return std::make_pair(std::move(result), bytes);
+        });
+}
+
+ResourceCache::Stats ResourceCache::GetStats() const
+{
+    auto lock = std::unique_lock{mMutex};
+    return mStats;
+}
+
+void ResourceCache::SetBudget(std::size_t bytes)
+{
+    auto lock = std::unique_lock{mMutex};
+    mBudget = bytes;
+    EvictUnused();
+}
+
+void ResourceCache::Clear()
+{
+    auto lock = std::unique_lock{mMutex};
+    mEntries.clear();
+    mStats.mBytes = 0;
+}
+
+template <typename T>
+std::shared_ptr<const T> ResourceCache::GetOrLoad(
+    const std::string& key,
+    const std::function<std::pair<std::shared_ptr<const T>, std::size_t>()>& load)
+{
+    if (auto resource = Find(key))
+    {
+        return std::static_pointer_cast<const T>(resource);
+    }
+
+    // Loaded without holding the lock so that loading threads don't wait
+    // on each other. If two threads load the same resource the first one
+    // inserted is kept.
+    auto [resource, bytes] = load();
+    return std::static_pointer_cast<const T>(
+        Insert(key, std::move(resource), bytes));
+}
+
+std::shared_ptr<const void> ResourceCache::Find(const std::string& key)
+{
+    auto lock = std::unique_lock{mMutex};
+    const auto it = mEntries.find(key);
+    if (it == mEntries.end())
+    {
+        mStats.mMisses++;
+        return nullptr;
+    }
+    mStats.mHits++;
+    it->second.mLastUsed = ++mUseCount;
+    return it->second.mResource;
+}
+
+std::shared_ptr<const void> ResourceCache::Insert(
+    const std::string& key,
+    std::shared_ptr<const void> resource,
+    std::size_t bytes)
+{
+    auto lock = std::unique_lock{mMutex};
+    const auto [it, inserted] = mEntries.try_emplace(
+        key,
+        Entry{std::move(resource), bytes, ++mUseCount});
+    if (inserted)
+    {
+        Logging::LogSpam("ResourceCache") << "Loaded: " << key << " (" << bytes << " bytes)\n";
+        mStats.mBytes += bytes;
+    }
+    auto result = it->second.mResource;
+    EvictUnused();
+    return result;
+}
+
+void ResourceCache::EvictUnused()
+{
+    while (mStats.mBytes > mBudget)
+    {
+        // Evicting a resource that is still held would free nothing
+        auto oldest = mEntries.end();
+        for (auto it = mEntries.begin(); it != mEntries.end(); ++it)
+        {
+            if (it->second.mResource.use_count() == 1
+                && (oldest == mEntries.end() || it->second.mLastUsed < oldest->second.mLastUsed))
+            {
+                oldest = it;
+            }
+        }
+
+        if (oldest == mEntries.end())
+        {
+            return;
+        }
+
+        mStats.mBytes -= oldest->second.mBytes;
+        mStats.mEvictions++;
+        mEntries.erase(oldest);
+    }
+}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BAK {
+
+class ColorSwap;
+class Font;
+class Image;
+class Palette;
+
+// Decoded data files shared by everything that loads them, so that e.g.
+// reopening a screen doesn't decompress its images and palette again.
+//
+// Safe to use from loading threads. Resources nothing else holds are
+// dropped, least recently used first, once the cache grows past its budget.
+class ResourceCache
+{
+public:
+    static constexpr std::size_t sDefaultBudget = 64 * 1024 * 1024;
+
+    struct Stats
+    {
+        std::size_t mHits;
+        std::size_t mMisses;
+        std::size_t mEvictions;
+        std::size_t mBytes;
+    };
+
+    static ResourceCache& Get();
+
+    std::shared_ptr<const Palette> GetPalette(const std::string& palette);
+    // The palette with the colour swap applied
+    std::shared_ptr<const Palette> GetPalette(
+        const std::string& palette,
+        const std::string& colorSwap);
+    std::shared_ptr<const ColorSwap> GetColorSwap(const std::string& colorSwap);
+    // Every image of a BMX file
+    std::shared_ptr<const std::vector<Image>> GetImages(const std::string& bmx);
+    std::shared_ptr<const Image> GetScreen(const std::string& scx);
+    std::shared_ptr<const Font> GetFont(const std::string& fnt);
+
+    Stats GetStats() const;
+    void SetBudget(std::size_t bytes);
+    void Clear();
+
+private:
+    ResourceCache();
+
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    struct Entry
+    {
+        std::shared_ptr<const void> mResource;
+        std::size_t mBytes;
+        std::uint64_t mLastUsed;
+    };
+
+    template <typename T>
+    std::shared_ptr<const T> GetOrLoad(
+        const std::string& key,
+        const std::function<std::pair<std::shared_ptr<const T>, std::size_t>()>& load);
+
+    std::shared_ptr<const void> Find(const std::string& key);
+    std::shared_ptr<const void> Insert(
+        const std::string& key,
+        std::shared_ptr<const void> resource,
+        std::size_t bytes);
+    void EvictUnused();
+
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, Entry> mEntries;
+    std::size_t mBudget;
+    std::uint64_t mUseCount;
+    Stats mStats;
+};
+
+}
@@ -4,6 +4,7 @@
 #include "bak/save/world.hpp"
 
 #include "com/path.hpp"
+#include "com/threadPool.hpp"
 
 #include <algorithm>
 #include <functional>
@@ -11,6 +12,16 @@
 
 namespace BAK {
 
+namespace {
+
+const auto sSaveSuffix = std::regex{"[Ss][Aa][Vv][Ee]([0-9]{2}).[Gg][Aa][mM]$"};
+const auto sDirSuffix = std::regex{".[Gg]([0-9]{2})$"};
+
+// LoadSaveName and LoadChapter only read this far into a save
+constexpr auto sSaveHeaderSize = 0x66;
+
+}
+
 unsigned convertToInt(const std::string& s)
 {
     std::stringstream ss{};
@@ -62,6 +73,7 @@ SaveManager::SaveManager(
 :
     mSavePath{savePath},
     mDirectories{},
+    mSaveHeaders{},
     mLogger{Logging::LogState::GetLogger("BAK::SaveManager")}
 {}
 
@@ -188,20 +200,18 @@ const SaveFile& SaveManager::MakeSave(
     }
 }
 
-std::pair<std::vector<SaveFile>, bool> SaveManager::MakeSaveFiles(std::filesystem::path saveDir)
+SaveManager::ScannedSaves SaveManager::MakeSaveFiles(const std::filesystem::path& saveDir) const
 {
-    const auto saveSuffix = std::regex{"[Ss][Aa][Vv][Ee]([0-9]{2}).[Gg][Aa][mM]$"};
     const auto saveFileDir = std::filesystem::directory_iterator{saveDir};
 
-    std::vector<SaveFile> saveFiles{};
-    bool gameCompleted{};
+    auto scanned = ScannedSaves{{}, false, {}};
     for (const auto& save : saveFileDir)
     {
         const auto saveName = save.path().filename().string();
-        Logging::LogDebug(__FUNCTION__) << "Save: " << saveName << " matches: "
-            << std::regex_search(saveName, saveSuffix) << std::endl;
         std::smatch matches{};
-        std::regex_search(saveName, matches, saveSuffix);
+        std::regex_search(saveName, matches, sSaveSuffix);
+        Logging::LogDebug(__FUNCTION__) << "Save: " << saveName << " matches: "
+            << !matches.empty() << std::endl;
         if (matches.size() > 0)
         {
             const auto index = convertToInt(matches.str(1));
@@ -209,26 +219,43 @@ std::pair<std::vector<SaveFile>, bool> SaveManager::MakeSaveFiles(std::filesyste
             // has been completed.
             if (index == sMaxSaveFiles + 1)
             {
-                gameCompleted = true;
+                scanned.mGameCompleted = true;
                 continue;
             }
-            auto fb = File::CreateFileBuffer(save.path().string());
-            const auto name = index == 0 ? "Bookmark" : LoadSaveName(fb);
-            const auto chapter = LoadChapter(fb);
-            saveFiles.emplace_back(
+
+            const auto path = save.path().string();
+            const auto modified = save.last_write_time();
+            const auto size = save.file_size();
+            auto header = std::invoke([&]{
+                const auto it = mSaveHeaders.find(path);
+                if (it != mSaveHeaders.end()
+                    && it->second.mModified == modified
+                    && it->second.mSize == size)
+                {
+                    return it->second;
+                }
+
+                auto fb = File::CreateFileBuffer(path, sSaveHeaderSize);
+                auto name = LoadSaveName(fb);
+                const auto chapter = LoadChapter(fb);
+                return SaveHeader{modified, size, std::move(name), chapter};
+            });
+
+            scanned.mSaves.emplace_back(
                 SaveFile{
                     index,
-                    name,
-                    chapter,
-                    save.path().string()});
+                    index == 0 ? "Bookmark" : header.mName,
+                    header.mChapter,
+                    path});
+            scanned.mHeaders.emplace(path, std::move(header));
         }
     }
 
     std::sort(
-        saveFiles.begin(), saveFiles.end(),
+        scanned.mSaves.begin(), scanned.mSaves.end(),
         [](const auto& lhs, const auto& rhs){ return lhs.mIndex < rhs.mIndex; });
 
-    return std::make_pair(saveFiles, gameCompleted);
+    return scanned;
 }
 
 std::vector<SaveDirectory> SaveManager::MakeSaveDirectories()
@@ -255,25 +282,39 @@ std::vector<SaveDirectory> SaveManager::MakeSaveDirectories()
     const auto saveDirectories = std::filesystem::directory_iterator{
         gameDirectoryPath};
 
-    const auto dirSuffix = std::regex{".[Gg]([0-9]{2})$"};
-
+    std::vector<std::pair<unsigned, std::filesystem::path>> directories{};
     for (const auto& directory : saveDirectories)
     {
         const auto dirName = directory.path().filename().string();
-        Logging::LogDebug(__FUNCTION__) << "Directory: " << dirName << " matches: " << std::regex_search(dirName, dirSuffix) << std::endl;
         std::smatch matches{};
-        std::regex_search(dirName, matches, dirSuffix);
+        std::regex_search(dirName, matches, sDirSuffix);
+        Logging::LogDebug(__FUNCTION__) << "Directory: " << dirName << " matches: " << !matches.empty() << std::endl;
         if (matches.size() > 0)
         {
-            auto [saveFiles, gameCompleted] = MakeSaveFiles(directory.path());
-            saveDirs.emplace_back(
-                SaveDirectory{
-                    convertToInt(matches.str(1)),
-                    directory.path().stem().string(),
-                    saveFiles,
-                    gameCompleted});
+            directories.emplace_back(convertToInt(matches.str(1)), directory.path());
         }
     }
+
+    // Only reads the saves that changed since the last scan, so
+    // mSaveHeaders must not change until every directory is scanned
+    auto scans = ThreadPool::Get().Map(
+        directories.size(),
+        [&](std::size_t i){ return MakeSaveFiles(directories[i].second); });
+
+    SaveHeaders saveHeaders{};
+    for (unsigned i = 0; i < directories.size(); i++)
+    {
+        auto& scan = scans[i];
+        saveDirs.emplace_back(
+            SaveDirectory{
+                directories[i].first,
+                directories[i].second.stem().string(),
+                std::move(scan.mSaves),
+                scan.mGameCompleted});
+        saveHeaders.merge(scan.mHeaders);
+    }
+    mSaveHeaders = std::move(saveHeaders);
+
     std::sort(
         saveDirs.begin(), saveDirs.end(),
         [](const auto& lhs, const auto& rhs){ return lhs.mIndex < rhs.mIndex; });
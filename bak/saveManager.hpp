@@ -2,7 +2,11 @@
 
 #include "com/logger.hpp"
 
+#include <cstdint>
 #include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace BAK {
 
@@ -56,11 +60,33 @@ public:
         const std::string& saveName,
         bool isBookmark);
 private:
-    std::pair<std::vector<SaveFile>, bool> MakeSaveFiles(std::filesystem::path saveDir);
+    // The name and chapter read from a save, and the file's size and
+    // modification time when they were read
+    struct SaveHeader
+    {
+        std::filesystem::file_time_type mModified;
+        std::uintmax_t mSize;
+        std::string mName;
+        unsigned mChapter;
+    };
+
+    // Keyed by save path
+    using SaveHeaders = std::unordered_map<std::string, SaveHeader>;
+
+    struct ScannedSaves
+    {
+        std::vector<SaveFile> mSaves;
+        bool mGameCompleted;
+        SaveHeaders mHeaders;
+    };
+
+    ScannedSaves MakeSaveFiles(const std::filesystem::path& saveDir) const;
     std::vector<SaveDirectory> MakeSaveDirectories();
 
     std::filesystem::path mSavePath;
     std::vector<SaveDirectory> mDirectories;
+    // From the last scan, reused for saves that have not changed since
+    SaveHeaders mSaveHeaders;
 
     const Logging::Logger& mLogger;
 };
@@ -41,7 +41,7 @@ void SpriteRenderer::SetColors(std::uint8_t fg, std::uint8_t bg)
 
 void SpriteRenderer::SetPixel(
     glm::ivec2 pos,
-    glm::vec4 color,
+    Graphics::Pixel color,
     Graphics::Texture& target)
 {
     if (mClipRegion
@@ -82,7 +82,7 @@ void SpriteRenderer::RenderSprite(
                 flipX ? width  - 1 - x : x,
                 flipY ? height - 1 - y : y};
 
-            SetPixel(pixelPos, palette.GetColor(index), target);
+            SetPixel(pixelPos, palette.GetColor8(index), target);
         }
     }
 }
@@ -101,7 +101,7 @@ void SpriteRenderer::DrawRect(
 
     if (filled)
     {
-        const auto fill = palette.GetColor(mBackgroundColor);
+        const auto fill = palette.GetColor8(mBackgroundColor);
         for (int y = pos.y; y <= bottom; y++)
         {
             for (int x = pos.x; x <= right; x++)
@@ -111,7 +111,7 @@ void SpriteRenderer::DrawRect(
         }
     }
 
-    const auto edge = palette.GetColor(mForegroundColor);
+    const auto edge = palette.GetColor8(mForegroundColor);
     for (int x = pos.x; x <= right; x++)
     {
         SetPixel(glm::ivec2{x, pos.y}, edge, target);
@@ -136,7 +136,7 @@ void SpriteRenderer::CopyImage(
         {
             SetPixel(
                 pos + glm::ivec2{static_cast<int>(x), static_cast<int>(y)},
-                palette.GetColor(source.GetPixel(x, y)),
+                palette.GetColor8(source.GetPixel(x, y)),
                 target);
         }
     }
@@ -71,7 +71,7 @@ public:
     void ClearClipRegion();
 
 private:
-    void SetPixel(glm::ivec2 pos, glm::vec4 color, Graphics::Texture& target);
+    void SetPixel(glm::ivec2 pos, Graphics::Pixel color, Graphics::Texture& target);
 
     std::array<Graphics::Texture, 4> mLayers;
     std::optional<ClipRegion> mClipRegion;
@@ -1,10 +1,9 @@
 #include "bak/scene/ttmRenderer.hpp"
 
-#include "bak/fileBufferFactory.hpp"
-#include "bak/imageStore.hpp"
+#include "bak/image.hpp"
+#include "bak/resourceCache.hpp"
 #include "bak/scene/scene.hpp"
 #include "bak/scene/sceneData.hpp"
-#include "bak/screen.hpp"
 
 #include "com/logger.hpp"
 #include "com/visit.hpp"
@@ -45,17 +44,16 @@ bool TTMRenderer::AdvanceFrame()
                 },
                 [&](const LoadPalette& p){
                     mPaletteSlots.erase(mCurrentPaletteSlot);
-                    mPaletteSlots.emplace(mCurrentPaletteSlot, Palette{p.mPalette});
+                    mPaletteSlots.emplace(mCurrentPaletteSlot, ResourceCache::Get().GetPalette(p.mPalette));
                 },
                 [&](const SlotImage& sp){
                     mCurrentImageSlot = sp.mSlot;
                 },
                 [&](const LoadImage& p){
-                    auto fb = FileBufferFactory::Get().CreateDataBuffer(p.mImage);
                     mImageSlots.erase(mCurrentImageSlot);
-                    mImageSlots.emplace(mCurrentImageSlot, LoadImages(fb));
+                    mImageSlots.emplace(mCurrentImageSlot, ResourceCache::Get().GetImages(p.mImage));
                     mLogger.Debug() << "Loaded image: " << p.mImage << " to slot: " << mCurrentImageSlot
-                        << " has " << mImageSlots.at(mCurrentImageSlot).mImages.size() << " images\n";
+                        << " has " << mImageSlots.at(mCurrentImageSlot).mImages->size() << " images\n";
                 },
                 [&](const LoadScreen& p){
                     if (!mPaletteSlots.contains(mCurrentPaletteSlot))
@@ -64,10 +62,9 @@ bool TTMRenderer::AdvanceFrame()
                             << ", skipping screen " << p.mScreenName << "\n";
                         return;
                     }
-                    auto fb = FileBufferFactory::Get().CreateDataBuffer(p.mScreenName);
                     mRenderer.CopyImage(
-                        LoadScreenResource(fb),
-                        mPaletteSlots.at(mCurrentPaletteSlot).mPaletteData,
+                        *ResourceCache::Get().GetScreen(p.mScreenName),
+                        *mPaletteSlots.at(mCurrentPaletteSlot).mPaletteData,
                         glm::ivec2{0, 0},
                         mRenderer.GetLayer(Layer::Screen));
                     mRenderer.CopyRect(
@@ -86,11 +83,11 @@ bool TTMRenderer::AdvanceFrame()
                 [&](const DrawSprite& sa){
                     assert(mImageSlots.contains(sa.mImageSlot));
                     assert(static_cast<unsigned>(sa.mSpriteIndex)
-                            < mImageSlots.at(sa.mImageSlot).mImages.size());
+                            < mImageSlots.at(sa.mImageSlot).mImages->size());
 
                     mRenderer.RenderSprite(
-                        mImageSlots.at(sa.mImageSlot).mImages[sa.mSpriteIndex],
-                        mPaletteSlots.at(mCurrentPaletteSlot).mPaletteData,
+                        (*mImageSlots.at(sa.mImageSlot).mImages)[sa.mSpriteIndex],
+                        *mPaletteSlots.at(mCurrentPaletteSlot).mPaletteData,
                         glm::ivec2{sa.mX, sa.mY},
                         sa.mFlipX,
                         sa.mFlipY,
@@ -129,7 +126,7 @@ bool TTMRenderer::AdvanceFrame()
                     }
                     mRenderer.DrawRect(
                         sr.mPos, sr.mDims,
-                        mPaletteSlots.at(mCurrentPaletteSlot).mPaletteData,
+                        *mPaletteSlots.at(mCurrentPaletteSlot).mPaletteData,
                         sr.mFilled,
                         mRenderer.GetLayer(Layer::Screen));
                 },
@@ -7,6 +7,7 @@
 
 #include "com/logger.hpp"
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -32,13 +33,14 @@ private:
 
     TTMRunner mRunner;
 
+    // Shared with the ResourceCache
     struct PaletteSlot
     {
-        Palette mPaletteData;
+        std::shared_ptr<const Palette> mPaletteData;
     };
     struct ImageSlot 
     {
-        std::vector<Image> mImages;
+        std::shared_ptr<const std::vector<Image>> mImages;
     };
 
     unsigned mCurrentPaletteSlot = 0;
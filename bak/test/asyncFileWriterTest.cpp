@@ -0,0 +1,69 @@
+#include "gtest/gtest.h"
+
+#include "bak/file/asyncFileWriter.hpp"
+
+#include "bak/test/tempDirectory.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace BAK::File {
+
+struct AsyncFileWriterFixture : public TempDirectoryFixture
+{
+    AsyncFileWriterFixture()
+    :
+        mPath{(mDirectory / "SAVE01.GAM").string()}
+    {}
+
+    std::string mPath;
+};
+
+TEST_F(AsyncFileWriterFixture, WritesInOrder)
+{
+    auto writer = AsyncFileWriter{};
+    std::vector<unsigned> completed{};
+    for (unsigned i = 0; i < 20; i++)
+    {
+        writer.Write(
+            mPath,
+            std::vector<std::uint8_t>(10000, i),
+            [&, i](bool written){
+                EXPECT_TRUE(written);
+                completed.emplace_back(i);
+            });
+    }
+
+    writer.Flush();
+    EXPECT_FALSE(writer.IsWriting());
+    EXPECT_EQ(ReadFile(mPath), std::vector<std::uint8_t>(10000, 19));
+
+    EXPECT_TRUE(completed.empty());
+    writer.RunCompletions();
+    ASSERT_EQ(completed.size(), 20u);
+    for (unsigned i = 0; i < completed.size(); i++)
+    {
+        EXPECT_EQ(completed[i], i);
+    }
+}
+
+TEST_F(AsyncFileWriterFixture, ReportsFailure)
+{
+    auto writer = AsyncFileWriter{};
+    const auto badPath = (mDirectory / "missing" / "SAVE01.GAM").string();
+    EXPECT_FALSE(writer.Write(badPath, std::vector<std::uint8_t>(10, 0)).get());
+    EXPECT_TRUE(writer.Write(mPath, std::vector<std::uint8_t>(10, 1)).get());
+}
+
+TEST_F(AsyncFileWriterFixture, FinishesWritesWhenDestroyed)
+{
+    {
+        auto writer = AsyncFileWriter{};
+        writer.Write(mPath, std::vector<std::uint8_t>(100, 1));
+        writer.Write(mPath, std::vector<std::uint8_t>(100, 2));
+    }
+    EXPECT_EQ(ReadFile(mPath), std::vector<std::uint8_t>(100, 2));
+}
+
+}
@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+
+#include "bak/dataTags.hpp"
+#include "bak/file/chunkIndex.hpp"
+#include "bak/file/fileBuffer.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace BAK {
+
+namespace {
+
+void PutChunk(std::vector<std::uint8_t>& data, DataTag tag, std::uint32_t size)
+{
+    const auto tagValue = static_cast<std::uint32_t>(tag);
+    const auto offset = data.size();
+    data.resize(offset + 8);
+    std::memcpy(data.data() + offset, &tagValue, 4);
+    std::memcpy(data.data() + offset + 4, &size, 4);
+}
+
+void PutPayload(std::vector<std::uint8_t>& data, std::vector<std::uint8_t> payload)
+{
+    data.insert(data.end(), payload.begin(), payload.end());
+}
+
+}
+
+TEST(ChunkIndexTest, IgnoresTagValuesInsidePayloads)
+{
+    auto data = std::vector<std::uint8_t>{};
+    // The VER payload contains the bytes "TAG:" which a linear scan would hit
+    PutChunk(data, DataTag::VER, 8);
+    PutPayload(data, {'T', 'A', 'G', ':', 1, 0, 0, 0});
+    PutChunk(data, DataTag::TAG, 2);
+    PutPayload(data, {0xaa, 0xbb});
+
+    auto fb = FileBuffer::MakeView(data.data(), data.size());
+    ASSERT_TRUE(fb.GetChunkIndex().IsComplete());
+
+    auto tagBuffer = fb.Find(DataTag::TAG);
+    EXPECT_EQ(tagBuffer.GetSize(), 2u);
+    EXPECT_EQ(tagBuffer.GetUint8(), 0xaa);
+    EXPECT_EQ(tagBuffer.GetUint8(), 0xbb);
+}
+
+TEST(ChunkIndexTest, IndexesChildrenOfContainers)
+{
+    auto data = std::vector<std::uint8_t>{};
+    PutChunk(data, DataTag::PAL, 0x80000000 | (8 + 3));
+    PutChunk(data, DataTag::VGA, 3);
+    PutPayload(data, {1, 2, 3});
+
+    auto fb = FileBuffer::MakeView(data.data(), data.size());
+    EXPECT_TRUE(fb.GetChunkIndex().IsComplete());
+    EXPECT_EQ(fb.Find(DataTag::PAL).GetSize(), 11u);
+
+    auto vgaBuffer = fb.Find(DataTag::VGA);
+    EXPECT_EQ(vgaBuffer.GetSize(), 3u);
+    EXPECT_EQ(vgaBuffer.GetUint8(), 1);
+
+    EXPECT_THROW(fb.Find(DataTag::BIN), std::runtime_error);
+}
+
+TEST(ChunkIndexTest, FallsBackToScanAfterUntaggedData)
+{
+    auto data = std::vector<std::uint8_t>{};
+    PutChunk(data, DataTag::INF, 1);
+    PutPayload(data, {7});
+    PutPayload(data, {0, 1, 2, 3});
+    PutChunk(data, DataTag::TAG, 1);
+    PutPayload(data, {9});
+
+    auto fb = FileBuffer::MakeView(data.data(), data.size());
+    EXPECT_FALSE(fb.GetChunkIndex().IsComplete());
+    EXPECT_EQ(fb.Find(DataTag::INF).GetUint8(), 7);
+    EXPECT_EQ(fb.Find(DataTag::TAG).GetUint8(), 9);
+}
+
+TEST(ChunkIndexTest, WholeSubBufferSharesIndex)
+{
+    auto data = std::vector<std::uint8_t>{};
+    PutChunk(data, DataTag::BIN, 1);
+    PutPayload(data, {5});
+
+    auto fb = FileBuffer::MakeView(data.data(), data.size());
+    const auto& index = fb.GetChunkIndex();
+    auto whole = fb.MakeSubBuffer(0, fb.GetSize());
+    EXPECT_EQ(&whole.GetChunkIndex(), &index);
+}
+
+TEST(ChunkIndexTest, WholeSubBufferSharesIndexBuiltLater)
+{
+    auto data = std::vector<std::uint8_t>{};
+    PutChunk(data, DataTag::BIN, 1);
+    PutPayload(data, {5});
+
+    auto fb = FileBuffer::MakeView(data.data(), data.size());
+    auto whole = fb.MakeSubBuffer(0, fb.GetSize());
+    const auto& index = whole.GetChunkIndex();
+    EXPECT_EQ(&fb.GetChunkIndex(), &index);
+}
+
+TEST(ChunkIndexTest, MovedFromBufferIsEmpty)
+{
+    auto data = std::vector<std::uint8_t>{};
+    PutChunk(data, DataTag::BIN, 1);
+    PutPayload(data, {5});
+
+    auto fb = FileBuffer::MakeView(data.data(), data.size());
+    const auto& index = fb.GetChunkIndex();
+    auto moved = std::move(fb);
+    EXPECT_EQ(&moved.GetChunkIndex(), &index);
+    EXPECT_EQ(moved.Find(DataTag::BIN).GetUint8(), 5);
+
+    EXPECT_EQ(fb.GetSize(), 0u);
+    EXPECT_TRUE(fb.GetChunkIndex().IsComplete());
+    EXPECT_FALSE(fb.GetChunkIndex().Find(static_cast<std::uint32_t>(DataTag::BIN)));
+    EXPECT_THROW(fb.Find(DataTag::BIN), std::runtime_error);
+}
+
+TEST(ChunkIndexTest, IsBuiltOnceWhenSharedBetweenThreads)
+{
+    auto data = std::vector<std::uint8_t>{};
+    PutChunk(data, DataTag::INF, 1);
+    PutPayload(data, {7});
+
+    const auto fb = FileBuffer::MakeView(data.data(), data.size());
+    auto indices = std::vector<const File::ChunkIndex*>(8, nullptr);
+    {
+        auto threads = std::vector<std::jthread>{};
+        for (unsigned i = 0; i < indices.size(); i++)
+        {
+            threads.emplace_back([&fb, &indices, i]{
+                indices[i] = &fb.GetChunkIndex();
+            });
+        }
+    }
+
+    for (const auto* index : indices)
+    {
+        EXPECT_EQ(index, &fb.GetChunkIndex());
+    }
+}
+
+}
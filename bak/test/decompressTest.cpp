@@ -0,0 +1,362 @@
+#include "gtest/gtest.h"
+
+#include "bak/file/decompress.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace BAK {
+
+namespace {
+
+std::vector<std::uint8_t> PackCodes(const std::vector<unsigned>& codes, unsigned bits)
+{
+    auto data = std::vector<std::uint8_t>((codes.size() * bits + 7) / 8);
+    unsigned position = 0;
+    for (const auto code : codes)
+    {
+        for (unsigned i = 0; i < bits; i++, position++)
+        {
+            if (code & (1 << i))
+            {
+                data[position / 8] |= 1 << (position % 8);
+            }
+        }
+    }
+    return data;
+}
+
+std::string ToString(const std::vector<std::uint8_t>& data)
+{
+    return std::string{data.begin(), data.end()};
+}
+
+// LSB first, as the decoders read
+class BitWriter
+{
+public:
+    explicit BitWriter(unsigned startBit)
+    :
+        mData((startBit + 7) / 8),
+        mPosition{startBit}
+    {}
+
+    void PutBits(unsigned value, unsigned bits)
+    {
+        for (unsigned i = 0; i < bits; i++, mPosition++)
+        {
+            if (mPosition / 8 >= mData.size())
+            {
+                mData.emplace_back(0);
+            }
+            if (value & (1u << i))
+            {
+                mData[mPosition / 8] |= 1 << (mPosition % 8);
+            }
+        }
+    }
+
+    std::vector<std::uint8_t> Get() const { return mData; }
+
+private:
+    std::vector<std::uint8_t> mData;
+    unsigned mPosition;
+};
+
+// Encoders for the test data. They do not use clear codes or find the
+// best matches, they only have to produce streams the decoders accept.
+
+std::vector<std::uint8_t> EncodeLZW(const std::vector<std::uint8_t>& data, unsigned startBit)
+{
+    auto bits = BitWriter{startBit};
+    auto table = std::map<std::pair<unsigned, std::uint8_t>, unsigned>{};
+    // Code widths grow as the decoder's table does, which lags one code
+    // behind the table here
+    unsigned nBits = 9;
+    unsigned decoderFree = 257;
+    unsigned nextEntry = 257;
+    bool first = true;
+
+    const auto emit = [&](unsigned code)
+    {
+        bits.PutBits(code, nBits);
+        if (first)
+        {
+            first = false;
+            return;
+        }
+        if (decoderFree < 4096)
+        {
+            decoderFree++;
+            if (decoderFree >= (1u << nBits) && nBits < 12)
+            {
+                nBits++;
+            }
+        }
+    };
+
+    unsigned prefix = data[0];
+    for (std::size_t i = 1; i < data.size(); i++)
+    {
+        const auto it = table.find({prefix, data[i]});
+        if (it != table.end())
+        {
+            prefix = it->second;
+            continue;
+        }
+        emit(prefix);
+        if (nextEntry < 4096)
+        {
+            table.emplace(std::make_pair(prefix, data[i]), nextEntry++);
+        }
+        prefix = data[i];
+    }
+    emit(prefix);
+    return bits.Get();
+}
+
+std::vector<std::uint8_t> EncodeLZSS(const std::vector<std::uint8_t>& data)
+{
+    static constexpr std::size_t sMinLength = 5;
+    static constexpr std::size_t sMaxLength = 255 + sMinLength;
+    static constexpr std::size_t sWindow = 1024;
+
+    auto encoded = std::vector<std::uint8_t>{};
+    std::size_t codePos = 0;
+    std::uint8_t mask = 0;
+    std::size_t pos = 0;
+    while (pos < data.size())
+    {
+        if (!mask)
+        {
+            codePos = encoded.size();
+            encoded.emplace_back(0);
+            mask = 0x01;
+        }
+
+        // Longest match, which may overlap the bytes it produces
+        std::size_t bestOffset = 0;
+        std::size_t bestLength = 0;
+        for (std::size_t off = pos > sWindow ? pos - sWindow : 0; off < pos; off++)
+        {
+            std::size_t length = 0;
+            while (length < sMaxLength
+                && pos + length < data.size()
+                && data[off + length] == data[pos + length])
+            {
+                length++;
+            }
+            if (length > bestLength)
+            {
+                bestOffset = off;
+                bestLength = length;
+            }
+        }
+
+        if (bestLength >= sMinLength)
+        {
+            encoded.emplace_back(bestOffset & 0xff);
+            encoded.emplace_back(bestOffset >> 8);
+            encoded.emplace_back(bestLength - sMinLength);
+            pos += bestLength;
+        }
+        else
+        {
+            encoded[codePos] |= mask;
+            encoded.emplace_back(data[pos++]);
+        }
+        mask <<= 1;
+    }
+    return encoded;
+}
+
+std::vector<std::uint8_t> EncodeRLE(const std::vector<std::uint8_t>& data)
+{
+    static constexpr std::size_t sMaxCount = 0x7f;
+
+    auto encoded = std::vector<std::uint8_t>{};
+    std::size_t pos = 0;
+    while (pos < data.size())
+    {
+        std::size_t run = 1;
+        while (run < sMaxCount && pos + run < data.size() && data[pos + run] == data[pos])
+        {
+            run++;
+        }
+
+        if (run >= 3)
+        {
+            encoded.emplace_back(0x80 | run);
+            encoded.emplace_back(data[pos]);
+            pos += run;
+            continue;
+        }
+
+        // Literals up to the next run of three
+        std::size_t count = 0;
+        while (count < sMaxCount && pos + count < data.size()
+            && !(pos + count + 2 < data.size()
+                && data[pos + count] == data[pos + count + 1]
+                && data[pos + count] == data[pos + count + 2]))
+        {
+            count++;
+        }
+        count = std::max<std::size_t>(count, 1);
+        encoded.emplace_back(count);
+        encoded.insert(encoded.end(), data.begin() + pos, data.begin() + pos + count);
+        pos += count;
+    }
+    return encoded;
+}
+
+// Runs and repeated phrases from a small alphabet, like image data
+std::vector<std::uint8_t> MakeRandomData(std::mt19937& rng, std::size_t size)
+{
+    auto symbol = std::uniform_int_distribution<unsigned>{0, 15};
+    auto choice = std::uniform_int_distribution<unsigned>{0, 3};
+    auto length = std::uniform_int_distribution<std::size_t>{1, 300};
+
+    auto data = std::vector<std::uint8_t>{};
+    while (data.size() < size)
+    {
+        const auto n = std::min(length(rng), size - data.size());
+        switch (choice(rng))
+        {
+        case 0:
+            data.insert(data.end(), n, symbol(rng) * 16);
+            break;
+        case 1:
+            if (!data.empty())
+            {
+                const auto start = std::uniform_int_distribution<std::size_t>{
+                    0, data.size() - 1}(rng);
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    data.emplace_back(data[start + i]);
+                }
+                break;
+            }
+            [[fallthrough]];
+        default:
+            for (std::size_t i = 0; i < n; i++)
+            {
+                data.emplace_back(symbol(rng) + (choice(rng) == 0 ? 200 : 0));
+            }
+        }
+    }
+    return data;
+}
+
+std::vector<std::size_t> GetRandomSizes()
+{
+    // Past 4096 codes the LZW table is full, and past 64KB LZSS offsets
+    // no longer fit
+    return {1, 2, 7, 100, 1000, 5000, 20000, 60000};
+}
+
+}
+
+TEST(DecompressTest, LZWDecodesTableAndRepeatedStrings)
+{
+    // A, B, AB (table entry 257) then 259 which is not yet in the table
+    const auto input = PackCodes({'A', 'B', 257, 259}, 9);
+    auto output = std::vector<std::uint8_t>(7);
+
+    const auto result = File::DecompressLZW(input, 0, output);
+
+    EXPECT_EQ(result.mOutputBytes, 7u);
+    EXPECT_EQ(ToString(output), "ABABABA");
+}
+
+TEST(DecompressTest, LZWThrowsWhenOutputOverflows)
+{
+    const auto input = PackCodes({'A', 'B', 257, 259}, 9);
+    auto output = std::vector<std::uint8_t>(5);
+
+    EXPECT_THROW(File::DecompressLZW(input, 0, output), std::runtime_error);
+}
+
+TEST(DecompressTest, LZSSCopiesOverlappingBackReferences)
+{
+    // Two literals followed by a back reference to offset 0 of length 8
+    const auto input = std::vector<std::uint8_t>{
+        0b011, 'x', 'y', 0, 0, 3};
+    auto output = std::vector<std::uint8_t>(10);
+
+    const auto result = File::DecompressLZSS(input, output);
+
+    EXPECT_EQ(result.mInputBytes, input.size());
+    EXPECT_EQ(result.mOutputBytes, 10u);
+    EXPECT_EQ(ToString(output), "xyxyxyxyxy");
+}
+
+TEST(DecompressTest, RLEExpandsRunsAndLiterals)
+{
+    const auto input = std::vector<std::uint8_t>{
+        0x83, 'a', 0x02, 'b', 'c', 0x81, 'd'};
+    auto output = std::vector<std::uint8_t>(6);
+
+    const auto result = File::DecompressRLE(input, output);
+
+    EXPECT_EQ(result.mInputBytes, input.size());
+    EXPECT_EQ(result.mOutputBytes, 6u);
+    EXPECT_EQ(ToString(output), "aaabcd");
+}
+
+TEST(DecompressTest, LZWRoundTripsRandomData)
+{
+    auto rng = std::mt19937{3};
+    for (const auto size : GetRandomSizes())
+    {
+        for (const unsigned startBit : {0u, 3u})
+        {
+            const auto data = MakeRandomData(rng, size);
+            const auto input = EncodeLZW(data, startBit);
+            auto output = std::vector<std::uint8_t>(data.size());
+
+            const auto result = File::DecompressLZW(input, startBit, output);
+
+            EXPECT_EQ(result.mOutputBytes, data.size()) << size;
+            EXPECT_EQ(output, data) << size << " bit: " << startBit;
+        }
+    }
+}
+
+TEST(DecompressTest, LZSSRoundTripsRandomData)
+{
+    auto rng = std::mt19937{4};
+    for (const auto size : GetRandomSizes())
+    {
+        const auto data = MakeRandomData(rng, size);
+        const auto input = EncodeLZSS(data);
+        auto output = std::vector<std::uint8_t>(data.size());
+
+        const auto result = File::DecompressLZSS(input, output);
+
+        EXPECT_EQ(result.mInputBytes, input.size()) << size;
+        EXPECT_EQ(result.mOutputBytes, data.size()) << size;
+        EXPECT_EQ(output, data) << size;
+    }
+}
+
+TEST(DecompressTest, RLERoundTripsRandomData)
+{
+    auto rng = std::mt19937{5};
+    for (const auto size : GetRandomSizes())
+    {
+        const auto data = MakeRandomData(rng, size);
+        const auto input = EncodeRLE(data);
+        auto output = std::vector<std::uint8_t>(data.size());
+
+        const auto result = File::DecompressRLE(input, output);
+
+        EXPECT_EQ(result.mInputBytes, input.size()) << size;
+        EXPECT_EQ(result.mOutputBytes, data.size()) << size;
+        EXPECT_EQ(output, data) << size;
+    }
+}
+
+}
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+
+#include "bak/file/incrementalFileWriter.hpp"
+
+#include "bak/test/tempDirectory.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace BAK::File {
+
+struct IncrementalFileWriterFixture : public TempDirectoryFixture
+{
+    IncrementalFileWriterFixture()
+    :
+        mPath{(mDirectory / "SAVE01.GAM").string()},
+        mContents(IncrementalFileWriter::sPageSize * 4 + 100)
+    {
+        for (unsigned i = 0; i < mContents.size(); i++)
+        {
+            mContents[i] = i % 251;
+        }
+    }
+
+    std::string mPath;
+    std::vector<std::uint8_t> mContents;
+};
+
+TEST_F(IncrementalFileWriterFixture, WritesOnlyChangedPages)
+{
+    auto writer = IncrementalFileWriter{};
+    EXPECT_EQ(writer.Write(mPath, mContents), mContents.size());
+    EXPECT_EQ(ReadFile(mPath), mContents);
+
+    mContents[IncrementalFileWriter::sPageSize + 10] ^= 0xff;
+    EXPECT_EQ(writer.Write(mPath, mContents), IncrementalFileWriter::sPageSize);
+    EXPECT_EQ(ReadFile(mPath), mContents);
+
+    // Adjacent pages are written together, the short last page is included
+    mContents[IncrementalFileWriter::sPageSize * 3] ^= 0xff;
+    mContents.back() ^= 0xff;
+    EXPECT_EQ(writer.Write(mPath, mContents), IncrementalFileWriter::sPageSize + 100);
+    EXPECT_EQ(ReadFile(mPath), mContents);
+
+    mContents.resize(100);
+    EXPECT_EQ(writer.Write(mPath, mContents), mContents.size());
+    EXPECT_EQ(ReadFile(mPath), mContents);
+    EXPECT_FALSE(std::filesystem::exists(mPath + ".tmp"));
+}
+
+TEST_F(IncrementalFileWriterFixture, LeavesUnchangedFileAlone)
+{
+    auto writer = IncrementalFileWriter{};
+    writer.Write(mPath, mContents);
+
+    const auto modified = std::filesystem::last_write_time(mPath);
+    EXPECT_EQ(writer.Write(mPath, mContents), 0u);
+    EXPECT_EQ(std::filesystem::last_write_time(mPath), modified);
+    EXPECT_FALSE(std::filesystem::exists(mPath + ".tmp"));
+}
+
+TEST_F(IncrementalFileWriterFixture, WritesEverythingWhenFileChangedElsewhere)
+{
+    auto writer = IncrementalFileWriter{};
+    writer.Write(mPath, mContents);
+
+    const auto modified = std::filesystem::last_write_time(mPath);
+    {
+        auto out = std::fstream{mPath, std::ios::binary | std::ios::in | std::ios::out};
+        out.put(42);
+    }
+    std::filesystem::last_write_time(mPath, modified + std::chrono::seconds{1});
+
+    // Even though the contents are the same as were last written
+    EXPECT_EQ(writer.Write(mPath, mContents), mContents.size());
+    EXPECT_EQ(ReadFile(mPath), mContents);
+}
+
+TEST_F(IncrementalFileWriterFixture, WritesFromBase)
+{
+    {
+        auto out = std::ofstream{mPath, std::ios::binary};
+        out.write(reinterpret_cast<const char*>(mContents.data()), mContents.size());
+    }
+
+    auto writer = IncrementalFileWriter{};
+    writer.SetBase(mPath, mContents);
+    EXPECT_EQ(writer.Write(mPath, mContents), 0u);
+
+    mContents[0] ^= 0xff;
+    EXPECT_EQ(writer.Write(mPath, mContents), IncrementalFileWriter::sPageSize);
+    EXPECT_EQ(ReadFile(mPath), mContents);
+
+    const auto otherPath = (mDirectory / "SAVE02.GAM").string();
+    EXPECT_EQ(writer.Write(otherPath, mContents), mContents.size());
+    EXPECT_EQ(ReadFile(otherPath), mContents);
+}
+
+}
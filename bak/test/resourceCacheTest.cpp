@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+
+#include "bak/dataTags.hpp"
+#include "bak/palette.hpp"
+#include "bak/resourceCache.hpp"
+
+#include "bak/test/tempDirectory.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace BAK {
+
+namespace {
+
+// Size the cache counts for a colour swap
+static constexpr auto sColorSwapBytes = ColorSwap::sSize * sizeof(unsigned);
+
+}
+
+struct ResourceCacheFixture : public TempDirectoryFixture
+{
+    ResourceCacheFixture()
+    :
+        mCache{ResourceCache::Get()}
+    {
+        mCache.Clear();
+        mCache.SetBudget(ResourceCache::sDefaultBudget);
+    }
+
+    ~ResourceCacheFixture()
+    {
+        mCache.Clear();
+        mCache.SetBudget(ResourceCache::sDefaultBudget);
+    }
+
+    // Data files are found by absolute path, so the cache loads these
+    // rather than anything from the game data
+    std::string WriteFile(const std::string& name, const std::vector<std::uint8_t>& data)
+    {
+        const auto path = mDirectory / name;
+        auto out = std::ofstream{path, std::ios::binary};
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+        return path.string();
+    }
+
+    std::string WriteColorSwap(const std::string& name, std::uint8_t offset)
+    {
+        auto data = std::vector<std::uint8_t>(ColorSwap::sSize);
+        for (unsigned i = 0; i < data.size(); i++)
+        {
+            data[i] = (i + offset) % ColorSwap::sSize;
+        }
+        return WriteFile(name, data);
+    }
+
+    std::string WritePalette(const std::string& name)
+    {
+        const auto tag = static_cast<std::uint32_t>(DataTag::VGA);
+        const auto size = std::uint32_t{256 * 3};
+        auto data = std::vector<std::uint8_t>(8);
+        std::memcpy(data.data(), &tag, 4);
+        std::memcpy(data.data() + 4, &size, 4);
+        for (unsigned i = 0; i < size; i++)
+        {
+            // Stored as 6 bit colours
+            data.emplace_back((i / 3) % 64);
+        }
+        return WriteFile(name, data);
+    }
+
+    ResourceCache& mCache;
+};
+
+TEST_F(ResourceCacheFixture, CountsHitsAndMisses)
+{
+    const auto path = WriteColorSwap("A.CS", 1);
+    const auto before = mCache.GetStats();
+
+    const auto first = mCache.GetColorSwap(path);
+    auto stats = mCache.GetStats();
+    EXPECT_EQ(stats.mMisses - before.mMisses, 1u);
+    EXPECT_EQ(stats.mHits - before.mHits, 0u);
+    EXPECT_EQ(stats.mBytes, sColorSwapBytes);
+
+    const auto second = mCache.GetColorSwap(path);
+    stats = mCache.GetStats();
+    EXPECT_EQ(stats.mMisses - before.mMisses, 1u);
+    EXPECT_EQ(stats.mHits - before.mHits, 1u);
+    EXPECT_EQ(first.get(), second.get());
+}
+
+TEST_F(ResourceCacheFixture, SharesPalettesAndSwappedPalettes)
+{
+    const auto palette = WritePalette("A.PAL");
+    const auto colorSwap = WriteColorSwap("A.CS", 1);
+
+    const auto first = mCache.GetPalette(palette);
+    EXPECT_EQ(mCache.GetPalette(palette).get(), first.get());
+    EXPECT_EQ(first->GetColor8(2), (glm::u8vec4{8, 8, 8, 255}));
+
+    // Loads the swap, and finds the palette already loaded
+    const auto before = mCache.GetStats();
+    const auto swapped = mCache.GetPalette(palette, colorSwap);
+    auto stats = mCache.GetStats();
+    EXPECT_EQ(stats.mMisses - before.mMisses, 2u);
+    EXPECT_EQ(stats.mHits - before.mHits, 1u);
+    EXPECT_EQ(swapped->GetColor8(1), first->GetColor8(2));
+
+    EXPECT_EQ(mCache.GetPalette(palette, colorSwap).get(), swapped.get());
+}
+
+TEST_F(ResourceCacheFixture, EvictsLeastRecentlyUsedOverBudget)
+{
+    const auto a = WriteColorSwap("A.CS", 1);
+    const auto b = WriteColorSwap("B.CS", 2);
+    const auto c = WriteColorSwap("C.CS", 3);
+
+    mCache.SetBudget(2 * sColorSwapBytes);
+    mCache.GetColorSwap(a);
+    mCache.GetColorSwap(b);
+    // a is now used more recently than b
+    mCache.GetColorSwap(a);
+
+    const auto before = mCache.GetStats();
+    mCache.GetColorSwap(c);
+    auto stats = mCache.GetStats();
+    EXPECT_EQ(stats.mEvictions - before.mEvictions, 1u);
+    EXPECT_EQ(stats.mBytes, 2 * sColorSwapBytes);
+
+    mCache.GetColorSwap(a);
+    mCache.GetColorSwap(c);
+    EXPECT_EQ(mCache.GetStats().mHits - stats.mHits, 2u);
+
+    mCache.GetColorSwap(b);
+    EXPECT_EQ(mCache.GetStats().mMisses - stats.mMisses, 1u);
+}
+
+TEST_F(ResourceCacheFixture, KeepsResourcesThatAreHeld)
+{
+    const auto a = WriteColorSwap("A.CS", 1);
+    const auto b = WriteColorSwap("B.CS", 2);
+
+    auto held = mCache.GetColorSwap(a);
+    mCache.GetColorSwap(b);
+
+    const auto before = mCache.GetStats();
+    mCache.SetBudget(0);
+    auto stats = mCache.GetStats();
+    EXPECT_EQ(stats.mEvictions - before.mEvictions, 1u);
+    EXPECT_EQ(stats.mBytes, sColorSwapBytes);
+
+    EXPECT_EQ(mCache.GetColorSwap(a).get(), held.get());
+
+    held.reset();
+    mCache.SetBudget(0);
+    stats = mCache.GetStats();
+    EXPECT_EQ(stats.mEvictions - before.mEvictions, 2u);
+    EXPECT_EQ(stats.mBytes, 0u);
+}
+
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+
+#include "bak/saveManager.hpp"
+
+#include "bak/test/tempDirectory.hpp"
+
+#include "com/path.hpp"
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace BAK {
+
+struct SaveManagerFixture : public TempDirectoryFixture
+{
+    SaveManagerFixture()
+    :
+        mPreviousBakDirectory{Paths::Get().GetBakDirectory()},
+        mBakDirectory{mDirectory}
+    {
+        std::filesystem::create_directories(mBakDirectory / "GAMES");
+        Paths::Get().SetBakDirectory(mBakDirectory.string());
+    }
+
+    ~SaveManagerFixture()
+    {
+        Paths::Get().SetBakDirectory(mPreviousBakDirectory);
+    }
+
+    // Only the header that the save manager reads, followed by some padding
+    std::filesystem::path WriteSave(
+        const std::string& directory,
+        const std::string& file,
+        const std::string& name,
+        std::uint8_t chapter)
+    {
+        std::array<char, 0x100> data{};
+        name.copy(data.data(), name.size());
+        data[0x5a] = chapter;
+        data[0x64] = chapter;
+
+        const auto path = mBakDirectory / "GAMES" / directory / file;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream out{path, std::ios::binary};
+        out.write(data.data(), data.size());
+        return path;
+    }
+
+    std::string mPreviousBakDirectory;
+    std::filesystem::path mBakDirectory;
+};
+
+TEST_F(SaveManagerFixture, ScansEveryDirectory)
+{
+    WriteSave("FIRST.G01", "SAVE01.GAM", "Start", 1);
+    WriteSave("FIRST.G01", "SAVE02.GAM", "Later", 3);
+    WriteSave("SECOND.G02", "SAVE00.GAM", "Ignored", 2);
+    WriteSave("SECOND.G02", "SAVE01.GAM", "Other", 2);
+    std::ofstream{mBakDirectory / "GAMES" / "SECOND.G02" / "SAVE21.GAM"};
+
+    auto saveManager = SaveManager{mBakDirectory.string()};
+    saveManager.RefreshSaves();
+
+    const auto& saves = saveManager.GetSaves();
+    ASSERT_EQ(saves.size(), 2u);
+
+    EXPECT_EQ(saves[0].mName, "FIRST");
+    EXPECT_FALSE(saves[0].mGameCompleted);
+    ASSERT_EQ(saves[0].mSaves.size(), 2u);
+    EXPECT_EQ(saves[0].mSaves[0].mName, "Start");
+    EXPECT_EQ(saves[0].mSaves[0].mChapter, 1u);
+    EXPECT_EQ(saves[0].mSaves[1].mName, "Later");
+    EXPECT_EQ(saves[0].mSaves[1].mChapter, 3u);
+
+    EXPECT_EQ(saves[1].mName, "SECOND");
+    EXPECT_TRUE(saves[1].mGameCompleted);
+    ASSERT_EQ(saves[1].mSaves.size(), 2u);
+    EXPECT_EQ(saves[1].mSaves[0].mName, "Bookmark");
+    EXPECT_EQ(saves[1].mSaves[0].mChapter, 2u);
+    EXPECT_EQ(saves[1].mSaves[1].mName, "Other");
+}
+
+TEST_F(SaveManagerFixture, RefreshRereadsChangedSaves)
+{
+    const auto path = WriteSave("FIRST.G01", "SAVE01.GAM", "Before", 1);
+
+    auto saveManager = SaveManager{mBakDirectory.string()};
+    saveManager.RefreshSaves();
+    ASSERT_EQ(saveManager.GetSaves().at(0).mSaves.at(0).mName, "Before");
+
+    const auto modified = std::filesystem::last_write_time(path);
+    WriteSave("FIRST.G01", "SAVE01.GAM", "After", 4);
+    std::filesystem::last_write_time(path, modified + std::chrono::seconds{1});
+    saveManager.RefreshSaves();
+
+    const auto& save = saveManager.GetSaves().at(0).mSaves.at(0);
+    EXPECT_EQ(save.mName, "After");
+    EXPECT_EQ(save.mChapter, 4u);
+}
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace BAK {
+
+// Base fixture for tests that write files. Each test gets an empty
+// directory named after the test with a random suffix, so that test
+// processes can run in parallel, which is removed again after the test.
+struct TempDirectoryFixture : public ::testing::Test
+{
+    TempDirectoryFixture()
+    :
+        mDirectory{MakeDirectoryName()}
+    {
+        std::filesystem::remove_all(mDirectory);
+        std::filesystem::create_directories(mDirectory);
+    }
+
+    ~TempDirectoryFixture()
+    {
+        auto error = std::error_code{};
+        std::filesystem::remove_all(mDirectory, error);
+    }
+
+    std::filesystem::path mDirectory;
+
+private:
+    static std::filesystem::path MakeDirectoryName()
+    {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        auto name = std::string{info->test_suite_name()} + "." + info->name()
+            + "." + MakeUniqueSuffix();
+        // Parameterised tests have a '/' in their name
+        std::replace(name.begin(), name.end(), '/', '_');
+        return std::filesystem::temp_directory_path() / "bakTest" / name;
+    }
+
+    // Some standard libraries have a deterministic random_device, so the
+    // time is mixed in as well
+    static std::string MakeUniqueSuffix()
+    {
+        const auto now = static_cast<std::uint64_t>(
+            std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        auto device = std::random_device{};
+        const auto random = (std::uint64_t{device()} << 32) | device();
+        auto ss = std::stringstream{};
+        ss << std::hex << (now ^ random);
+        return ss.str();
+    }
+};
+
+inline std::vector<std::uint8_t> ReadFile(const std::filesystem::path& path)
+{
+    auto in = std::ifstream{path, std::ios::binary};
+    return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+}
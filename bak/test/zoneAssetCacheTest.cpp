@@ -0,0 +1,233 @@
+#include "gtest/gtest.h"
+
+#include "bak/resourceNames.hpp"
+#include "bak/zoneAssetCache.hpp"
+
+#include "bak/test/tempDirectory.hpp"
+
+#include "com/path.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace BAK {
+
+namespace {
+
+// Where the fields sit in the cache file's header
+static constexpr auto sVersionOffset = 4;
+static constexpr auto sSourceHashOffset = 8;
+
+Graphics::Texture MakeTexture(unsigned width, unsigned height, std::uint8_t seed)
+{
+    auto pixels = Graphics::Texture::TextureType{};
+    for (unsigned i = 0; i < width * height; i++)
+    {
+        pixels.emplace_back(
+            static_cast<std::uint8_t>(i + seed),
+            static_cast<std::uint8_t>(i * 3),
+            seed,
+            255);
+    }
+    return Graphics::Texture{std::move(pixels), width, height, width * 2, height * 2};
+}
+
+Graphics::MeshObject MakeMesh(unsigned triangles, float offset)
+{
+    auto vertices = std::vector<Graphics::Vertex>{};
+    auto indices = std::vector<unsigned>{};
+    for (unsigned i = 0; i < triangles * 3; i++)
+    {
+        vertices.emplace_back(Graphics::PackVertex(
+            glm::vec3{offset + i, offset * i, -1.0f * i},
+            glm::vec3{0, 1, 0},
+            glm::vec4{0.5, 0.25, 1, 1},
+            glm::vec3{i % 4, i % 2, i % 3},
+            (i % 2) ? 1.0f : 0.0f));
+        indices.emplace_back(i);
+    }
+    return Graphics::MeshObject{std::move(vertices), std::move(indices)};
+}
+
+}
+
+struct ZoneAssetCacheFixture : public TempDirectoryFixture
+{
+    ZoneAssetCacheFixture()
+    :
+        mZoneLabel{1},
+        mCacheDirectory{mDirectory / "cache"},
+        mModDirectory{mDirectory / "mod"},
+        mPreviousModDirectory{Paths::Get().GetModDirectory()}
+    {
+        std::filesystem::create_directories(mModDirectory);
+        Paths::Get().SetModDirectory(mModDirectory.string());
+    }
+
+    ~ZoneAssetCacheFixture()
+    {
+        Paths::Get().SetModDirectory(mPreviousModDirectory);
+    }
+
+    ZoneAssetCache MakeCache() const
+    {
+        return ZoneAssetCache{mCacheDirectory, mZoneLabel};
+    }
+
+    std::filesystem::path GetCachePath() const
+    {
+        return mCacheDirectory / (mZoneLabel.GetZone() + ".ZAC");
+    }
+
+    ZoneTextures MakeTextures() const
+    {
+        auto textures = ZoneTextures{{}, 1, 2};
+        textures.mTextures.emplace_back(MakeTexture(4, 2, 1));
+        textures.mTextures.emplace_back(MakeTexture(3, 5, 7));
+        textures.mTextures.back().SetRepeat(false);
+        textures.mTextures.emplace_back(MakeTexture(8, 8, 9));
+        return textures;
+    }
+
+    Graphics::MeshObjectStorage MakeObjects() const
+    {
+        auto builder = Graphics::MeshObjectStorageBuilder{};
+        builder.AddObject("tree", MakeMesh(3, 0.5f));
+        builder.AddObject("house", MakeMesh(5, 2.0f));
+        builder.AddObject("rock", MakeMesh(1, 8.0f));
+        return std::move(builder).Build();
+    }
+
+    void WriteModFile(const std::string& name, const std::string& contents) const
+    {
+        auto out = std::ofstream{mModDirectory / name, std::ios::binary};
+        out << contents;
+    }
+
+    template <typename T>
+    void OverwriteCacheField(std::size_t offset, T value) const
+    {
+        auto data = ReadFile(GetCachePath());
+        ASSERT_GE(data.size(), offset + sizeof(T));
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+        auto out = std::ofstream{GetCachePath(), std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    ZoneLabel mZoneLabel;
+    std::filesystem::path mCacheDirectory;
+    std::filesystem::path mModDirectory;
+    std::string mPreviousModDirectory;
+};
+
+TEST_F(ZoneAssetCacheFixture, LoadsWhatWasSaved)
+{
+    const auto cache = MakeCache();
+    ASSERT_TRUE(cache.IsEnabled());
+    EXPECT_FALSE(cache.Load());
+
+    const auto textures = MakeTextures();
+    const auto objects = MakeObjects();
+    cache.Save(textures, objects);
+
+    const auto assets = MakeCache().Load();
+    ASSERT_TRUE(assets);
+
+    EXPECT_EQ(assets->mTextures.mTerrainOffset, textures.mTerrainOffset);
+    EXPECT_EQ(assets->mTextures.mHorizonOffset, textures.mHorizonOffset);
+    ASSERT_EQ(assets->mTextures.mTextures.size(), textures.mTextures.size());
+    for (unsigned i = 0; i < textures.mTextures.size(); i++)
+    {
+        const auto& loaded = assets->mTextures.mTextures[i];
+        const auto& expected = textures.mTextures[i];
+        EXPECT_EQ(loaded.GetWidth(), expected.GetWidth());
+        EXPECT_EQ(loaded.GetHeight(), expected.GetHeight());
+        EXPECT_EQ(loaded.GetTargetWidth(), expected.GetTargetWidth());
+        EXPECT_EQ(loaded.GetTargetHeight(), expected.GetTargetHeight());
+        EXPECT_EQ(loaded.GetRepeat(), expected.GetRepeat());
+        EXPECT_EQ(loaded.GetTexture(), expected.GetTexture());
+    }
+
+    EXPECT_EQ(assets->mObjects.GetObjects(), objects.GetObjects());
+    EXPECT_EQ(assets->mObjects.GetVertices(), objects.GetVertices());
+    EXPECT_EQ(assets->mObjects.GetIndices(), objects.GetIndices());
+}
+
+TEST_F(ZoneAssetCacheFixture, IgnoresOtherVersion)
+{
+    MakeCache().Save(MakeTextures(), MakeObjects());
+    ASSERT_TRUE(MakeCache().Load());
+
+    OverwriteCacheField(sVersionOffset, ZoneAssetCache::sVersion + 1);
+    EXPECT_FALSE(MakeCache().Load());
+}
+
+TEST_F(ZoneAssetCacheFixture, IgnoresOtherSourceHash)
+{
+    MakeCache().Save(MakeTextures(), MakeObjects());
+    const auto data = ReadFile(GetCachePath());
+    auto hash = std::uint64_t{};
+    ASSERT_GE(data.size(), sSourceHashOffset + sizeof(hash));
+    std::memcpy(&hash, data.data() + sSourceHashOffset, sizeof(hash));
+
+    OverwriteCacheField(sSourceHashOffset, hash + 1);
+    EXPECT_FALSE(MakeCache().Load());
+}
+
+TEST_F(ZoneAssetCacheFixture, TruncatedFileIsNotLoaded)
+{
+    MakeCache().Save(MakeTextures(), MakeObjects());
+    const auto size = std::filesystem::file_size(GetCachePath());
+
+    // Cut off within the header, the records, and the arrays
+    for (const auto newSize : {std::uintmax_t{6}, std::uintmax_t{60}, size / 2, size - 1})
+    {
+        std::filesystem::resize_file(GetCachePath(), newSize);
+        std::optional<ZoneAssets> assets{};
+        EXPECT_NO_THROW(assets = MakeCache().Load()) << newSize;
+        EXPECT_FALSE(assets) << newSize;
+    }
+}
+
+TEST_F(ZoneAssetCacheFixture, ChangingModDirectoryInvalidates)
+{
+    WriteModFile("Z01SLOT0.BMX", "sprite");
+    MakeCache().Save(MakeTextures(), MakeObjects());
+    ASSERT_TRUE(MakeCache().Load());
+
+    // Same name, size and contents, only the modification time differs
+    const auto otherModDirectory = mDirectory / "otherMod";
+    std::filesystem::create_directories(otherModDirectory);
+    const auto modFile = mModDirectory / "Z01SLOT0.BMX";
+    const auto otherModFile = otherModDirectory / "Z01SLOT0.BMX";
+    std::filesystem::copy_file(modFile, otherModFile);
+    std::filesystem::last_write_time(
+        otherModFile,
+        std::filesystem::last_write_time(modFile) + std::chrono::seconds{10});
+
+    Paths::Get().SetModDirectory(otherModDirectory.string());
+    EXPECT_FALSE(MakeCache().Load());
+
+    MakeCache().Save(MakeTextures(), MakeObjects());
+    ASSERT_TRUE(MakeCache().Load());
+
+    Paths::Get().SetModDirectory(mModDirectory.string());
+    EXPECT_FALSE(MakeCache().Load());
+}
+
+TEST_F(ZoneAssetCacheFixture, ModDirectoryIsListedOncePerSession)
+{
+    WriteModFile("Z01SLOT0.BMX", "sprite");
+    MakeCache().Save(MakeTextures(), MakeObjects());
+    ASSERT_TRUE(MakeCache().Load());
+
+    WriteModFile("Z01SLOT1.BMX", "another sprite");
+    EXPECT_TRUE(MakeCache().Load());
+}
+
+}
@@ -1,10 +1,8 @@
 #include "bak/textureFactory.hpp"
 
 #include "bak/image.hpp"
-#include "bak/imageStore.hpp"
 #include "bak/palette.hpp"
-#include "bak/screen.hpp"
-#include "bak/fileBufferFactory.hpp"
+#include "bak/resourceCache.hpp"
 
 #include "com/logger.hpp"
 #include "com/png.hpp"
@@ -17,6 +15,7 @@
 #include <filesystem>
 #include <string>
 #include <random>
+#include <utility>
 
 namespace BAK {
 
@@ -30,11 +29,11 @@ Graphics::Texture ImageToTexture(const Image& image, const Palette& palette)
 
     for (unsigned i = 0; i < imageSize; i++)
     {
-        texture.push_back(palette.GetColor(pixels[i]));
+        texture.push_back(palette.GetColor8(pixels[i]));
     }
 
     auto tex = Graphics::Texture{
-        texture,
+        std::move(texture),
         static_cast<unsigned>(image.GetWidth()),
         static_cast<unsigned>(image.GetHeight()),
         static_cast<unsigned>(image.GetWidth()),
@@ -56,18 +55,17 @@ Graphics::Texture PNGToTexture(std::string path, unsigned targetWidth, unsigned
     };
 
     auto texture = Graphics::Texture::TextureType{};
+    texture.reserve(width * height);
 
     for (int y = height - 1; y >= 0; y--)
     {
         for (int x = 0; x < (int) width; x++)
         {
             auto c = Get(x, y);
-            const auto F = [](auto x){
-                return static_cast<float>(x) / 255.; };
-            texture.push_back(glm::vec4{F(c.r), F(c.g), F(c.b), F(c.a)});
+            texture.emplace_back(c.r, c.g, c.b, c.a);
         }
     }
-    return Graphics::Texture{texture, width, height, targetWidth, targetHeight};
+    return Graphics::Texture{std::move(texture), width, height, targetWidth, targetHeight};
 }
 
 Graphics::TextureStore TextureFactory::MakeTextureStore(
@@ -84,11 +82,9 @@ void TextureFactory::AddToTextureStore(
     std::string_view bmx,
     std::string_view pal)
 {
-    const auto palette = Palette{std::string{pal}};
-
-    auto fb = FileBufferFactory::Get()
-        .CreateDataBuffer(std::string{bmx});
-    const auto images = LoadImages(fb);
+    const auto palette = ResourceCache::Get().GetPalette(std::string{pal});
+    const auto imagesPtr = ResourceCache::Get().GetImages(std::string{bmx});
+    const auto& images = *imagesPtr;
 
     auto baseName = SplitString(".", std::string(bmx))[0];
     auto substitute = images.size() > 1
@@ -119,13 +115,13 @@ void TextureFactory::AddToTextureStore(
             }
             else
             {
-                AddToTextureStore(store, images[i], palette);
+                AddToTextureStore(store, images[i], *palette);
             }
         }
     }
     else
     {
-        AddToTextureStore(store, images, palette);
+        AddToTextureStore(store, images, *palette);
     }
 }
 
@@ -139,18 +135,16 @@ void TextureFactory::AddScreenToTextureStore(
 
     if (std::filesystem::exists(substitute))
     {
-        auto fb = FileBufferFactory::Get()
-            .CreateDataBuffer(std::string{scx});
-        auto target = LoadScreenResource(fb);
+        const auto target = ResourceCache::Get().GetScreen(std::string{scx});
         Logging::LogDebug(__FUNCTION__) << "Found substitute SCX: " << substitute << "\n";
-        store.AddTexture(PNGToTexture(substitute.string(), target.GetWidth(), target.GetHeight()));
+        store.AddTexture(PNGToTexture(substitute.string(), target->GetWidth(), target->GetHeight()));
     }
     else
     {
-        const auto palette = Palette{std::string{pal}};
-        auto fb = FileBufferFactory::Get()
-            .CreateDataBuffer(std::string{scx});
-        AddToTextureStore(store, LoadScreenResource(fb), palette);
+        AddToTextureStore(
+            store,
+            *ResourceCache::Get().GetScreen(std::string{scx}),
+            *ResourceCache::Get().GetPalette(std::string{pal}));
     }
 }
 
@@ -172,8 +166,7 @@ void TextureFactory::AddTerrainToTextureStore(
         image.reserve(imageEnd - imageStart);
         for (unsigned i = imageStart; i < imageEnd; i++)
         {
-            const auto& color = palette.GetColor(pixels[i]);
-            image.push_back(color);
+            image.push_back(palette.GetColor8(pixels[i]));
         }
         if (offset == 70)
         {
@@ -186,7 +179,7 @@ void TextureFactory::AddTerrainToTextureStore(
         
         store.AddTexture(
             Graphics::Texture{
-                image,
+                std::move(image),
                 static_cast<unsigned>(width),
                 static_cast<unsigned>(offset),
                 static_cast<unsigned>(width),
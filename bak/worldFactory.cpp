@@ -7,72 +7,161 @@
 #include "bak/imageStore.hpp"
 #include "bak/model.hpp"
 #include "bak/palette.hpp"
+#include "bak/resourceCache.hpp"
 #include "bak/screen.hpp"
 #include "bak/textureFactory.hpp"
 #include "bak/zoneReference.hpp"
 #include "bak/zone.hpp"
 
+#include "com/logger.hpp"
+#include "com/stopwatch.hpp"
 #include "com/string.hpp"
+#include "com/threadPool.hpp"
 
 #include "graphics/glm.hpp"
 #include "graphics/meshObject.hpp"
 
+#include <algorithm>
 #include <functional>   
 #include <vector>
 
 namespace BAK {
 
-ZoneTextureStore::ZoneTextureStore(
-    const ZoneLabel& zoneLabel)
-:
-    mTextures{},
-    mTerrainOffset{0},
-    mHorizonOffset{0}
+ZoneTextures LoadZoneTextures(
+    const ZoneLabel& zoneLabel,
+    ThreadPool& pool)
 {
-    bool found = true;
-    unsigned spriteSlot = 0;
+    auto stopwatch = Stopwatch{};
+
+    std::vector<std::string> spriteSlots{};
+    while (true)
+    {
+        auto spriteSlotLbl = zoneLabel.GetSpriteSlot(spriteSlots.size());
+        if (!FileBufferFactory::Get().DataBufferExists(spriteSlotLbl))
+            break;
+        spriteSlots.emplace_back(spriteSlotLbl);
+    }
+
+    auto terrainFuture = pool.Submit([&zoneLabel]{
+        auto terrainStore = Graphics::TextureStore{};
+        auto fb = FileBufferFactory::Get().CreateDataBuffer(zoneLabel.GetTerrain());
+        const auto terrain = LoadScreenResource(fb);
+        const auto pal = ResourceCache::Get().GetPalette(zoneLabel.GetPalette());
+        TextureFactory::AddTerrainToTextureStore(
+            terrainStore,
+            terrain,
+            *pal);
+        return terrainStore;
+    });
+
+    auto spriteSlotFutures = pool.SubmitEach(
+        spriteSlots.size(),
+        [&zoneLabel, &spriteSlots](std::size_t i){
+            return TextureFactory::MakeTextureStore(
+                spriteSlots[i], zoneLabel.GetPalette());
+        });
+
+    terrainFuture.wait();
+    auto spriteSlotStores = ThreadPool::GetResults(spriteSlotFutures);
+    auto terrainStore = terrainFuture.get();
 
-    while (found)
+    // Texture indices are fixed by slot order, so merge in that order
+    auto textures = ZoneTextures{{}, 0, 0};
+    for (auto& store : spriteSlotStores)
     {
-        auto spriteSlotLbl = zoneLabel.GetSpriteSlot(spriteSlot++);
-        if ((found = FileBufferFactory::Get().DataBufferExists(spriteSlotLbl)))
+        for (unsigned i = 0; i < store.size(); i++)
         {
-            TextureFactory::AddToTextureStore(
-                mTextures, spriteSlotLbl, zoneLabel.GetPalette());
+            textures.mTextures.emplace_back(std::move(store.GetTexture(i)));
         }
     }
 
-    mTerrainOffset = GetTextures().size();
+    textures.mTerrainOffset = textures.mTextures.size();
+
+    for (unsigned i = 0; i < terrainStore.size(); i++)
+    {
+        textures.mTextures.emplace_back(std::move(terrainStore.GetTexture(i)));
+    }
+
+    textures.mHorizonOffset = textures.mTextures.size();
 
-    auto fb = FileBufferFactory::Get().CreateDataBuffer(zoneLabel.GetTerrain());
-    const auto terrain = LoadScreenResource(fb);
-    auto pal = Palette{zoneLabel.GetPalette()};
-    TextureFactory::AddTerrainToTextureStore(
-        mTextures,
-        terrain,
-        pal);
+    std::size_t bytes = 0;
+    for (const auto& texture : textures.mTextures)
+    {
+        bytes += texture.GetTexture().size() * sizeof(Graphics::Pixel);
+    }
+    Logging::LogInfo("ZoneLoader") << zoneLabel.GetZone() << " textures: "
+        << spriteSlots.size() << " sprite slots, " << textures.mTextures.size()
+        << " textures (" << bytes / 1024 << "KiB) in " << stopwatch.Lap() << "ms\n";
+
+    return textures;
+}
 
-    mHorizonOffset = GetTextures().size();
+ZoneTextureStore::ZoneTextureStore(
+    const ZoneLabel& zoneLabel)
+:
+    ZoneTextureStore{zoneLabel, ThreadPool::Get()}
+{}
+
+ZoneTextureStore::ZoneTextureStore(
+    const ZoneLabel& zoneLabel,
+    ThreadPool& pool)
+:
+    ZoneTextureStore{LoadZoneTextures(zoneLabel, pool)}
+{}
+
+ZoneTextureStore::ZoneTextureStore(const ZoneTextures& textures)
+:
+    mDims{},
+    mAtlas{},
+    mMaxDim{0},
+    mTerrainOffset{textures.mTerrainOffset},
+    mHorizonOffset{textures.mHorizonOffset}
+{
+    for (const auto& texture : textures.mTextures)
+    {
+        AddDims(texture);
+    }
+
+    // Terrain is repeated across the ground so needs layers of its own
+    auto wrap = std::vector<bool>(textures.mTextures.size(), false);
+    std::fill(wrap.begin() + mTerrainOffset, wrap.begin() + mHorizonOffset, true);
+    mAtlas = Graphics::TextureAtlas{textures.mTextures, wrap};
+
+    Logging::LogInfo("ZoneLoader") << "Packed " << textures.mTextures.size()
+        << " textures into " << mAtlas.GetLayers().size() << " layers of "
+        << mAtlas.GetLayerDim() << "\n";
+}
+
+void ZoneTextureStore::AddDims(const Graphics::Texture& texture)
+{
+    mDims.emplace_back(ZoneTextureDims{
+        texture.GetWidth(),
+        texture.GetHeight(),
+        texture.GetTargetWidth(),
+        texture.GetTargetHeight()});
+    mMaxDim = std::max({mMaxDim, texture.GetWidth(), texture.GetHeight()});
 }
 
-const Graphics::Texture& ZoneTextureStore::GetTexture(const unsigned i) const
+const ZoneTextureDims& ZoneTextureStore::GetDims(const unsigned i) const
 {
-    return mTextures.GetTexture(i);
+    return mDims.at(i);
 }
 
-const std::vector<Graphics::Texture>& ZoneTextureStore::GetTextures() const { return mTextures.GetTextures(); }
+std::size_t ZoneTextureStore::size() const { return mDims.size(); }
 
 void ZoneTextureStore::AddTexture(const Graphics::Texture& texture)
 {
-    mTextures.AddTexture(texture);
+    AddDims(texture);
+    mAtlas.AddTexture(texture);
 }
 
-unsigned ZoneTextureStore::GetMaxDim() const { return mTextures.GetMaxDim(); }
+unsigned ZoneTextureStore::GetMaxDim() const { return mMaxDim; }
 unsigned ZoneTextureStore::GetTerrainOffset(BAK::Terrain t) const
 {
     return mTerrainOffset + static_cast<unsigned>(t);
 }
 unsigned ZoneTextureStore::GetHorizonOffset() const { return mHorizonOffset; }
+const Graphics::TextureAtlas& ZoneTextureStore::GetAtlas() const { return mAtlas; }
 
 
 
@@ -163,10 +252,10 @@ ZoneItem::ZoneItem(
     else
     {
         // Need this to set the right dimensions for the texture
-        const auto& tex = textureStore.GetTexture(mSpriteIndex);
+        const auto& dims = textureStore.GetDims(mSpriteIndex);
         const auto spriteScale = 7.0f;
-        auto width  = static_cast<int>(static_cast<float>(tex.GetTargetWidth()) * spriteScale);
-        auto height = tex.GetTargetHeight() * spriteScale * 1.2;
+        auto width  = static_cast<int>(static_cast<float>(dims.mTargetWidth) * spriteScale);
+        auto height = dims.mTargetHeight * spriteScale * 1.2;
         auto halfWidth = width / 2;
         mVertices.emplace_back(-halfWidth, height, 0);
         mVertices.emplace_back(halfWidth, height, 0);
@@ -243,6 +332,20 @@ void ZoneItem::SetPush(unsigned i){ mPush[i] = true; }
 const std::string& ZoneItem::GetName() const { return mName; }
 bool ZoneItem::IsSprite() const { return mSpriteIndex > 0 && mSpriteIndex < 400; }
 float ZoneItem::GetScale() const { return mScale; }
+
+float ZoneItem::GetBoundingRadius() const
+{
+    float radius = 0;
+    for (const auto& vertex : mVertices)
+    {
+        radius = std::max(radius, glm::length(glm::cast<float>(vertex)));
+    }
+    if (mUndergroundModel)
+    {
+        radius = std::max(radius, mUndergroundModel->GetBoundingRadius());
+    }
+    return radius;
+}
 bool ZoneItem::GetClickable() const
 {
     for (std::string s : {
@@ -310,23 +413,9 @@ Graphics::MeshObject ZoneItemToMeshObject(
     const ZoneTextureStore& store,
     const BAK::Palette& pal)
 {
-    const auto& logger = Logging::LogState::GetLogger(__FUNCTION__);
-    std::vector<glm::vec3> vertices;
-    std::vector<glm::vec3> normals;
-    std::vector<glm::vec4> colors;
-    std::vector<glm::vec3> textureCoords;
-    std::vector<float> textureBlends;
-    std::vector<unsigned> indices;
+    auto builder = Graphics::MeshBuilder{};
 
     auto glmVertices = std::vector<glm::vec3>{};
-
-    const auto TextureBlend = [&](auto blend)
-    {
-        textureBlends.emplace_back(blend);
-        textureBlends.emplace_back(blend);
-        textureBlends.emplace_back(blend);
-    };
-
     for (const auto& vertex : item.GetVertices())
     {
         glmVertices.emplace_back(
@@ -343,62 +432,38 @@ Graphics::MeshObject ZoneItemToMeshObject(
             auto normal = glm::normalize(
                 glm::cross(end - start, glm::vec3(0, 0, 1.0)));
             float linewidth = 0.05f;
-            indices.emplace_back(vertices.size());
-            vertices.emplace_back(start + linewidth * normal);
-            indices.emplace_back(vertices.size());
-            vertices.emplace_back(end + linewidth * normal);
-            indices.emplace_back(vertices.size());
-            vertices.emplace_back(start - linewidth * normal);
-
-            indices.emplace_back(vertices.size());
-            vertices.emplace_back(end + linewidth * normal);
-            indices.emplace_back(vertices.size());
-            vertices.emplace_back(start - linewidth * normal);
-            indices.emplace_back(vertices.size());
-            vertices.emplace_back(end - linewidth * normal);
-
-            normals.emplace_back(normal);
-            normals.emplace_back(normal);
-            normals.emplace_back(normal);
-            normals.emplace_back(normal);
-            normals.emplace_back(normal);
-            normals.emplace_back(normal);
 
             auto colorIndex = item.GetColors().at(index);
-            auto paletteIndex = item.GetPalettes().at(index);
             auto textureIndex = colorIndex;
-
             auto color = pal.GetColor(colorIndex);
-            colors.emplace_back(color);
-            colors.emplace_back(color);
-            colors.emplace_back(color);
-
-            colors.emplace_back(color);
-            colors.emplace_back(color);
-            colors.emplace_back(color);
-
-            textureCoords.emplace_back(0.0, 0.0, textureIndex);
-            textureCoords.emplace_back(0.0, 0.0, textureIndex);
-            textureCoords.emplace_back(0.0, 0.0, textureIndex);
-            textureCoords.emplace_back(0.0, 0.0, textureIndex);
-            textureCoords.emplace_back(0.0, 0.0, textureIndex);
-            textureCoords.emplace_back(0.0, 0.0, textureIndex);
 
-            TextureBlend(0.0);
-            TextureBlend(0.0);
+            const auto LineVertex = [&](glm::vec3 position)
+            {
+                return Graphics::PackVertex(
+                    position,
+                    normal,
+                    color,
+                    glm::vec3{0.0, 0.0, textureIndex},
+                    0.0f);
+            };
+
+            builder.AddTriangle(
+                LineVertex(start + linewidth * normal),
+                LineVertex(end + linewidth * normal),
+                LineVertex(start - linewidth * normal));
+            builder.AddTriangle(
+                LineVertex(end + linewidth * normal),
+                LineVertex(start - linewidth * normal),
+                LineVertex(end - linewidth * normal));
 
             index++;
             continue;
         }
 
-        unsigned triangles = face.size() - 2;
-
         // Whether to push this face away from the main plane
         // (needed to avoid z-fighting for some objects)
         bool push = item.GetPush().at(index);
         
-        // Tesselate the face
-        // Generate normals and new indices for each face vertex
         // The normal must be inverted to account
         // for the Y direction being negated
         auto normal = glm::normalize(
@@ -410,223 +475,220 @@ Graphics::MeshObject ZoneItemToMeshObject(
             normal = glm::normalize(glm::cross(normal, glm::vec3{1, 0, 1}));
         }
 
-        for (unsigned triangle = 0; triangle < triangles; triangle++)
+        glm::vec3 zOff = normal * 0.02f;
+        if (push) zOff = glm::vec3{0};
+
+        // Hacky - only works for quads - but the game only
+        // textures quads anyway... (not true...)
+        auto colorIndex = item.GetColors().at(index);
+        auto paletteIndex = item.GetPalettes().at(index);
+        auto textureIndex = colorIndex;
+        float textureBlend = 0.0f;
+
+        float u = 1.0;
+        float v = 1.0;
+
+        // I feel like these "palettes" are probably collections of
+        // flags?
+        static constexpr std::uint8_t texturePalette0 = 0x90;
+        static constexpr std::uint8_t texturePalette1 = 0x91;
+        static constexpr std::uint8_t texturePalette2 = 0xd1;
+        // texturePalette3 is optional and puts grass on mountains
+        static constexpr std::uint8_t texturePalette3 = 0x81;
+        static constexpr std::uint8_t texturePalette4 = 0x11;
+        static constexpr std::uint8_t terrainPalette = 0xc1;
+
+        // terrain palette
+        // 0 = ground
+        // 1 = road
+        // 2 = waterfall
+        // 3 = path
+        // 4 = dirt/field
+        // 5 = river
+        // 6 = sand
+        // 7 = riverbank
+        if (item.GetName().substr(0, 2) == "t0")
         {
-            auto i_a = face[0];
-            auto i_b = face[triangle + 1];
-            auto i_c = face[triangle + 2];
-
-            normals.emplace_back(normal);
-            normals.emplace_back(normal);
-            normals.emplace_back(normal);
-
-            glm::vec3 zOff = normal * 0.02f;
-            if (push) zOff = glm::vec3{0};
-            
-            vertices.emplace_back(glmVertices[i_a] - zOff);
-            indices.emplace_back(vertices.size() - 1);
-            vertices.emplace_back(glmVertices[i_b] - zOff);
-            indices.emplace_back(vertices.size() - 1);
-            vertices.emplace_back(glmVertices[i_c] - zOff);
-            indices.emplace_back(vertices.size() - 1);
-            
-            // Hacky - only works for quads - but the game only
-            // textures quads anyway... (not true...)
-            auto colorIndex = item.GetColors().at(index);
-            auto paletteIndex = item.GetPalettes().at(index);
-            auto textureIndex = colorIndex;
-
-            float u = 1.0;
-            float v = 1.0;
-
-            auto maxDim = store.GetMaxDim();
-            
-            // I feel like these "palettes" are probably collections of
-            // flags?
-            static constexpr std::uint8_t texturePalette0 = 0x90;
-            static constexpr std::uint8_t texturePalette1 = 0x91;
-            static constexpr std::uint8_t texturePalette2 = 0xd1;
-            // texturePalette3 is optional and puts grass on mountains
-            static constexpr std::uint8_t texturePalette3 = 0x81;
-            static constexpr std::uint8_t texturePalette4 = 0x11;
-            static constexpr std::uint8_t terrainPalette = 0xc1;
-
-            // terrain palette
-            // 0 = ground
-            // 1 = road
-            // 2 = waterfall
-            // 3 = path
-            // 4 = dirt/field
-            // 5 = river
-            // 6 = sand
-            // 7 = riverbank
-            if (item.GetName().substr(0, 2) == "t0")
+            if (textureIndex == 1)
             {
-                if (textureIndex == 1)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::Road);
-                    TextureBlend(1.0);
-                }
-                else if (textureIndex == 2)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::Path);
-                    TextureBlend(1.0);
-                }
-                else if (textureIndex == 3)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::River);
-                    TextureBlend(1.0);
-                }
-                else
-                {
-                    TextureBlend(0.0);
-                }
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::Road);
+                textureBlend = 1.0f;
             }
-            else if (item.GetName().substr(0, 2) == "r0")
+            else if (textureIndex == 2)
             {
-                if (textureIndex == 3)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::River);
-                    TextureBlend(1.0);
-                }
-                else if (textureIndex == 5)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::Bank);
-                    TextureBlend(1.0);
-                }
-                else
-                {
-                    TextureBlend(0.0);
-                }
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::Path);
+                textureBlend = 1.0f;
             }
-            else if (item.GetName().substr(0, 2) == "g0")
+            else if (textureIndex == 3)
             {
-                if (textureIndex == 0)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::Ground);
-                    TextureBlend(1.0);
-                }
-                else if (textureIndex == 5)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::River);
-                    TextureBlend(1.0);
-                }
-                else
-                {
-                    TextureBlend(0.0);
-                }
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::River);
+                textureBlend = 1.0f;
             }
-            else if (item.GetName().substr(0, 5) == "field")
+            else
             {
-                if (textureIndex == 1)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::Dirt);
-                    TextureBlend(1.0);
-                }
-                else if (textureIndex == 2)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::Bank);
-                    TextureBlend(1.0);
-                }
-                else
-                {
-                    TextureBlend(1.0);
-                }
+                textureBlend = 0.0f;
             }
-            else if (item.GetName().substr(0, 4) == "fall"
-                || item.GetName().substr(0, 6) == "spring")
+        }
+        else if (item.GetName().substr(0, 2) == "r0")
+        {
+            if (textureIndex == 3)
             {
-                if (textureIndex == 3)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::River);
-                    TextureBlend(1.0);
-                }
-                else if (textureIndex == 5)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::Bank);
-                    TextureBlend(1.0);
-                }
-                else if (textureIndex == 6)
-                {
-                    textureIndex = store.GetTerrainOffset(BAK::Terrain::Waterfall);
-                    TextureBlend(1.0);
-                }
-                else
-                {
-                    TextureBlend(0.0);
-                }
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::River);
+                textureBlend = 1.0f;
+            }
+            else if (textureIndex == 5)
+            {
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::Bank);
+                textureBlend = 1.0f;
             }
-            else if (paletteIndex == terrainPalette)
+            else
+            {
+                textureBlend = 0.0f;
+            }
+        }
+        else if (item.GetName().substr(0, 2) == "g0")
+        {
+            if (textureIndex == 0)
             {
-                textureIndex += store.GetTerrainOffset(BAK::Terrain::Ground);
-                TextureBlend(1.0);
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::Ground);
+                textureBlend = 1.0f;
             }
-            else if (paletteIndex == texturePalette0
-                || paletteIndex == texturePalette1
-                || paletteIndex == texturePalette2
-                || paletteIndex == texturePalette4)
+            else if (textureIndex == 5)
             {
-                TextureBlend(1.0);
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::River);
+                textureBlend = 1.0f;
             }
             else
             {
-                TextureBlend(0.0);
+                textureBlend = 0.0f;
             }
-
-            if (colorIndex < store.GetTextures().size())
+        }
+        else if (item.GetName().substr(0, 5) == "field")
+        {
+            if (textureIndex == 1)
             {
-                u = static_cast<float>(store.GetTexture(textureIndex).GetWidth() - 1) 
-                    / static_cast<float>(maxDim);
-                v = static_cast<float>(store.GetTexture(textureIndex).GetHeight() - 1) 
-                    / static_cast<float>(maxDim);
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::Dirt);
+                textureBlend = 1.0f;
             }
-
-            // controls the size of the "pixel" effect of the ground
-            if (item.GetName().substr(0, 6) == "ground")
+            else if (textureIndex == 2)
             {
-                u *= 40;
-                v *= 40;
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::Bank);
+                textureBlend = 1.0f;
             }
-
-            if (triangle == 0)
+            else
             {
-                textureCoords.emplace_back(0.0, v,   textureIndex);
-                textureCoords.emplace_back(u,   v,   textureIndex);
-                textureCoords.emplace_back(u,   0.0, textureIndex);
+                textureBlend = 1.0f;
+            }
+        }
+        else if (item.GetName().substr(0, 4) == "fall"
+            || item.GetName().substr(0, 6) == "spring")
+        {
+            if (textureIndex == 3)
+            {
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::River);
+                textureBlend = 1.0f;
+            }
+            else if (textureIndex == 5)
+            {
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::Bank);
+                textureBlend = 1.0f;
+            }
+            else if (textureIndex == 6)
+            {
+                textureIndex = store.GetTerrainOffset(BAK::Terrain::Waterfall);
+                textureBlend = 1.0f;
             }
             else
             {
-                textureCoords.emplace_back(0.0, v,   textureIndex);
-                textureCoords.emplace_back(u,   0.0, textureIndex);
-                textureCoords.emplace_back(0.0, 0.0, textureIndex);
+                textureBlend = 0.0f;
             }
+        }
+        else if (paletteIndex == terrainPalette)
+        {
+            textureIndex += store.GetTerrainOffset(BAK::Terrain::Ground);
+            textureBlend = 1.0f;
+        }
+        else if (paletteIndex == texturePalette0
+            || paletteIndex == texturePalette1
+            || paletteIndex == texturePalette2
+            || paletteIndex == texturePalette4)
+        {
+            textureBlend = 1.0f;
+        }
+        else
+        {
+            textureBlend = 0.0f;
+        }
 
-            auto color = pal.GetColor(colorIndex);
+        // Texels of the texture, mapped to the atlas below
+        const bool hasTexture = colorIndex < store.size();
+        if (hasTexture)
+        {
+            u = static_cast<float>(store.GetDims(textureIndex).mWidth - 1);
+            v = static_cast<float>(store.GetDims(textureIndex).mHeight - 1);
+        }
+
+        // controls the size of the "pixel" effect of the ground
+        if (item.GetName().substr(0, 6) == "ground")
+        {
+            u *= 40;
+            v *= 40;
+        }
 
-            // bitta fun
-            if (item.GetName().substr(0, 5) == "cryst")
-                color.a = 0.8;
+        const auto TexCoord = [&](float s, float t)
+        {
+            if (!hasTexture)
+            {
+                return glm::vec3{s, t, textureIndex};
+            }
+            return store.GetAtlas().GetTexelCoords(textureIndex, glm::vec2{s, t});
+        };
 
-            colors.emplace_back(color);
-            colors.emplace_back(color);
-            colors.emplace_back(color);
+        auto color = pal.GetColor(colorIndex);
+
+        // bitta fun
+        if (item.GetName().substr(0, 5) == "cryst")
+            color.a = 0.8;
+
+        const auto FaceVertex = [&](unsigned i, float s, float t)
+        {
+            return Graphics::PackVertex(
+                glmVertices[i] - zOff,
+                normal,
+                color,
+                TexCoord(s, t),
+                textureBlend);
+        };
+
+        // Tesselate the face as a fan. Corners shared by its triangles
+        // are welded into one vertex.
+        const unsigned triangles = face.size() - 2;
+        for (unsigned triangle = 0; triangle < triangles; triangle++)
+        {
+            auto i_a = face[0];
+            auto i_b = face[triangle + 1];
+            auto i_c = face[triangle + 2];
+
+            if (triangle == 0)
+            {
+                builder.AddTriangle(
+                    FaceVertex(i_a, 0.0, v),
+                    FaceVertex(i_b, u,   v),
+                    FaceVertex(i_c, u,   0.0));
+            }
+            else
+            {
+                builder.AddTriangle(
+                    FaceVertex(i_a, 0.0, v),
+                    FaceVertex(i_b, u,   0.0),
+                    FaceVertex(i_c, 0.0, 0.0));
+            }
         }
 
         index++;
     }
 
-    assert(vertices.size() == normals.size());
-    assert(vertices.size() == colors.size());
-    assert(vertices.size() == textureCoords.size());
-    assert(vertices.size() == textureBlends.size());
-    assert(vertices.size() == indices.size());
-    return Graphics::MeshObject{
-        vertices,
-        normals,
-        colors,
-        textureCoords,
-        textureBlends,
-        indices};
+    return std::move(builder).Build();
 }
 
 Graphics::MeshObject ZoneItemToMeshObject(
@@ -768,11 +830,8 @@ Graphics::MeshObject ZoneItemToMeshObject(
 
             TextureBlend(1.0);
 
-            auto maxDim = store.GetMaxDim();
-            u = static_cast<float>(store.GetTexture(textureIndex).GetWidth() - 1) 
-                / static_cast<float>(maxDim);
-            v = static_cast<float>(store.GetTexture(textureIndex).GetHeight() - 1) 
-                / static_cast<float>(maxDim);
+            u = static_cast<float>(store.GetTexture(textureIndex).GetWidth() - 1);
+            v = static_cast<float>(store.GetTexture(textureIndex).GetHeight() - 1);
 
             if (triangle == 0)
             {
@@ -945,43 +1004,26 @@ Graphics::MeshObject ClipToMeshObject(const ModelClip& clip, const glm::vec4& co
 
 Graphics::MeshObject ClipsToMeshObject(const std::vector<ModelClip>& clips, const glm::vec4& color)
 {
-    std::vector<glm::vec3> vertices;
-    std::vector<glm::vec3> normals;
-    std::vector<glm::vec4> colors;
-    std::vector<glm::vec3> textureCoords;
-    std::vector<float> textureBlends;
-    std::vector<unsigned> indices;
-
+    auto builder = Graphics::MeshBuilder{};
     for (const auto& clip : clips)
     {
-        auto mesh = ClipToMeshObject(clip, color);
-        auto base = static_cast<unsigned>(vertices.size());
-
-        std::copy(mesh.mVertices.begin(), mesh.mVertices.end(),
-            std::back_inserter(vertices));
-        std::copy(mesh.mNormals.begin(), mesh.mNormals.end(),
-            std::back_inserter(normals));
-        std::copy(mesh.mColors.begin(), mesh.mColors.end(),
-            std::back_inserter(colors));
-        std::copy(mesh.mTextureCoords.begin(), mesh.mTextureCoords.end(),
-            std::back_inserter(textureCoords));
-        std::copy(mesh.mTextureBlends.begin(), mesh.mTextureBlends.end(),
-            std::back_inserter(textureBlends));
-
-        for (auto i : mesh.mIndices)
-        {
-            indices.emplace_back(base + i);
-        }
+        builder.AddMesh(ClipToMeshObject(clip, color));
     }
-
-    return Graphics::MeshObject{
-        vertices, normals, colors, textureCoords, textureBlends, indices};
+    return std::move(builder).Build();
 }
 
 ZoneItemStore::ZoneItemStore(
     const ZoneLabel& zoneLabel,
     // Should one really need a texture store to load this?
     const ZoneTextureStore& textureStore)
+:
+    ZoneItemStore{zoneLabel, textureStore, ThreadPool::Get()}
+{}
+
+ZoneItemStore::ZoneItemStore(
+    const ZoneLabel& zoneLabel,
+    const ZoneTextureStore& textureStore,
+    ThreadPool& pool)
 :
     mZoneLabel{zoneLabel},
     mItems{},
@@ -989,11 +1031,44 @@ ZoneItemStore::ZoneItemStore(
     mClips{},
     mModelFrameCountMap{}
 {
-    auto fb = FileBufferFactory::Get().CreateDataBuffer(mZoneLabel.GetTable());
-    auto [models, clips] = LoadTBL(fb);
+    auto stopwatch = Stopwatch{};
+
+    const auto LoadTable = [](const std::string& table)
+    {
+        auto fb = FileBufferFactory::Get().CreateDataBuffer(table);
+        return LoadTBL(fb);
+    };
+
+    using Table = std::invoke_result_t<decltype(LoadTable), const std::string&>;
+    auto ugTableFuture = std::future<Table>{};
+    if (BAK::IsUnderground(BAK::ZoneNumber{mZoneLabel.GetZoneNumber()}))
+    {
+        ugTableFuture = pool.Submit([&]{
+            return LoadTable(mZoneLabel.GetTableUnderground()); });
+    }
+
+    auto table = std::invoke([&]{
+        // Don't leave the underground load running if this one fails
+        try
+        {
+            return LoadTable(mZoneLabel.GetTable());
+        }
+        catch (...)
+        {
+            if (ugTableFuture.valid()) ugTableFuture.wait();
+            throw;
+        }
+    });
 
-    mModels = std::move(models);
-    mClips = std::move(clips);
+    mModels = std::move(table.first);
+    mClips = std::move(table.second);
+
+    auto ugModels = std::vector<Model>{};
+    if (ugTableFuture.valid())
+    {
+        ugModels = std::move(ugTableFuture.get().first);
+        ASSERT(ugModels.size() >= mModels.size());
+    }
 
     // Models with multiple face options are animated
     for (const auto& model : mModels)
@@ -1026,30 +1101,17 @@ ZoneItemStore::ZoneItemStore(
         {
             mClips[i] = *doorGi;
         }
-
-        mItems.emplace_back(
-            mModels[i],
-            mClips[i],
-            textureStore);
     }
 
-    if (BAK::IsUnderground(BAK::ZoneNumber{mZoneLabel.GetZoneNumber()}))
-    {
-        auto fbUG = FileBufferFactory::Get().CreateDataBuffer(
-            mZoneLabel.GetTableUnderground());
-        auto [ugModels, ugClips] = LoadTBL(fbUG);
-
-        ASSERT(ugModels.size() >= mModels.size());
+    mItems = pool.Map(mModels.size(), [&](std::size_t i){
+        const auto* ugModel = i < ugModels.size() && !ugModels[i].mComponents.empty()
+            ? &ugModels[i]
+            : nullptr;
+        return ZoneItem{mModels[i], mClips[i], textureStore, 0, ugModel};
+    });
 
-        for (unsigned i = 0; i < mModels.size(); i++)
-        {
-            if (!ugModels[i].mComponents.empty())
-            {
-                mItems[i] = ZoneItem{
-                    mModels[i], mClips[i], textureStore, 0, &ugModels[i]};
-            }
-        }
-    }
+    Logging::LogInfo("ZoneLoader") << mZoneLabel.GetZone() << " models: "
+        << mItems.size() << " items in " << stopwatch.Lap() << "ms\n";
 }
 
 const ZoneLabel& ZoneItemStore::GetZoneLabel() const { return mZoneLabel; }
@@ -1129,7 +1191,7 @@ std::ostream& operator<<(std::ostream& os, const WorldItemInstance& d)
 
 World::World(
     const ZoneItemStore& zoneItems,
-    Encounter::EncounterFactory ef,
+    const Encounter::EncounterFactory& ef,
     unsigned x,
     unsigned y,
     unsigned tileIndex)
@@ -1146,7 +1208,7 @@ World::World(
 
 void World::LoadWorld(
     const ZoneItemStore& zoneItems,
-    const Encounter::EncounterFactory ef,
+    const Encounter::EncounterFactory& ef,
     unsigned x,
     unsigned y,
     unsigned tileIndex)
@@ -1200,6 +1262,28 @@ glm::vec3 World::GetCenter() const
         GetItems().front().GetLocation());
 }
 
+std::vector<std::future<World>> SubmitWorldTiles(
+    const ZoneItemStore& zoneItems,
+    const Encounter::EncounterFactory& ef,
+    ThreadPool& pool)
+{
+    auto tiles = LoadZoneRef(
+        zoneItems.GetZoneLabel().GetZoneReference());
+
+    return pool.SubmitEach(
+        tiles.size(),
+        [&zoneItems, &ef, tiles=std::move(tiles)](std::size_t tileIndex)
+        {
+            const auto& tile = tiles[tileIndex];
+            return World{
+                zoneItems,
+                ef,
+                tile.x,
+                tile.y,
+                static_cast<unsigned>(tileIndex)};
+        });
+}
+
 WorldTileStore::WorldTileStore(
     const ZoneItemStore& zoneItems,
     const Encounter::EncounterFactory& ef)
@@ -1207,28 +1291,17 @@ WorldTileStore::WorldTileStore(
     mWorlds{
         std::invoke([&zoneItems, &ef]()
         {
-            const auto tiles = LoadZoneRef(
-                zoneItems.GetZoneLabel().GetZoneReference());
-
-            std::vector<World> worlds{};
-            worlds.reserve(tiles.size());
-
-            for (unsigned tileIndex = 0; tileIndex < tiles.size(); tileIndex++)
-            {
-                const auto& tile = tiles[tileIndex];
-                auto it = worlds.emplace_back(
-                    zoneItems,
-                    ef,
-                    tile.x,
-                    tile.y,
-                    tileIndex);
-            }
-
-            return worlds;
+            auto worlds = SubmitWorldTiles(zoneItems, ef, ThreadPool::Get());
+            return ThreadPool::GetResults(worlds);
         })
     }
 {}
 
+WorldTileStore::WorldTileStore(std::vector<World>&& worlds)
+:
+    mWorlds{std::move(worlds)}
+{}
+
 const std::vector<World>& WorldTileStore::GetTiles() const
 {
     return mWorlds;
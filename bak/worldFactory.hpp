@@ -9,12 +9,16 @@
 #include "bak/worldItem.hpp"
 
 #include "graphics/texture.hpp"
+#include "graphics/textureAtlas.hpp"
 
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
 
+class ThreadPool;
+
 namespace Graphics {
 class MeshObject;
 }
@@ -23,6 +27,28 @@ namespace BAK {
 
 class Palette;
 
+// A zone's sprite slot textures followed by its terrain textures
+struct ZoneTextures
+{
+    std::vector<Graphics::Texture> mTextures;
+    unsigned mTerrainOffset;
+    unsigned mHorizonOffset;
+};
+
+// Sprite slots and terrain are decoded in parallel on the pool
+ZoneTextures LoadZoneTextures(
+    const ZoneLabel& zoneLabel,
+    ThreadPool& pool);
+
+// Size of a zone texture, which is otherwise only kept in the atlas
+struct ZoneTextureDims
+{
+    unsigned mWidth;
+    unsigned mHeight;
+    unsigned mTargetWidth;
+    unsigned mTargetHeight;
+};
+
 class ZoneTextureStore
 {
 public:
@@ -30,18 +56,33 @@ public:
     ZoneTextureStore(
         const ZoneLabel& zoneLabel);
 
-    const Graphics::Texture& GetTexture(const unsigned i) const;
-    const std::vector<Graphics::Texture>& GetTextures() const;
+    ZoneTextureStore(
+        const ZoneLabel& zoneLabel,
+        ThreadPool& pool);
+
+    // The textures are packed into the atlas and not kept
+    explicit ZoneTextureStore(const ZoneTextures& textures);
+
+    const ZoneTextureDims& GetDims(const unsigned i) const;
+    std::size_t size() const;
 
+    // Textures added after construction are packed into the atlas too
     void AddTexture(const Graphics::Texture& texture);
 
     unsigned GetMaxDim() const;
     unsigned GetTerrainOffset(BAK::Terrain t) const;
     unsigned GetHorizonOffset() const;
 
+    // Texture coordinates of zone meshes refer to the atlas layers
+    const Graphics::TextureAtlas& GetAtlas() const;
+
 private:
-    Graphics::TextureStore mTextures;
+    void AddDims(const Graphics::Texture& texture);
+
+    std::vector<ZoneTextureDims> mDims;
+    Graphics::TextureAtlas mAtlas;
 
+    unsigned mMaxDim;
     unsigned mTerrainOffset;
     unsigned mHorizonOffset;
 };
@@ -64,6 +105,8 @@ public:
     const std::string& GetName() const;
     bool IsSprite() const;
     float GetScale() const;
+    // Distance of the furthest vertex from the origin, before scaling
+    float GetBoundingRadius() const;
     bool GetClickable() const;
     EntityType GetEntityType() const;
     TerrainType GetTerrainType() const;
@@ -118,6 +161,11 @@ public:
         // Should one really need a texture store to load this?
         const ZoneTextureStore& textureStore);
 
+    ZoneItemStore(
+        const ZoneLabel& zoneLabel,
+        const ZoneTextureStore& textureStore,
+        ThreadPool& pool);
+
     const ZoneLabel& GetZoneLabel() const;
 
     const ZoneItem& GetZoneItem(const unsigned i) const;
@@ -173,14 +221,14 @@ public:
 
     World(
         const ZoneItemStore& zoneItems,
-        Encounter::EncounterFactory ef,
+        const Encounter::EncounterFactory& ef,
         unsigned x,
         unsigned y,
         unsigned tileIndex);
 
     void LoadWorld(
         const ZoneItemStore& zoneItems,
-        const Encounter::EncounterFactory ef,
+        const Encounter::EncounterFactory& ef,
         unsigned x,
         unsigned y,
         unsigned tileIndex);
@@ -202,6 +250,13 @@ private:
 };
 
 
+// Starts loading every tile of the zone on the pool. The item store and
+// encounter factory must outlive the returned futures.
+std::vector<std::future<World>> SubmitWorldTiles(
+    const ZoneItemStore& zoneItems,
+    const Encounter::EncounterFactory& ef,
+    ThreadPool& pool);
+
 class WorldTileStore
 {
 public:
@@ -209,6 +264,8 @@ public:
         const ZoneItemStore& zoneItems,
         const Encounter::EncounterFactory& ef);
 
+    explicit WorldTileStore(std::vector<World>&& worlds);
+
     const std::vector<World>& GetTiles() const;
 
 private:
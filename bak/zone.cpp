@@ -3,14 +3,20 @@
 #include "bak/encounter/encounter.hpp"
 #include "bak/fixedObject.hpp"
 #include "bak/palette.hpp"
+#include "bak/resourceCache.hpp"
 #include "bak/resourceNames.hpp"
 #include "bak/worldFactory.hpp"
+#include "bak/zoneAssetCache.hpp"
 
 #include "graphics/cube.hpp"
 #include "graphics/meshObject.hpp"
 #include "graphics/quad.hpp"
 
 #include "com/assert.hpp"
+#include "com/logger.hpp"
+#include "com/path.hpp"
+#include "com/stopwatch.hpp"
+#include "com/threadPool.hpp"
 
 #include <cmath>
 
@@ -23,81 +29,188 @@ constexpr auto sGridFadePixels = 6u;
 constexpr auto sGridBorderThick = 4u;
 constexpr auto sGridBorderTotal = 2 * sGridFadePixels + sGridBorderThick;
 
-Graphics::MeshObject MakeGridQuadMesh(unsigned textureLayer)
+Graphics::MeshObject MakeGridQuadMesh(const Graphics::TextureAtlas& atlas, unsigned texture)
 {
     const auto size = 0.55f;
-    const auto layer = static_cast<float>(textureLayer);
+    const auto dims = glm::vec2{atlas.GetRegion(texture).mDims};
     return Graphics::Quad{
         {{{-size, 2.0f,  size}, {-size, 2.0f, -size}, { size, 2.0f, -size}, { size, 2.0f,  size}}},
-        {{{0, 0, layer}, {0, 1, layer}, {1, 1, layer}, {1, 0, layer}}}
+        {{
+            atlas.GetTexelCoords(texture, {0, 0}),
+            atlas.GetTexelCoords(texture, {0, dims.y}),
+            atlas.GetTexelCoords(texture, dims),
+            atlas.GetTexelCoords(texture, {dims.x, 0})}}
     }.ToMeshObject(0.0f);
 }
 
+using NamedMeshes = std::vector<std::pair<std::string, Graphics::MeshObject>>;
+
+// All the meshes for one zone item, in the order they are added to storage
+NamedMeshes MakeZoneItemMeshes(
+    const ZoneItemStore& zoneItems,
+    const ZoneTextureStore& textures,
+    const Palette& palette,
+    unsigned i)
+{
+    NamedMeshes meshes{};
+    const auto& item = zoneItems.GetItems()[i];
+    meshes.emplace_back(
+        item.GetName(),
+        BAK::ZoneItemToMeshObject(item, textures, palette));
+
+    if (item.GetModelClip())
+    {
+        meshes.emplace_back(
+            BAK::GetClipName(item.GetName()),
+            ClipToMeshObject(
+                *item.GetModelClip(),
+                BAK::GetDebugColor(item.GetEntityType())));
+    }
+
+    if (item.HasUndergroundModel())
+    {
+        meshes.emplace_back(
+            BAK::GetUndergroundName(item.GetName()),
+            BAK::ZoneItemToMeshObject(
+                item.GetUndergroundModel(), textures, palette));
+    }
+
+    const auto frameCount = zoneItems.GetModelFrameCount(item.GetName());
+    if (frameCount)
+    {
+        const auto& model = zoneItems.GetModel(i);
+        const auto& clip = zoneItems.GetClip(i);
+        for (unsigned frame = 1; frame < *frameCount; frame++)
+        {
+            BAK::ZoneItem frameItem(model, clip, textures, frame);
+            meshes.emplace_back(
+                item.GetName() + "_f" + std::to_string(frame),
+                BAK::ZoneItemToMeshObject(frameItem, textures, palette));
+        }
+    }
+
+    return meshes;
+}
+
 }
 
 // Contains all the data one would need for a zone
 Zone::Zone(unsigned zoneNumber)
+:
+    Zone{zoneNumber, ThreadPool::Get()}
+{}
+
+Zone::Zone(unsigned zoneNumber, ThreadPool& pool)
+:
+    Zone{zoneNumber, pool, LoadSources(zoneNumber, pool)}
+{}
+
+// Textures come from the cache when it is enabled and up to date, and are
+// otherwise decoded in parallel
+Zone::Sources Zone::LoadSources(unsigned zoneNumber, ThreadPool& pool)
+{
+    auto stopwatch = Stopwatch{};
+    auto cache = ZoneAssetCache{
+        Paths::Get().GetZoneCacheDirectoryPath(),
+        ZoneLabel{zoneNumber}};
+    auto cached = cache.Load();
+    auto textures = cached
+        ? std::move(cached->mTextures)
+        : LoadZoneTextures(ZoneLabel{zoneNumber}, pool);
+    auto cachedObjects = cached
+        ? std::optional{std::move(cached->mObjects)}
+        : std::optional<Graphics::MeshObjectStorage>{};
+    const auto textureTime = stopwatch.Lap();
+    return Sources{
+        std::move(cache),
+        std::move(textures),
+        std::move(cachedObjects),
+        stopwatch,
+        textureTime};
+}
+
+// Items are loaded in parallel once the textures are packed. The tiles,
+// fixed objects and meshes only depend on those so are loaded together
+// after. Cached meshes are used as they are. The decoded textures are only
+// kept for as long as it takes to pack them and save them to the cache.
+Zone::Zone(unsigned zoneNumber, ThreadPool& pool, Sources sources)
 :
     mZoneLabel{zoneNumber},
-    mPalette{mZoneLabel.GetPalette()},
-    mFixedObjects{LoadFixedObjects(zoneNumber)},
-    mZoneTextures{mZoneLabel},
-    mZoneItems{mZoneLabel, mZoneTextures},
-    mWorldTiles{mZoneItems, BAK::Encounter::EncounterFactory{}},
+    mPalette{ResourceCache::Get().GetPalette(mZoneLabel.GetPalette())},
+    mFixedObjects{},
+    mZoneTextures{sources.mTextures},
+    mZoneItems{mZoneLabel, mZoneTextures, pool},
+    mWorldTiles{std::vector<World>{}},
     mObjects{}
 {
-    for (unsigned i = 0; i < mZoneItems.GetItems().size(); i++)
+    auto& stopwatch = sources.mStopwatch;
+    const auto itemTime = stopwatch.Lap();
+    auto& cachedObjects = sources.mCachedObjects;
+    if (cachedObjects)
     {
-        const auto& item = mZoneItems.GetItems()[i];
-        mObjects.AddObject(
-            item.GetName(),
-            BAK::ZoneItemToMeshObject(item, mZoneTextures, mPalette));
+        // Already in the atlas, and the cache is not written again
+        sources.mTextures.mTextures = {};
+    }
 
-        if (item.GetModelClip())
-        {
-            mObjects.AddObject(
-                BAK::GetClipName(item.GetName()),
-                ClipToMeshObject(
-                    *item.GetModelClip(),
-                    BAK::GetDebugColor(item.GetEntityType())));
-        }
+    const auto encounterFactory = BAK::Encounter::EncounterFactory{};
 
-        if (item.HasUndergroundModel())
-        {
-            mObjects.AddObject(
-                BAK::GetUndergroundName(item.GetName()),
-                BAK::ZoneItemToMeshObject(
-                    item.GetUndergroundModel(), mZoneTextures, mPalette));
-        }
+    auto fixedObjectsFuture = pool.Submit([zoneNumber]{
+        return LoadFixedObjects(zoneNumber); });
+    auto worldFutures = SubmitWorldTiles(mZoneItems, encounterFactory, pool);
+    auto meshFutures = pool.SubmitEach(
+        cachedObjects ? 0 : mZoneItems.GetItems().size(),
+        [this](std::size_t i){
+            return MakeZoneItemMeshes(
+                mZoneItems, mZoneTextures, *mPalette, i);
+        });
+
+    // Tasks refer to this zone and the encounter factory, so they must
+    // all be finished before an exception is allowed out. They run
+    // together, so each is timed by how much longer it took than those
+    // waited on before it.
+    fixedObjectsFuture.wait();
+    const auto fixedObjectTime = stopwatch.Lap();
+    ThreadPool::WaitAll(worldFutures);
+    const auto worldTileTime = stopwatch.Lap();
+    ThreadPool::WaitAll(meshFutures);
+    const auto meshTime = stopwatch.Lap();
 
-        const auto frameCount = mZoneItems.GetModelFrameCount(item.GetName());
-        if (frameCount)
+    mFixedObjects = fixedObjectsFuture.get();
+    mWorldTiles = WorldTileStore{ThreadPool::GetResults(worldFutures)};
+    auto itemMeshes = ThreadPool::GetResults(meshFutures);
+
+    // The cached storage already holds every mesh, so it is used as it is.
+    // Otherwise the item meshes and the debug meshes are all added before
+    // the storage is built, so that it is sized and filled once.
+    auto objects = Graphics::MeshObjectStorageBuilder{cachedObjects
+        ? std::move(*cachedObjects)
+        : Graphics::MeshObjectStorage{}};
+    for (auto& meshes : itemMeshes)
+    {
+        for (auto& [name, mesh] : meshes)
         {
-            const auto& model = mZoneItems.GetModel(i);
-            const auto& clip = mZoneItems.GetClip(i);
-            for (unsigned frame = 1; frame < *frameCount; frame++)
-            {
-                BAK::ZoneItem frameItem(model, clip, mZoneTextures, frame);
-                mObjects.AddObject(
-                    item.GetName() + "_f" + std::to_string(frame),
-                    BAK::ZoneItemToMeshObject(frameItem, mZoneTextures, mPalette));
-            }
+            objects.AddObject(std::move(name), std::move(mesh));
         }
     }
 
-    const auto cube = Graphics::Cuboid{1, 1, 50};
-    mObjects.AddObject("Combat", cube.ToMeshObject(glm::vec4{1.0, 0, 0, .3}));
-    mObjects.AddObject("Trap", cube.ToMeshObject(glm::vec4{.8, 0, 0, .3}));
-    mObjects.AddObject("Dialog", cube.ToMeshObject(glm::vec4{0.0, 1, 0, .3}));
-    mObjects.AddObject("Zone", cube.ToMeshObject(glm::vec4{1.0, 1, 0, .3}));
-    mObjects.AddObject("GDSEntry", cube.ToMeshObject(glm::vec4{1.0, 0, 1, .3}));
-    mObjects.AddObject("EventFlag", cube.ToMeshObject(glm::vec4{.0, .0, .7, .3}));
-    mObjects.AddObject("Block", cube.ToMeshObject(glm::vec4{0,0,0, .3}));
+    if (!cachedObjects)
+    {
+        const auto cube = Graphics::Cuboid{1, 1, 50};
+        objects.AddObject("Combat", cube.ToMeshObject(glm::vec4{1.0, 0, 0, .3}));
+        objects.AddObject("Trap", cube.ToMeshObject(glm::vec4{.8, 0, 0, .3}));
+        objects.AddObject("Dialog", cube.ToMeshObject(glm::vec4{0.0, 1, 0, .3}));
+        objects.AddObject("Zone", cube.ToMeshObject(glm::vec4{1.0, 1, 0, .3}));
+        objects.AddObject("GDSEntry", cube.ToMeshObject(glm::vec4{1.0, 0, 1, .3}));
+        objects.AddObject("EventFlag", cube.ToMeshObject(glm::vec4{.0, .0, .7, .3}));
+        objects.AddObject("Block", cube.ToMeshObject(glm::vec4{0,0,0, .3}));
 
-    const auto click = Graphics::Cuboid{1, 1, 50};
-    mObjects.AddObject("clickable", click.ToMeshObject(glm::vec4{1.0, 0, 0, .3}));
+        const auto click = Graphics::Cuboid{1, 1, 50};
+        objects.AddObject("clickable", click.ToMeshObject(glm::vec4{1.0, 0, 0, .3}));
+    }
 
-    // Grid visualization texture
+    // Grid visualization texture. It is added to the atlas after the
+    // zone's own textures, so it is never saved with them, but its place
+    // in the atlas and so its mesh are the same every time.
     {
         auto gridTex = Graphics::Texture{sGridTexSize, sGridTexSize, sGridTexSize, sGridTexSize};
         for (unsigned y = 0; y < sGridTexSize; y++)
@@ -127,11 +240,32 @@ Zone::Zone(unsigned zoneNumber)
                 gridTex.SetPixel(x, y, glm::vec4{1.0f, 1.0f, 1.0f, alpha + 0.03});
             }
         }
-        const auto gridLayer = mZoneTextures.GetTextures().size();
+        const auto gridTexture = mZoneTextures.size();
         gridTex.SetRepeat(false);
         mZoneTextures.AddTexture(gridTex);
-        mObjects.AddObject("GridCell", MakeGridQuadMesh(gridLayer));
+        if (!cachedObjects)
+        {
+            objects.AddObject("GridCell", MakeGridQuadMesh(mZoneTextures.GetAtlas(), gridTexture));
+        }
     }
+
+    mObjects = std::move(objects).Build();
+    const auto storageTime = stopwatch.Lap();
+    if (!cachedObjects)
+    {
+        sources.mCache.Save(sources.mTextures, mObjects);
+    }
+    const auto saveTime = stopwatch.Lap();
+
+    Logging::LogInfo("ZoneLoader") << mZoneLabel.GetZone() << " tiles: "
+        << mWorldTiles.GetTiles().size() << " meshes: " << mObjects.size()
+        << " vertices: " << mObjects.GetVertices().size()
+        << (cachedObjects ? " from cache" : " decoded")
+        << " on " << pool.GetThreadCount() << " threads in ms, textures: "
+        << sources.mTextureTime << " items: " << itemTime
+        << " fixed objects: " << fixedObjectTime << " tiles: " << worldTileTime
+        << " meshes: " << meshTime << " storage: " << storageTime
+        << " cache save: " << saveTime << "\n";
 }
 
 bool IsUnderground(ZoneNumber zone)
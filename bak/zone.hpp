@@ -5,14 +5,20 @@
 #include "bak/resourceNames.hpp"
 #include "bak/types.hpp"
 #include "bak/worldFactory.hpp"
-
+#include "bak/zoneAssetCache.hpp"
 
 #include "graphics/meshObject.hpp"
 
+#include "com/stopwatch.hpp"
+
 #include <glm/glm.hpp>
 
+#include <memory>
+#include <optional>
 #include <vector>
 
+class ThreadPool;
+
 namespace BAK {
 
 // Contains all the data one would need for a zone
@@ -20,14 +26,33 @@ class Zone
 {
 public:
     Zone(unsigned zoneNumber);
+    // Textures and item meshes come from the ZoneAssetCache when it is
+    // enabled and up to date
+    Zone(unsigned zoneNumber, ThreadPool& pool);
 
     ZoneLabel mZoneLabel;
-    Palette mPalette;
+    std::shared_ptr<const Palette> mPalette;
     std::vector<GenericContainer> mFixedObjects;
     ZoneTextureStore mZoneTextures;
     ZoneItemStore mZoneItems;
     WorldTileStore mWorldTiles;
     Graphics::MeshObjectStorage mObjects;
+
+private:
+    // The zone's cache, and what was loaded from it or else decoded
+    struct Sources
+    {
+        ZoneAssetCache mCache;
+        ZoneTextures mTextures;
+        // Only when loaded from the cache, then it holds every mesh
+        std::optional<Graphics::MeshObjectStorage> mCachedObjects;
+        Stopwatch mStopwatch;
+        double mTextureTime;
+    };
+
+    static Sources LoadSources(unsigned zoneNumber, ThreadPool& pool);
+
+    Zone(unsigned zoneNumber, ThreadPool& pool, Sources sources);
 };
 
 bool IsUnderground(ZoneNumber);
@@ -0,0 +1,461 @@
+#include "bak/zoneAssetCache.hpp"
+
+#include "bak/file/mappedFile.hpp"
+#include "bak/fileBufferFactory.hpp"
+
+#include "com/path.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace BAK {
+
+namespace {
+
+// "BZAC" in a little endian file
+constexpr std::uint32_t sMagic = 0x43415a42;
+// Arrays start on this boundary so that each is copied out of aligned memory
+constexpr std::size_t sAlignment = 16;
+
+static_assert(sizeof(Graphics::Pixel) == 4);
+
+struct Header
+{
+    std::uint32_t mMagic;
+    std::uint32_t mVersion;
+    std::uint64_t mSourceHash;
+    std::uint32_t mTextureCount;
+    std::uint32_t mTerrainOffset;
+    std::uint32_t mHorizonOffset;
+    std::uint32_t mObjectCount;
+    std::uint64_t mVertices;
+    std::uint64_t mIndices;
+};
+
+struct TextureRecord
+{
+    std::uint32_t mWidth;
+    std::uint32_t mHeight;
+    std::uint32_t mTargetWidth;
+    std::uint32_t mTargetHeight;
+    std::uint32_t mRepeat;
+    std::uint32_t mPixels;
+};
+
+struct ObjectRecord
+{
+    std::uint32_t mNameLength;
+    std::uint32_t mOffset;
+    std::uint32_t mLength;
+};
+
+// The word at a time hash rustc uses for its hash maps. The zone's data
+// files are hashed each time it is loaded, so this needs to be cheap.
+class WordHash
+{
+public:
+    void AddBytes(std::span<const std::uint8_t> bytes)
+    {
+        // The size goes first so that the zero padded tail is unambiguous
+        AddWord(bytes.size());
+        auto i = std::size_t{0};
+        for (; i + sizeof(std::uint64_t) <= bytes.size(); i += sizeof(std::uint64_t))
+        {
+            auto word = std::uint64_t{};
+            std::memcpy(&word, bytes.data() + i, sizeof(word));
+            AddWord(word);
+        }
+        if (i < bytes.size())
+        {
+            auto word = std::uint64_t{};
+            std::memcpy(&word, bytes.data() + i, bytes.size() - i);
+            AddWord(word);
+        }
+    }
+
+    template <typename T> requires std::is_trivially_copyable_v<T>
+    void Add(const T& value)
+    {
+        AddBytes({reinterpret_cast<const std::uint8_t*>(&value), sizeof(T)});
+    }
+
+    void AddString(const std::string& value)
+    {
+        AddBytes({reinterpret_cast<const std::uint8_t*>(value.data()), value.size()});
+    }
+
+    std::uint64_t Get() const { return mHash; }
+
+private:
+    void AddWord(std::uint64_t word)
+    {
+        mHash = (std::rotl(mHash, 5) ^ word) * 0x517cc1b727220a95ull;
+    }
+
+    std::uint64_t mHash{0};
+};
+
+class Writer
+{
+public:
+    void WriteBytes(const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+    }
+
+    template <typename T>
+    void Write(const T& value)
+    {
+        WriteBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void WriteArray(const std::vector<T>& values)
+    {
+        Align();
+        WriteBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void Align()
+    {
+        mBuffer.resize((mBuffer.size() + sAlignment - 1) / sAlignment * sAlignment, 0);
+    }
+
+    const std::vector<std::uint8_t>& GetBuffer() const { return mBuffer; }
+
+private:
+    std::vector<std::uint8_t> mBuffer{};
+};
+
+class Reader
+{
+public:
+    Reader(const std::uint8_t* data, std::size_t size)
+    :
+        mData{data},
+        mSize{size},
+        mPosition{0}
+    {}
+
+    template <typename T>
+    T Read()
+    {
+        T value;
+        std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void ReadArray(std::vector<T>& values, std::size_t count)
+    {
+        Align();
+        values.resize(count);
+        const auto* data = Take(count * sizeof(T));
+        if (count > 0)
+        {
+            std::memcpy(values.data(), data, count * sizeof(T));
+        }
+    }
+
+    std::string ReadString(std::size_t length)
+    {
+        const auto* data = Take(length);
+        return std::string{reinterpret_cast<const char*>(data), length};
+    }
+
+    void Align()
+    {
+        mPosition = std::min(
+            (mPosition + sAlignment - 1) / sAlignment * sAlignment,
+            mSize);
+    }
+
+private:
+    const std::uint8_t* Take(std::size_t size)
+    {
+        if (size > mSize - mPosition)
+        {
+            throw std::runtime_error("Zone asset cache is truncated");
+        }
+        const auto* data = mData + mPosition;
+        mPosition += size;
+        return data;
+    }
+
+    const std::uint8_t* mData;
+    std::size_t mSize;
+    std::size_t mPosition;
+};
+
+// Sprites can be replaced by files in the mod directory. It is only read
+// at startup, so its files are listed once per session, not once per zone.
+std::uint64_t HashModDirectory(const std::filesystem::path& modDirectory)
+{
+    auto hash = WordHash{};
+    if (modDirectory.empty() || !std::filesystem::is_directory(modDirectory))
+    {
+        return hash.Get();
+    }
+
+    std::vector<std::filesystem::path> files{};
+    for (const auto& entry : std::filesystem::recursive_directory_iterator{modDirectory})
+    {
+        if (entry.is_regular_file())
+        {
+            files.emplace_back(entry.path());
+        }
+    }
+    std::ranges::sort(files);
+
+    for (const auto& file : files)
+    {
+        hash.AddString(std::filesystem::relative(file, modDirectory).generic_string());
+        hash.Add(std::filesystem::file_size(file));
+        hash.Add(std::filesystem::last_write_time(file).time_since_epoch().count());
+    }
+    return hash.Get();
+}
+
+std::uint64_t GetModDirectoryHash()
+{
+    static std::mutex sMutex{};
+    static std::map<std::filesystem::path, std::uint64_t> sHashes{};
+
+    const auto modDirectory = Paths::Get().GetModDirectoryPath();
+    auto lock = std::unique_lock{sMutex};
+    auto it = sHashes.find(modDirectory);
+    if (it == sHashes.end())
+    {
+        it = sHashes.emplace(modDirectory, HashModDirectory(modDirectory)).first;
+    }
+    return it->second;
+}
+
+}
+
+ZoneAssetCache::ZoneAssetCache(
+    std::filesystem::path directory,
+    const ZoneLabel& zoneLabel)
+:
+    mPath{},
+    mZoneLabel{zoneLabel},
+    mSourceHash{0},
+    mLogger{Logging::LogState::GetLogger("ZoneAssetCache")}
+{
+    if (directory.empty())
+    {
+        return;
+    }
+
+    try
+    {
+        mSourceHash = HashSources();
+        mPath = directory / (mZoneLabel.GetZone() + ".ZAC");
+    }
+    catch (const std::exception& e)
+    {
+        mLogger.Error() << "Not caching " << mZoneLabel.GetZone()
+            << ", couldn't hash its sources: " << e.what() << "\n";
+    }
+}
+
+bool ZoneAssetCache::IsEnabled() const
+{
+    return !mPath.empty();
+}
+
+std::optional<ZoneAssets> ZoneAssetCache::Load() const
+{
+    if (!IsEnabled() || !std::filesystem::exists(mPath))
+    {
+        return std::nullopt;
+    }
+
+    try
+    {
+        const auto file = File::MappedFile{mPath.string()};
+        const auto fb = file.GetFileBuffer();
+        auto reader = Reader{fb.GetCurrent(), file.GetSize()};
+
+        const auto header = reader.Read<Header>();
+        if (header.mMagic != sMagic
+            || header.mVersion != sVersion
+            || header.mSourceHash != mSourceHash)
+        {
+            mLogger.Info() << "Ignoring stale cache: " << mPath << "\n";
+            return std::nullopt;
+        }
+
+        std::vector<TextureRecord> textureRecords{};
+        for (unsigned i = 0; i < header.mTextureCount; i++)
+        {
+            textureRecords.emplace_back(reader.Read<TextureRecord>());
+        }
+
+        auto textures = std::vector<Graphics::Texture>{};
+        for (const auto& record : textureRecords)
+        {
+            auto pixels = Graphics::Texture::TextureType{};
+            reader.ReadArray(pixels, record.mPixels);
+            auto& texture = textures.emplace_back(
+                std::move(pixels),
+                record.mWidth,
+                record.mHeight,
+                record.mTargetWidth,
+                record.mTargetHeight);
+            texture.SetRepeat(record.mRepeat != 0);
+        }
+
+        auto objects = Graphics::MeshObjectStorage::Objects{};
+        objects.reserve(header.mObjectCount);
+        for (unsigned i = 0; i < header.mObjectCount; i++)
+        {
+            const auto record = reader.Read<ObjectRecord>();
+            auto name = reader.ReadString(record.mNameLength);
+            objects.emplace(
+                std::move(name),
+                std::make_pair(record.mOffset, record.mLength));
+        }
+
+        auto vertices = std::vector<Graphics::Vertex>{};
+        auto indices = std::vector<unsigned>{};
+        reader.ReadArray(vertices, header.mVertices);
+        reader.ReadArray(indices, header.mIndices);
+
+        auto assets = ZoneAssets{
+            ZoneTextures{
+                std::move(textures),
+                header.mTerrainOffset,
+                header.mHorizonOffset},
+            Graphics::MeshObjectStorage{
+                std::move(objects),
+                std::move(vertices),
+                std::move(indices)}};
+
+        mLogger.Info() << "Loaded " << mZoneLabel.GetZone() << " from: " << mPath
+            << " textures: " << assets.mTextures.mTextures.size()
+            << " meshes: " << assets.mObjects.size() << "\n";
+        return assets;
+    }
+    catch (const std::exception& e)
+    {
+        mLogger.Error() << "Failed to read cache: " << mPath << " " << e.what() << "\n";
+        return std::nullopt;
+    }
+}
+
+void ZoneAssetCache::Save(
+    const ZoneTextures& textures,
+    const Graphics::MeshObjectStorage& objects) const
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    auto writer = Writer{};
+    writer.Write(Header{
+        sMagic,
+        sVersion,
+        mSourceHash,
+        static_cast<std::uint32_t>(textures.mTextures.size()),
+        textures.mTerrainOffset,
+        textures.mHorizonOffset,
+        static_cast<std::uint32_t>(objects.size()),
+        objects.GetVertices().size(),
+        objects.GetIndices().size()});
+
+    for (const auto& texture : textures.mTextures)
+    {
+        writer.Write(TextureRecord{
+            texture.GetWidth(),
+            texture.GetHeight(),
+            texture.GetTargetWidth(),
+            texture.GetTargetHeight(),
+            texture.GetRepeat(),
+            static_cast<std::uint32_t>(texture.GetTexture().size())});
+    }
+
+    for (const auto& texture : textures.mTextures)
+    {
+        writer.WriteArray(texture.GetTexture());
+    }
+
+    for (const auto& [name, offsetAndLength] : objects.GetObjects())
+    {
+        writer.Write(ObjectRecord{
+            static_cast<std::uint32_t>(name.size()),
+            offsetAndLength.first,
+            offsetAndLength.second});
+        writer.WriteBytes(name.data(), name.size());
+    }
+
+    writer.WriteArray(objects.GetVertices());
+    writer.WriteArray(objects.GetIndices());
+
+    // Written aside and renamed over so a crash never leaves a partial file
+    try
+    {
+        std::filesystem::create_directories(mPath.parent_path());
+        auto tempPath = mPath;
+        tempPath += ".tmp";
+        {
+            const auto& buffer = writer.GetBuffer();
+            auto out = std::ofstream{tempPath, std::ios::binary | std::ios::trunc};
+            out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+            out.close();
+            if (!out)
+            {
+                throw std::runtime_error("Failed to write: " + tempPath.string());
+            }
+        }
+        std::filesystem::rename(tempPath, mPath);
+        mLogger.Info() << "Saved " << mZoneLabel.GetZone() << " to: " << mPath
+            << " (" << writer.GetBuffer().size() / 1024 << "KiB)\n";
+    }
+    catch (const std::exception& e)
+    {
+        mLogger.Error() << "Failed to save cache: " << mPath << " " << e.what() << "\n";
+    }
+}
+
+std::uint64_t ZoneAssetCache::HashSources() const
+{
+    auto hash = WordHash{};
+    hash.Add(sVersion);
+
+    auto& factory = FileBufferFactory::Get();
+    const auto AddDataFile = [&](const std::string& name)
+    {
+        hash.AddString(name);
+        if (factory.DataBufferExists(name))
+        {
+            auto fb = factory.CreateDataBuffer(name);
+            hash.AddBytes({fb.GetCurrent(), fb.GetBytesLeft()});
+        }
+    };
+
+    AddDataFile(mZoneLabel.GetPalette());
+    AddDataFile(mZoneLabel.GetTerrain());
+    for (unsigned i = 0; factory.DataBufferExists(mZoneLabel.GetSpriteSlot(i)); i++)
+    {
+        AddDataFile(mZoneLabel.GetSpriteSlot(i));
+    }
+    AddDataFile(mZoneLabel.GetTable());
+    AddDataFile(mZoneLabel.GetTableUnderground());
+
+    hash.Add(GetModDirectoryHash());
+
+    return hash.Get();
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "bak/resourceNames.hpp"
+#include "bak/worldFactory.hpp"
+
+#include "com/logger.hpp"
+
+#include "graphics/meshObject.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace BAK {
+
+// What a zone decodes from its data files before it can be drawn
+struct ZoneAssets
+{
+    ZoneTextures mTextures;
+    Graphics::MeshObjectStorage mObjects;
+};
+
+// Keeps a zone's decoded textures and its meshes in a file of their own,
+// so that loading the zone again only has to map the file and copy them
+// out, with nothing to decode. Arrays in the file are aligned and laid out
+// as they are held in memory, so each is copied out with one memcpy.
+//
+// Each file records a hash of the zone's data files and of the mod
+// directory, and is ignored once either has changed. The mod directory is
+// only listed the first time it is used in a session.
+class ZoneAssetCache
+{
+public:
+    static constexpr std::uint32_t sVersion = 3;
+
+    // Disabled when the directory is empty
+    ZoneAssetCache(
+        std::filesystem::path directory,
+        const ZoneLabel& zoneLabel);
+
+    bool IsEnabled() const;
+
+    // Nothing if the file is missing, stale or unreadable
+    std::optional<ZoneAssets> Load() const;
+    // Failures are logged, the zone is usable without its cache
+    void Save(
+        const ZoneTextures& textures,
+        const Graphics::MeshObjectStorage& objects) const;
+
+private:
+    std::uint64_t HashSources() const;
+
+    std::filesystem::path mPath;
+    ZoneLabel mZoneLabel;
+    std::uint64_t mSourceHash;
+    const Logging::Logger& mLogger;
+};
+
+}
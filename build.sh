@@ -16,6 +16,7 @@ for arg in "$@"; do
     -DFETCHCONTENT_SOURCE_DIR_LUA=$DEPS_DIR/lua \
     -DFETCHCONTENT_SOURCE_DIR_LUABRIDGE3=$DEPS_DIR/LuaBridge3 \
     -DFETCHCONTENT_SOURCE_DIR_GOOGLETEST=$DEPS_DIR/googletest \
+    -DFETCHCONTENT_SOURCE_DIR_GOOGLEBENCHMARK=$DEPS_DIR/benchmark \
     -DFETCHCONTENT_SOURCE_DIR_AUDIOCODECS=$DEPS_DIR/AudioCodecs \
     -DFETCHCONTENT_SOURCE_DIR_SDLMIXERX=$DEPS_DIR/SDL-Mixer-X \
     "
@@ -0,0 +1,183 @@
+#include "com/asyncLogSink.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace Logging {
+
+AsyncLogSink::AsyncLogSink(std::ostream& output, std::size_t slotCount)
+:
+    mOutput{output},
+    mSlotCount{std::bit_ceil(std::max(slotCount, sMaxLineSlots))},
+    mSlots{std::make_unique<Slot[]>(mSlotCount)},
+    mEnqueuePos{0},
+    mWrittenPos{0},
+    mDropped{0},
+    mStopping{false},
+    mWakeups{0},
+    mReadPos{0},
+    mReportedDropped{0},
+    mBatch{},
+    mThread{}
+{
+    for (std::size_t i = 0; i < mSlotCount; i++)
+    {
+        mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+    }
+    mThread = std::thread{[this]{ Run(); }};
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+    mStopping.store(true, std::memory_order_release);
+    Wake();
+    mThread.join();
+}
+
+bool AsyncLogSink::Push(std::string_view line)
+{
+    const auto slots = std::clamp<std::size_t>(
+        (line.size() + sSlotSize - 1) / sSlotSize, 1, sMaxLineSlots);
+    line = line.substr(0, slots * sSlotSize);
+
+    const auto mask = mSlotCount - 1;
+    auto pos = mEnqueuePos.load(std::memory_order_relaxed);
+    while (true)
+    {
+        // The writer frees slots in order, so if the last slot is free
+        // then so are the ones before it
+        const auto last = pos + slots - 1;
+        const auto sequence = mSlots[last & mask].mSequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::int64_t>(sequence - last);
+        if (diff == 0)
+        {
+            if (mEnqueuePos.compare_exchange_weak(
+                pos, pos + slots, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            mDropped.fetch_add(1, std::memory_order_relaxed);
+            Wake();
+            return false;
+        }
+        else
+        {
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    for (std::size_t i = 0; i < slots; i++)
+    {
+        auto& slot = mSlots[(pos + i) & mask];
+        const auto part = line.substr(i * sSlotSize, sSlotSize);
+        std::memcpy(slot.mData.data(), part.data(), part.size());
+        slot.mLength = part.size();
+        slot.mRemaining = slots - i - 1;
+        slot.mSequence.store(pos + i + 1, std::memory_order_release);
+    }
+
+    Wake();
+    return true;
+}
+
+void AsyncLogSink::Flush()
+{
+    const auto target = mEnqueuePos.load(std::memory_order_acquire);
+    auto written = mWrittenPos.load(std::memory_order_acquire);
+    while (written < target)
+    {
+        mWrittenPos.wait(written, std::memory_order_acquire);
+        written = mWrittenPos.load(std::memory_order_acquire);
+    }
+}
+
+std::uint64_t AsyncLogSink::GetDroppedCount() const
+{
+    return mDropped.load(std::memory_order_relaxed);
+}
+
+bool AsyncLogSink::WriteBatch()
+{
+    const auto mask = mSlotCount - 1;
+    const auto isPublished = [&](std::uint64_t pos){
+        return mSlots[pos & mask].mSequence.load(std::memory_order_acquire) == pos + 1;
+    };
+
+    mBatch.clear();
+    auto pos = mReadPos;
+    while (isPublished(pos))
+    {
+        // Wait for the rest of a line whose producer has not finished
+        // writing it until the next batch
+        const auto slots = mSlots[pos & mask].mRemaining + 1;
+        bool complete = true;
+        for (std::size_t i = 1; i < slots; i++)
+        {
+            complete = complete && isPublished(pos + i);
+        }
+        if (!complete)
+        {
+            break;
+        }
+
+        for (std::size_t i = 0; i < slots; i++)
+        {
+            auto& slot = mSlots[(pos + i) & mask];
+            mBatch.append(slot.mData.data(), slot.mLength);
+            slot.mSequence.store(pos + i + mSlotCount, std::memory_order_release);
+        }
+        pos += slots;
+    }
+
+    const auto dropped = mDropped.load(std::memory_order_relaxed);
+    if (dropped != mReportedDropped)
+    {
+        mBatch += "WARN [AsyncLogSink] Dropped "
+            + std::to_string(dropped - mReportedDropped) + " log lines\n";
+        mReportedDropped = dropped;
+    }
+
+    if (!mBatch.empty())
+    {
+        mOutput.write(mBatch.data(), mBatch.size());
+        mOutput.flush();
+    }
+
+    if (pos == mReadPos)
+    {
+        return !mBatch.empty();
+    }
+
+    mReadPos = pos;
+    mWrittenPos.store(pos, std::memory_order_release);
+    mWrittenPos.notify_all();
+    return true;
+}
+
+void AsyncLogSink::Wake()
+{
+    mWakeups.fetch_add(1, std::memory_order_release);
+    mWakeups.notify_one();
+}
+
+void AsyncLogSink::Run()
+{
+    while (!mStopping.load(std::memory_order_acquire))
+    {
+        // Read before looking for lines, so that a push after the look
+        // changes it and the wait returns straight away
+        const auto wakeups = mWakeups.load(std::memory_order_acquire);
+        if (!WriteBatch())
+        {
+            mWakeups.wait(wakeups, std::memory_order_acquire);
+        }
+    }
+
+    while (WriteBatch()) {}
+}
+
+}
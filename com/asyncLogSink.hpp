@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace Logging {
+
+// Bounded multi producer, single consumer queue of log lines which a
+// background thread writes to the output in batches.
+//
+// A line takes one or more consecutive fixed size slots, all claimed with
+// a single compare and swap, so Push never blocks or allocates. When the
+// queue is full the line is dropped and counted, and the count is written
+// out once there is room. Lines longer than sMaxLineSlots slots are
+// truncated.
+class AsyncLogSink
+{
+public:
+    static constexpr std::size_t sSlotSize = 120;
+    static constexpr std::size_t sMaxLineSlots = 32;
+
+    // slotCount is rounded up to a power of two
+    AsyncLogSink(std::ostream& output, std::size_t slotCount);
+    ~AsyncLogSink();
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+    AsyncLogSink(AsyncLogSink&&) = delete;
+    AsyncLogSink& operator=(AsyncLogSink&&) = delete;
+
+    // Returns false if the line was dropped
+    bool Push(std::string_view line);
+
+    // Blocks until every line pushed before the call has been written
+    void Flush();
+
+    std::uint64_t GetDroppedCount() const;
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> mSequence;
+        std::uint32_t mLength;
+        // Slots after this one that belong to the same line
+        std::uint32_t mRemaining;
+        std::array<char, sSlotSize> mData;
+    };
+
+    bool WriteBatch();
+    void Wake();
+    void Run();
+
+    std::ostream& mOutput;
+    std::size_t mSlotCount;
+    std::unique_ptr<Slot[]> mSlots;
+
+    alignas(64) std::atomic<std::uint64_t> mEnqueuePos;
+    alignas(64) std::atomic<std::uint64_t> mWrittenPos;
+    std::atomic<std::uint64_t> mDropped;
+    std::atomic<bool> mStopping;
+    // Bumped after each push so the idle writer waits on it rather than
+    // polling. 32 bits so that waiting is a plain futex.
+    alignas(64) std::atomic<std::uint32_t> mWakeups;
+
+    // Only touched by the writer thread
+    std::uint64_t mReadPos;
+    std::uint64_t mReportedDropped;
+    std::string mBatch;
+
+    std::thread mThread;
+};
+
+}
@@ -0,0 +1,65 @@
+#include "benchmark/benchmark.h"
+
+#include "com/logger.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// Measures how long a single log statement blocks the calling thread,
+// writing to a log file as main3d does, with and without the async sink.
+//
+// Usage: logBenchmark [benchmark flags] [log file]
+
+namespace {
+
+void BM_Log(benchmark::State& state, bool async)
+{
+    Logging::LogState::SetAsync(async);
+    const auto& logger = Logging::LogState::GetLogger("logBenchmark");
+
+    unsigned i = 0;
+    for (auto _ : state)
+    {
+        logger.Info() << "Frame: " << i++ << " position: " << 1234.5f
+            << " heading: " << 42 << "\n";
+    }
+
+    // Writing out the backlog is not on the calling thread, so is not timed
+    Logging::LogState::Flush();
+    state.counters["dropped"] = Logging::LogState::GetDroppedCount();
+    Logging::LogState::SetAsync(false);
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    const auto logPath = argc > 1
+        ? std::filesystem::path{argv[1]}
+        : std::filesystem::temp_directory_path() / "logBenchmark.log";
+    auto logFile = std::ofstream{logPath, std::ios::out};
+    if (!logFile.is_open())
+    {
+        std::cerr << "Could not open log file: " << logPath << "\n";
+        return 1;
+    }
+
+    Logging::LogState::SetLevel(Logging::LogLevel::Info);
+    Logging::LogState::RemoveStream(&std::cout);
+    Logging::LogState::AddStream(&logFile);
+
+    benchmark::RegisterBenchmark("LogSync", BM_Log, false);
+    benchmark::RegisterBenchmark("LogAsync", BM_Log, true);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    Logging::LogState::RemoveStream(&logFile);
+    Logging::LogState::AddStream(&std::cout);
+    return 0;
+}
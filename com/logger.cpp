@@ -1,6 +1,11 @@
 #include "com/logger.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 namespace Logging {
 
@@ -34,19 +39,267 @@ std::string_view LevelToColor(LogLevel level)
     }
 }
 
-LogLevel LogState::sGlobalLogLevel{LogLevel::Info};
+std::atomic<LogLevel> LogState::sGlobalLogLevel{LogLevel::Info};
 std::string LogState::sTimeFormat{"%H:%M:%S.%m"};
 bool LogState::sLogTime{true};
 bool LogState::sLogColor{false};
 
 std::vector<std::string> LogState::sEnabledLoggers{};
 std::vector<std::string> LogState::sDisabledLoggers{};
+std::mutex LogState::sFilterMutex{};
+std::atomic<std::uint32_t> LogState::sGeneration{1};
 std::vector<std::unique_ptr<Logger>> LogState::sLoggers{};
+std::mutex LogState::sLoggersMutex{};
 OStreamMux LogState::sMux{};
 std::ostream LogState::sOutput{&LogState::sMux};
+std::mutex LogState::sOutputMutex{};
+
+std::unique_ptr<AsyncLogSink> LogState::sAsyncSink{};
 
 std::ostream LogState::nullStream{nullptr};
 
+namespace {
+
+// Enough for every line logged in a few frames at Debug
+static constexpr std::size_t sAsyncSlots = 8192;
+
+// Collects a log line on the logging thread and, once complete, hands it
+// to the async sink or writes it to the output under the lock, so the
+// line is never interleaved with another thread's.
+class LineBuffer : public std::streambuf
+{
+public:
+    using WriteLine = void(*)(std::string_view);
+
+    LineBuffer()
+    :
+        mSink{nullptr},
+        mWrite{nullptr},
+        mLevel{LogLevel::Info},
+        mLine{}
+    {}
+
+    void BeginLine(AsyncLogSink* sink, WriteLine write, LogLevel level)
+    {
+        mSink = sink;
+        mWrite = write;
+        mLevel = level;
+    }
+
+    std::streamsize xsputn(const char_type* s, std::streamsize n) override
+    {
+        const auto str = std::string_view{s, static_cast<std::size_t>(n)};
+        std::size_t from = 0;
+        for (auto end = str.find('\n'); end != str.npos; end = str.find('\n', from))
+        {
+            mLine.append(str.substr(from, end + 1 - from));
+            EndLine();
+            from = end + 1;
+        }
+        mLine.append(str.substr(from));
+        return n;
+    }
+
+    int_type overflow(int_type c) override
+    {
+        if (c == traits_type::eof())
+        {
+            return traits_type::not_eof(c);
+        }
+
+        mLine.push_back(static_cast<char>(c));
+        if (c == '\n')
+        {
+            EndLine();
+        }
+        return c;
+    }
+
+    // Explicit flushes write out a line that has not been ended
+    int sync() override
+    {
+        if (!mLine.empty())
+        {
+            EndLine();
+        }
+        return 0;
+    }
+
+private:
+    void EndLine()
+    {
+        if (!mSink)
+        {
+            mWrite(mLine);
+        }
+        else if (mLevel >= LogLevel::Fatal)
+        {
+            // Never dropped, and written before we return
+            while (!mSink->Push(mLine))
+            {
+                mSink->Flush();
+            }
+            mSink->Flush();
+        }
+        else
+        {
+            mSink->Push(mLine);
+        }
+        mLine.clear();
+    }
+
+    AsyncLogSink* mSink;
+    WriteLine mWrite;
+    LogLevel mLevel;
+    std::string mLine;
+};
+
+// Set once this thread's line stream is destroyed, so that logging from
+// the destructors of statics that outlive it still has somewhere to go
+thread_local bool tLineStreamDestroyed{false};
+
+struct LineStream
+{
+    LineStream()
+    :
+        mBuffer{},
+        mStream{&mBuffer}
+    {}
+
+    ~LineStream()
+    {
+        tLineStreamDestroyed = true;
+    }
+
+    LineBuffer mBuffer;
+    std::ostream mStream;
+};
+
+thread_local LineStream tLineStream{};
+
+// Only reformats the time when the second changes
+std::string_view FormatTime(const std::string& format)
+{
+    thread_local std::time_t tLastTime{-1};
+    thread_local std::string tLastFormat{};
+    thread_local std::string tFormatted{};
+
+    const auto time = std::chrono::system_clock::to_time_t(
+        std::chrono::system_clock::now());
+    if (time != tLastTime || format != tLastFormat)
+    {
+        auto gmt_time = tm{};
+#if defined(_WIN32)
+        gmtime_s(&gmt_time , &time);
+#else
+        gmtime_r(&time, &gmt_time);
+#endif
+        auto ss = std::stringstream{};
+        ss << std::put_time(&gmt_time, format.c_str()) << " ";
+        tFormatted = ss.str();
+        tLastTime = time;
+        tLastFormat = format;
+    }
+    return tFormatted;
+}
+
+}
+
+void LogState::Disable(const std::string& logger)
+{
+    auto lock = std::unique_lock{sFilterMutex};
+    sDisabledLoggers.emplace_back(logger);
+    sGeneration++;
+}
+
+void LogState::Enable(const std::string& logger)
+{
+    auto lock = std::unique_lock{sFilterMutex};
+    sEnabledLoggers.emplace_back(logger);
+    sGeneration++;
+}
+
+bool LogState::IsLoggerEnabled(const std::string& loggerName)
+{
+    auto lock = std::unique_lock{sFilterMutex};
+    if (!sEnabledLoggers.empty())
+    {
+        const auto it = std::find(
+            sEnabledLoggers.begin(), sEnabledLoggers.end(),
+            loggerName);
+        return it != sEnabledLoggers.end();
+    }
+    else
+    {
+        const auto it = std::find(
+            sDisabledLoggers.begin(), sDisabledLoggers.end(),
+            loggerName);
+        return it == sDisabledLoggers.end();
+    }
+}
+
+std::ostream& LogState::DoLog(LogLevel level, const std::string& loggerName)
+{
+    // Every thread formats into its own line, so only whole lines are
+    // ever written to the shared output
+    auto* output = &sOutput;
+    if (!tLineStreamDestroyed)
+    {
+        tLineStream.mBuffer.BeginLine(
+            sAsyncSink.get(),
+            [](std::string_view line){
+                auto lock = std::unique_lock{sOutputMutex};
+                sOutput.write(line.data(), line.size());
+            },
+            level);
+        output = &tLineStream.mStream;
+    }
+
+    if (sLogTime)
+    {
+        *output << FormatTime(sTimeFormat);
+    }
+    if (sLogColor)
+    {
+        *output << LevelToColor(level);
+    }
+
+    *output << LevelToString(level) << " [" << loggerName << "] ";
+    if (sLogColor)
+    {
+        *output << "\033[0m ";
+    }
+
+    return *output;
+}
+
+void LogState::SetAsync(bool value)
+{
+    if (value && !sAsyncSink)
+    {
+        sAsyncSink = std::make_unique<AsyncLogSink>(sOutput, sAsyncSlots);
+    }
+    else if (!value)
+    {
+        sAsyncSink.reset();
+    }
+}
+
+void LogState::Flush()
+{
+    if (sAsyncSink)
+    {
+        sAsyncSink->Flush();
+    }
+    auto lock = std::unique_lock{sOutputMutex};
+    sOutput.flush();
+}
+
+std::uint64_t LogState::GetDroppedCount()
+{
+    return sAsyncSink ? sAsyncSink->GetDroppedCount() : 0;
+}
+
 std::ostream& LogFatal(const std::string& loggerName)
 {
     return LogState::Log(Logging::LogLevel::Fatal, loggerName);
@@ -1,12 +1,16 @@
 #pragma once
 
+#include "com/asyncLogSink.hpp"
 #include "com/ostreamMux.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -27,24 +31,26 @@ enum class LogLevel
 std::string_view LevelToString(LogLevel level);
 std::string_view LevelToColor(LogLevel level);
 
+// Log statements below this level are compiled out of the LOG_* macros
+// and never reach the log. Set with -DBAK_MIN_LOG_LEVEL=Info etc.
+#ifndef BAK_MIN_LOG_LEVEL
+#define BAK_MIN_LOG_LEVEL Spam
+#endif
+
+inline constexpr auto gMinLogLevel = LogLevel::BAK_MIN_LOG_LEVEL;
+
 class Logger;
 
 class LogState
 {
 public:
-    static void Disable(const std::string& logger)
-    {
-        sDisabledLoggers.emplace_back(logger);
-    }
-
-    static void Enable(const std::string& logger)
-    {
-        sEnabledLoggers.emplace_back(logger);
-    }
+    // Loggers can be enabled and disabled while other threads log
+    static void Disable(const std::string& logger);
+    static void Enable(const std::string& logger);
 
     static void SetLevel(LogLevel level)
     {
-        sGlobalLogLevel = level;
+        sGlobalLogLevel.store(level, std::memory_order_relaxed);
     }
 
     static void SetLevel(std::string_view level)
@@ -85,28 +91,35 @@ public:
         sLogColor = value;
     }
 
+    static bool IsLevelEnabled(LogLevel level)
+    {
+        return level >= gMinLogLevel
+            && level >= sGlobalLogLevel.load(std::memory_order_relaxed);
+    }
+
+    static bool IsLoggerEnabled(const std::string& loggerName);
+
+    // Changes whenever a logger is enabled or disabled
+    static std::uint32_t GetGeneration()
+    {
+        return sGeneration.load(std::memory_order_relaxed);
+    }
+
     static std::ostream& Log(LogLevel level, const std::string& loggerName)
     {
-        if (level < sGlobalLogLevel)
+        if (!IsLevelEnabled(level) || !IsLoggerEnabled(loggerName))
             return nullStream;
 
-        if (!sEnabledLoggers.empty())
-        {
-            const auto it = std::find(
-                sEnabledLoggers.begin(), sEnabledLoggers.end(),
-                loggerName);
-            if (it == sEnabledLoggers.end())
-                return nullStream;
-        }
-        else
-        {
-            const auto it = std::find(
-                sDisabledLoggers.begin(), sDisabledLoggers.end(),
-                loggerName);
-            if (it != sDisabledLoggers.end())
-                return nullStream;
-        }
+        return DoLog(level, loggerName);
+    }
+
+    static std::ostream& GetNullStream()
+    {
+        return nullStream;
+    }
 
+    static std::ostream& LogEnabled(LogLevel level, const std::string& loggerName)
+    {
         return DoLog(level, loggerName);
     }
     
@@ -116,6 +129,7 @@ public:
     template <typename T>
     static const T& GetLoggerT(const std::string& name)
     {
+        auto lock = std::unique_lock{sLoggersMutex};
         const auto it = std::find_if(sLoggers.begin(), sLoggers.end(),
             [&name](const auto& l){ return l->GetName() == name; });
         if (it == sLoggers.end())
@@ -128,6 +142,17 @@ public:
         }
     }
 
+    // Writes log lines from a background thread rather than the logging
+    // thread. Must not be changed while other threads are logging.
+    // Disabling waits for the queued lines to be written.
+    static void SetAsync(bool value);
+
+    // Waits for every line logged so far to be written
+    static void Flush();
+
+    // Lines the async sink had no room for
+    static std::uint64_t GetDroppedCount();
+
     static void AddStream(std::ostream* stream)
     {
         sMux.AddStream(stream);
@@ -139,44 +164,24 @@ public:
     }
 
 private:
-    static std::ostream& DoLog(LogLevel level, const std::string& loggerName)
-    {
-        if (sLogTime)
-        {
-            const auto t = std::chrono::system_clock::now();
-            const auto time = std::chrono::system_clock::to_time_t(t);
-            auto gmt_time = tm{};
-#if defined(_WIN32)
-            gmtime_s(&gmt_time , &time);
-#else
-            gmtime_r(&time, &gmt_time);
-#endif
-            sOutput << std::put_time(&gmt_time, sTimeFormat.c_str()) << " ";
-        }
-        if (sLogColor)
-        {
-            sOutput << LevelToColor(level);
-        }
-
-        sOutput << LevelToString(level) << " [" << loggerName << "] ";
-        if (sLogColor)
-        {
-             sOutput << "\033[0m ";
-        }
-
-        return sOutput;
-    }
+    static std::ostream& DoLog(LogLevel level, const std::string& loggerName);
 
-    static LogLevel sGlobalLogLevel;
+    static std::atomic<LogLevel> sGlobalLogLevel;
     static std::string sTimeFormat;
     static bool sLogTime;
     static bool sLogColor;
 
     static std::vector<std::string> sEnabledLoggers;
     static std::vector<std::string> sDisabledLoggers;
+    static std::mutex sFilterMutex;
+    static std::atomic<std::uint32_t> sGeneration;
     static std::vector<std::unique_ptr<Logger>> sLoggers;
+    static std::mutex sLoggersMutex;
     static OStreamMux sMux;
+    // Only written a whole line at a time, by one thread at a time
     static std::ostream sOutput;
+    static std::mutex sOutputMutex;
+    static std::unique_ptr<AsyncLogSink> sAsyncSink;
 
     static std::ostream nullStream;
 };
@@ -187,13 +192,45 @@ class Logger
 public:
     Logger(std::string name)
     :
-        mName{name}
+        mName{name},
+        mEnabledCache{0}
     {
     }
 
+    Logger(const Logger& other)
+    :
+        mName{other.mName},
+        mEnabledCache{0}
+    {
+    }
+
+    Logger& operator=(const Logger& other)
+    {
+        mName = other.mName;
+        mEnabledCache.store(0, std::memory_order_relaxed);
+        return *this;
+    }
+
+    bool IsEnabled(LogLevel level) const
+    {
+        if (!LogState::IsLevelEnabled(level))
+            return false;
+
+        // Generation in the upper bits, enabled in the lowest. The
+        // generation starts at one so a zeroed cache is always stale.
+        const auto generation = std::uint64_t{LogState::GetGeneration()};
+        auto cache = mEnabledCache.load(std::memory_order_relaxed);
+        if ((cache >> 1) != generation)
+        {
+            cache = (generation << 1) | LogState::IsLoggerEnabled(mName);
+            mEnabledCache.store(cache, std::memory_order_relaxed);
+        }
+        return cache & 1;
+    }
+
     std::ostream& Debug() const
     {
-        return LogState::Log(LogLevel::Debug, mName);
+        return Log(LogLevel::Debug);
     }
     
     template <typename T>
@@ -204,32 +241,34 @@ public:
 
     std::ostream& Info() const
     {
-        return LogState::Log(LogLevel::Info, mName);
+        return Log(LogLevel::Info);
     }
 
     std::ostream& Warn() const
     {
-        return LogState::Log(LogLevel::Warn, mName);
+        return Log(LogLevel::Warn);
     }
 
     std::ostream& Error() const
     {
-        return LogState::Log(LogLevel::Error, mName);
+        return Log(LogLevel::Error);
     }
 
     std::ostream& Fatal() const
     {
-        return LogState::Log(LogLevel::Fatal, mName);
+        return Log(LogLevel::Fatal);
     }
 
     std::ostream& Spam() const
     {
-        return LogState::Log(LogLevel::Spam, mName);
+        return Log(LogLevel::Spam);
     }
 
     std::ostream& Log(LogLevel level) const
     {
-        return LogState::Log(level, mName);
+        if (!IsEnabled(level))
+            return LogState::GetNullStream();
+        return LogState::LogEnabled(level, mName);
     }
 
     const std::string& GetName() const { return mName; }
@@ -237,6 +276,7 @@ public:
 private:
 
     std::string mName;
+    mutable std::atomic<std::uint64_t> mEnabledCache;
 };
 
 std::ostream& LogFatal(const std::string& loggerName);
@@ -247,3 +287,18 @@ std::ostream& LogDebug(const std::string& loggerName);
 std::ostream& LogSpam(const std::string& loggerName);
 
 }
+
+// Unlike logger.Debug() << ..., the streamed arguments are only evaluated
+// when the level and logger are enabled. Use these when the arguments are
+// expensive to compute or on hot paths, e.g.
+//     LOG_DEBUG(mLogger) << "Path: " << ComputePath() << "\n";
+#define LOG_LEVEL(LOGGER, LEVEL) \
+    if (!(LOGGER).IsEnabled(Logging::LogLevel::LEVEL)) {} \
+    else Logging::LogState::LogEnabled(Logging::LogLevel::LEVEL, (LOGGER).GetName())
+
+#define LOG_SPAM(LOGGER)  LOG_LEVEL(LOGGER, Spam)
+#define LOG_DEBUG(LOGGER) LOG_LEVEL(LOGGER, Debug)
+#define LOG_INFO(LOGGER)  LOG_LEVEL(LOGGER, Info)
+#define LOG_WARN(LOGGER)  LOG_LEVEL(LOGGER, Warn)
+#define LOG_ERROR(LOGGER) LOG_LEVEL(LOGGER, Error)
+#define LOG_FATAL(LOGGER) LOG_LEVEL(LOGGER, Fatal)
@@ -6,6 +6,7 @@
 
 OStreamMux::OStreamMux()
 :
+    mMutex{},
     mOutputs{&std::cout}
 {}
 
@@ -15,6 +16,7 @@ std::streamsize OStreamMux::xsputn(const char_type* s, std::streamsize n)
         s,
         static_cast<unsigned>(n)};
 
+    auto lock = std::unique_lock{mMutex};
     for (auto* stream : mOutputs)
     {
         assert(stream);
@@ -26,6 +28,7 @@ std::streamsize OStreamMux::xsputn(const char_type* s, std::streamsize n)
 
 OStreamMux::int_type OStreamMux::overflow(int_type c)
 {
+    auto lock = std::unique_lock{mMutex};
     for (auto* stream : mOutputs)
     {
         assert(stream);
@@ -34,13 +37,26 @@ OStreamMux::int_type OStreamMux::overflow(int_type c)
     return c;
 }
 
+int OStreamMux::sync()
+{
+    auto lock = std::unique_lock{mMutex};
+    for (auto* stream : mOutputs)
+    {
+        assert(stream);
+        stream->flush();
+    }
+    return 0;
+}
+
 void OStreamMux::AddStream(std::ostream* stream)
 {
+    auto lock = std::unique_lock{mMutex};
     mOutputs.emplace_back(stream);
 }
 
 void OStreamMux::RemoveStream(std::ostream* stream)
 {
+    auto lock = std::unique_lock{mMutex};
     auto it = std::find(mOutputs.begin(), mOutputs.end(), stream);
     if (it != mOutputs.end())
         mOutputs.erase(it);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 class OStreamMux : public std::streambuf
@@ -12,11 +13,14 @@ public:
         const char_type* s,
         std::streamsize n) override;
     int_type overflow(int_type c) override;
+    int sync() override;
 
     void AddStream(std::ostream* stream);
     void RemoveStream(std::ostream* stream);
 
 private:
+    // Loaders log from worker threads
+    std::mutex mMutex;
     std::vector<std::ostream*> mOutputs;
 };
 
@@ -44,6 +44,11 @@ std::string Paths::GetModDirectory() const
     return GetModDirectoryPath().string();
 }
 
+std::filesystem::path Paths::GetZoneCacheDirectoryPath() const
+{
+    return mZoneCacheDirectoryPath;
+}
+
 void Paths::SetBakDirectory(std::string path)
 {
     Logging::LogInfo(__FUNCTION__) << "Overriding BAK path to: " << path << "\n";
@@ -56,8 +61,15 @@ void Paths::SetModDirectory(std::string path)
     mModDirectoryPath = path;
 }
 
+void Paths::SetZoneCacheDirectory(std::string path)
+{
+    Logging::LogInfo(__FUNCTION__) << "Caching zone assets in: " << path << "\n";
+    mZoneCacheDirectoryPath = path;
+}
+
 Paths::Paths()
 :
     mBakDirectoryPath{std::filesystem::path{GetHomeDirectory()} / "bak"},
-    mModDirectoryPath{""}
+    mModDirectoryPath{""},
+    mZoneCacheDirectoryPath{""}
 {}
@@ -15,13 +15,18 @@ public:
     std::filesystem::path GetModDirectoryPath() const;
     std::string GetModDirectory() const;
 
+    // Empty unless caching of decoded zone assets is enabled
+    std::filesystem::path GetZoneCacheDirectoryPath() const;
+
     void SetBakDirectory(std::string path);
     void SetModDirectory(std::string path);
+    void SetZoneCacheDirectory(std::string path);
 private:
     Paths();
 
     std::filesystem::path mBakDirectoryPath;
     std::filesystem::path mModDirectoryPath;
+    std::filesystem::path mZoneCacheDirectoryPath;
 };
 
 
@@ -1,16 +1,73 @@
 #include "com/random.hpp"
 
+#include <atomic>
+#include <bit>
 #include <random>
 
-Random::Random()
-    : mEngine{std::random_device{}()}
+namespace {
+
+std::uint64_t SplitMix64(std::uint64_t& state)
+{
+    auto z = (state += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+// Unseeded threads draw distinct seeds from one process wide sequence
+std::uint64_t NextThreadSeed()
+{
+    static std::atomic<std::uint64_t> sSeedState{
+        (std::uint64_t{std::random_device{}()} << 32) | std::random_device{}()};
+    auto state = sSeedState.fetch_add(0x9e3779b97f4a7c15, std::memory_order_relaxed);
+    return SplitMix64(state);
+}
+
+}
+
+RandomEngine::RandomEngine(std::uint64_t seed)
+:
+    mState{}
+{
+    for (auto& word : mState)
+    {
+        word = SplitMix64(seed);
+    }
+}
+
+RandomEngine::result_type RandomEngine::operator()()
+{
+    const auto result = std::rotl(mState[1] * 5, 7) * 9;
+    const auto t = mState[1] << 17;
+
+    mState[2] ^= mState[0];
+    mState[3] ^= mState[1];
+    mState[1] ^= mState[2];
+    mState[0] ^= mState[3];
+
+    mState[2] ^= t;
+    mState[3] = std::rotl(mState[3], 45);
+
+    return result;
+}
+
+thread_local Random* Random::sThreadRandom{nullptr};
+
+Random::Random(std::uint64_t seed)
+:
+    mEngine{seed},
+    mForcedReturn{}
 {
 }
 
 Random& Random::Get()
 {
-    static Random instance;
-    return instance;
+    if (sThreadRandom)
+    {
+        return *sThreadRandom;
+    }
+    thread_local Random tInstance{NextThreadSeed()};
+    return tInstance;
 }
 
 unsigned Random::Generate(unsigned min, unsigned max)
@@ -21,15 +78,32 @@ unsigned Random::Generate(unsigned min, unsigned max)
         mForcedReturn.reset();
         return result;
     }
-    std::uniform_int_distribution<> dist(min, max);
+    std::uniform_int_distribution<unsigned> dist(min, max);
     return dist(mEngine);
 }
 
+Random Random::Split()
+{
+    return Random{mEngine()};
+}
+
 void Random::SetReturn(std::optional<unsigned> value)
 {
     mForcedReturn = value;
 }
 
+ScopedRandom::ScopedRandom(Random& random)
+:
+    mPrevious{Random::sThreadRandom}
+{
+    Random::sThreadRandom = &random;
+}
+
+ScopedRandom::~ScopedRandom()
+{
+    Random::sThreadRandom = mPrevious;
+}
+
 unsigned GetRandomNumber(unsigned min, unsigned max)
 {
     return Random::Get().Generate(min, max);
@@ -1,22 +1,68 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <optional>
-#include <random>
+
+// xoshiro256**. Its state is 32 bytes, so unlike std::mt19937 it is cheap
+// to create one per thread or per simulated battle.
+class RandomEngine
+{
+public:
+    using result_type = std::uint64_t;
+
+    // The seed is expanded with SplitMix64, so nearby seeds give
+    // unrelated streams
+    explicit RandomEngine(std::uint64_t seed);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()();
+
+private:
+    std::array<std::uint64_t, 4> mState;
+};
 
 class Random
 {
 public:
+    explicit Random(std::uint64_t seed);
+
+    // The stream installed on this thread by a ScopedRandom, otherwise
+    // this thread's own unseeded stream
     static Random& Get();
 
     unsigned Generate(unsigned min, unsigned max);
 
+    // A new stream seeded from this one, e.g. to give each worker its own
+    // stream from a single seed
+    Random Split();
+
     void SetReturn(std::optional<unsigned> value);
 
 private:
-    Random();
+    friend class ScopedRandom;
+    static thread_local Random* sThreadRandom;
 
-    std::mt19937 mEngine;
+    RandomEngine mEngine;
     std::optional<unsigned> mForcedReturn;
 };
 
+// Makes Random::Get() return random on this thread until destroyed, so
+// that e.g. simulations on worker threads are independent and repeatable.
+class ScopedRandom
+{
+public:
+    explicit ScopedRandom(Random& random);
+    ~ScopedRandom();
+
+    ScopedRandom(const ScopedRandom&) = delete;
+    ScopedRandom& operator=(const ScopedRandom&) = delete;
+
+private:
+    Random* mPrevious;
+};
+
 unsigned GetRandomNumber(unsigned min, unsigned max);
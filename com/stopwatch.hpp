@@ -0,0 +1,27 @@
+#pragma once
+
+#include <chrono>
+
+// Measures wall time for reporting how long loading stages take
+class Stopwatch
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Stopwatch()
+    :
+        mStart{Clock::now()}
+    {}
+
+    // Milliseconds since construction or the last Lap
+    double Lap()
+    {
+        const auto now = Clock::now();
+        const auto elapsed = std::chrono::duration<double, std::milli>(now - mStart);
+        mStart = now;
+        return elapsed.count();
+    }
+
+private:
+    Clock::time_point mStart;
+};
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+
+#include "com/asyncLogSink.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Logging {
+
+namespace {
+
+std::string MakeLine(unsigned producer, unsigned line)
+{
+    // Every third line spans several slots
+    const auto padding = line % 3 == 0
+        ? std::string(AsyncLogSink::sSlotSize * 2, '.')
+        : std::string{};
+    return "producer " + std::to_string(producer)
+        + " line " + std::to_string(line) + padding + "\n";
+}
+
+struct Output
+{
+    std::set<std::string> mLines;
+    std::uint64_t mReportedDropped;
+};
+
+Output ParseOutput(const std::string& output)
+{
+    static const auto dropped = std::regex{"WARN \\[AsyncLogSink\\] Dropped ([0-9]+) log lines"};
+
+    auto result = Output{{}, 0};
+    auto stream = std::istringstream{output};
+    std::string line{};
+    while (std::getline(stream, line))
+    {
+        auto match = std::smatch{};
+        if (std::regex_match(line, match, dropped))
+        {
+            result.mReportedDropped += std::stoull(match[1]);
+        }
+        else
+        {
+            EXPECT_TRUE(result.mLines.emplace(line + "\n").second) << line;
+        }
+    }
+    return result;
+}
+
+}
+
+TEST(AsyncLogSinkTest, EveryLineIsWrittenOrCountedAsDropped)
+{
+    static constexpr unsigned sProducers = 4;
+    static constexpr unsigned sLinesPerProducer = 5000;
+
+    auto output = std::ostringstream{};
+    std::atomic<std::uint64_t> pushed{0};
+    std::uint64_t droppedCount = 0;
+    {
+        // Small enough that the producers overrun the writer
+        auto sink = AsyncLogSink{output, 64};
+        {
+            auto producers = std::vector<std::jthread>{};
+            for (unsigned p = 0; p < sProducers; p++)
+            {
+                producers.emplace_back([&, p]{
+                    for (unsigned i = 0; i < sLinesPerProducer; i++)
+                    {
+                        if (sink.Push(MakeLine(p, i)))
+                        {
+                            pushed.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                });
+            }
+        }
+        sink.Flush();
+        droppedCount = sink.GetDroppedCount();
+    }
+
+    const auto result = ParseOutput(output.str());
+    EXPECT_EQ(result.mLines.size(), pushed.load());
+    EXPECT_EQ(result.mReportedDropped, droppedCount);
+    EXPECT_EQ(result.mLines.size() + droppedCount, sProducers * sLinesPerProducer);
+
+    for (const auto& line : result.mLines)
+    {
+        const auto producer = std::stoul(line.substr(line.find("producer ") + 9));
+        const auto index = std::stoul(line.substr(line.find("line ") + 5));
+        EXPECT_EQ(line, MakeLine(producer, index));
+    }
+}
+
+TEST(AsyncLogSinkTest, FlushWaitsForPushedLines)
+{
+    auto output = std::ostringstream{};
+    auto sink = AsyncLogSink{output, 1024};
+
+    for (unsigned round = 0; round < 50; round++)
+    {
+        // Give the writer time to go idle so that each round also checks
+        // it is woken by the next push
+        std::this_thread::sleep_for(std::chrono::microseconds{200});
+
+        std::string expected{};
+        for (unsigned i = 0; i < 4; i++)
+        {
+            const auto line = MakeLine(round, i);
+            ASSERT_TRUE(sink.Push(line));
+            expected += line;
+        }
+        sink.Flush();
+
+        const auto written = output.str();
+        ASSERT_GE(written.size(), expected.size());
+        EXPECT_EQ(written.substr(written.size() - expected.size()), expected);
+    }
+    EXPECT_EQ(sink.GetDroppedCount(), 0u);
+}
+
+}
@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+
+#include "com/logger.hpp"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Logging {
+
+namespace {
+
+struct CountedArgument
+{
+    unsigned& mEvaluations;
+
+    std::string operator()() const
+    {
+        mEvaluations++;
+        return "evaluated";
+    }
+};
+
+class LoggerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        LogState::SetLogTime(false);
+        LogState::SetLogColor(false);
+        LogState::AddStream(&mOutput);
+    }
+
+    void TearDown() override
+    {
+        LogState::RemoveStream(&mOutput);
+        LogState::SetLevel(LogLevel::Info);
+    }
+
+    std::ostringstream mOutput{};
+};
+
+}
+
+TEST_F(LoggerTest, DisabledLevelDoesNotEvaluateArguments)
+{
+    const auto& logger = LogState::GetLogger("LoggerTestLevel");
+    LogState::SetLevel(LogLevel::Info);
+
+    unsigned evaluations = 0;
+    const auto argument = CountedArgument{evaluations};
+
+    LOG_SPAM(logger) << argument() << "\n";
+    LOG_DEBUG(logger) << argument() << "\n";
+    EXPECT_EQ(evaluations, 0u);
+    EXPECT_EQ(mOutput.str().find("evaluated"), std::string::npos);
+
+    LOG_INFO(logger) << argument() << "\n";
+    EXPECT_EQ(evaluations, 1u);
+    EXPECT_NE(mOutput.str().find("evaluated"), std::string::npos);
+
+    LogState::SetLevel(LogLevel::Debug);
+    LOG_DEBUG(logger) << argument() << "\n";
+    EXPECT_EQ(evaluations, 2u);
+}
+
+TEST_F(LoggerTest, DisabledLoggerDoesNotEvaluateArguments)
+{
+    const auto& logger = LogState::GetLogger("LoggerTestDisabled");
+    LogState::SetLevel(LogLevel::Debug);
+
+    unsigned evaluations = 0;
+    const auto argument = CountedArgument{evaluations};
+
+    LOG_INFO(logger) << argument() << "\n";
+    EXPECT_EQ(evaluations, 1u);
+
+    // The logger caches whether it is enabled, so this also checks the
+    // cache is refreshed
+    LogState::Disable("LoggerTestDisabled");
+    LOG_ERROR(logger) << argument() << "\n";
+    EXPECT_EQ(evaluations, 1u);
+}
+
+TEST_F(LoggerTest, MacroBindsAsASingleStatement)
+{
+    const auto& logger = LogState::GetLogger("LoggerTestStatement");
+    LogState::SetLevel(LogLevel::Info);
+
+    unsigned evaluations = 0;
+    const auto argument = CountedArgument{evaluations};
+
+    bool tookElse = false;
+    if (evaluations == 0)
+        LOG_DEBUG(logger) << argument();
+    else
+        tookElse = true;
+
+    EXPECT_FALSE(tookElse);
+    EXPECT_EQ(evaluations, 0u);
+}
+
+TEST_F(LoggerTest, ThreadsWriteWholeLines)
+{
+    static constexpr unsigned sThreads = 4;
+    static constexpr unsigned sLines = 2000;
+    LogState::SetLevel(LogLevel::Info);
+
+    {
+        auto threads = std::vector<std::jthread>{};
+        for (unsigned t = 0; t < sThreads; t++)
+        {
+            threads.emplace_back([t]{
+                const auto& logger = LogState::GetLogger("LoggerTestThread" + std::to_string(t));
+                for (unsigned i = 0; i < sLines; i++)
+                {
+                    logger.Info() << "thread " << t << " line " << i << "\n";
+                }
+            });
+        }
+        // Changing the filters while the threads log
+        for (unsigned i = 0; i < 100; i++)
+        {
+            LogState::Disable("LoggerTestUnused" + std::to_string(i));
+        }
+    }
+
+    auto lines = std::set<std::string>{};
+    auto stream = std::istringstream{mOutput.str()};
+    std::string line{};
+    while (std::getline(stream, line))
+    {
+        EXPECT_TRUE(lines.emplace(line).second) << line;
+    }
+    ASSERT_EQ(lines.size(), sThreads * sLines);
+    for (unsigned t = 0; t < sThreads; t++)
+    {
+        for (unsigned i = 0; i < sLines; i++)
+        {
+            const auto expected = "INFO [LoggerTestThread" + std::to_string(t) + "] thread "
+                + std::to_string(t) + " line " + std::to_string(i);
+            EXPECT_TRUE(lines.contains(expected)) << expected;
+        }
+    }
+}
+
+}
@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+
+#include "com/threadPool.hpp"
+
+#include <stdexcept>
+#include <string>
+
+TEST(ThreadPoolTest, MapReturnsResultsInIndexOrder)
+{
+    auto pool = ThreadPool{4};
+    const auto results = pool.Map(1000, [](std::size_t i){ return i * i; });
+
+    ASSERT_EQ(results.size(), 1000u);
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        EXPECT_EQ(results[i], i * i);
+    }
+}
+
+TEST(ThreadPoolTest, MapRethrowsLowestIndexException)
+{
+    auto pool = ThreadPool{4};
+    try
+    {
+        pool.Map(100, [](std::size_t i)
+        {
+            if (i == 7 || i == 50)
+                throw std::runtime_error(std::to_string(i));
+            return i;
+        });
+        FAIL() << "Expected an exception";
+    }
+    catch (const std::runtime_error& e)
+    {
+        EXPECT_EQ(std::string{e.what()}, "7");
+    }
+}
@@ -0,0 +1,73 @@
+#include "com/threadPool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threadCount)
+:
+    mMutex{},
+    mCondition{},
+    mTasks{},
+    mStopping{false},
+    mThreads{}
+{
+    threadCount = std::max(threadCount, 1u);
+    mThreads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; i++)
+    {
+        mThreads.emplace_back([this]{ Run(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        auto lock = std::unique_lock{mMutex};
+        mStopping = true;
+    }
+    mCondition.notify_all();
+
+    for (auto& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::Get()
+{
+    static ThreadPool pool{std::thread::hardware_concurrency()};
+    return pool;
+}
+
+unsigned ThreadPool::GetThreadCount() const
+{
+    return mThreads.size();
+}
+
+void ThreadPool::Push(std::function<void()>&& task)
+{
+    {
+        auto lock = std::unique_lock{mMutex};
+        mTasks.emplace_back(std::move(task));
+    }
+    mCondition.notify_one();
+}
+
+void ThreadPool::Run()
+{
+    while (true)
+    {
+        auto task = std::function<void()>{};
+        {
+            auto lock = std::unique_lock{mMutex};
+            mCondition.wait(lock, [this]{ return mStopping || !mTasks.empty(); });
+            // Drain the queue before stopping so no future is left unsatisfied
+            if (mTasks.empty())
+            {
+                return;
+            }
+            task = std::move(mTasks.front());
+            mTasks.pop_front();
+        }
+        task();
+    }
+}
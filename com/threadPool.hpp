@@ -0,0 +1,106 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed size pool of worker threads for loading work.
+//
+// Tasks must not wait on the results of other tasks submitted to the same
+// pool. Dependencies are expressed by the caller waiting on one batch of
+// tasks before submitting the next.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    // Shared pool with one worker per hardware thread
+    static ThreadPool& Get();
+
+    unsigned GetThreadCount() const;
+
+    template <typename F>
+    auto Submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<F>(f));
+        auto future = task->get_future();
+        Push([task]{ (*task)(); });
+        return future;
+    }
+
+    // Submits f(i) for every i in [0, count)
+    template <typename F>
+    auto SubmitEach(std::size_t count, F&& f)
+        -> std::vector<std::future<std::invoke_result_t<std::decay_t<F>, std::size_t>>>
+    {
+        using Result = std::invoke_result_t<std::decay_t<F>, std::size_t>;
+        auto shared = std::make_shared<std::decay_t<F>>(std::forward<F>(f));
+        std::vector<std::future<Result>> futures{};
+        futures.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            futures.emplace_back(Submit([shared, i]{ return (*shared)(i); }));
+        }
+        return futures;
+    }
+
+    // Runs f(i) for every i in [0, count) and returns the results in index
+    // order. See GetResults for how exceptions are reported.
+    template <typename F>
+    auto Map(std::size_t count, F&& f)
+        -> std::vector<std::invoke_result_t<std::decay_t<F>, std::size_t>>
+    {
+        auto futures = SubmitEach(count, std::forward<F>(f));
+        return GetResults(futures);
+    }
+
+    template <typename T>
+    static void WaitAll(const std::vector<std::future<T>>& futures)
+    {
+        for (const auto& future : futures)
+        {
+            future.wait();
+        }
+    }
+
+    // Waits for every future before collecting any, so that no task is still
+    // running if an exception escapes. The exception from the lowest index
+    // is the one rethrown.
+    template <typename T>
+    static std::vector<T> GetResults(std::vector<std::future<T>>& futures)
+    {
+        WaitAll(futures);
+        std::vector<T> results{};
+        results.reserve(futures.size());
+        for (auto& future : futures)
+        {
+            results.emplace_back(future.get());
+        }
+        return results;
+    }
+
+private:
+    void Push(std::function<void()>&& task);
+    void Run();
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    std::deque<std::function<void()>> mTasks;
+    bool mStopping;
+    std::vector<std::thread> mThreads;
+};
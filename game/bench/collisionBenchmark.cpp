@@ -0,0 +1,220 @@
+#include "benchmark/benchmark.h"
+
+#include "bak/constants.hpp"
+#include "bak/zone.hpp"
+
+#include "game/systems.hpp"
+
+#include "com/logger.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <numbers>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Replays a player path through a zone, making the collision queries that
+// MovementManager::CannotMoveHere makes for each step. Each step checks the
+// new position and, as when sliding along a wall, 16 probe headings around
+// it.
+//
+// Usage: collisionBenchmark [benchmark flags] zone [path]
+//
+// path is a text file of "x y" BaK positions, one per line, e.g. recorded
+// from the party location while playing. Without one, the path walks
+// through the centre of every tile in the zone.
+
+namespace {
+
+static constexpr auto sProbeHeadings = 16;
+static constexpr auto sStepSize = BAK::gCellSize / 4;
+
+std::vector<glm::ivec2> LoadPath(const std::string& pathFile)
+{
+    std::vector<glm::ivec2> path{};
+    std::ifstream in{pathFile};
+    int x = 0;
+    int y = 0;
+    while (in >> x >> y)
+    {
+        path.emplace_back(x, y);
+    }
+    return path;
+}
+
+std::vector<glm::ivec2> MakeTilePath(const BAK::Zone& zone)
+{
+    std::vector<glm::vec2> tileCentres{};
+    for (const auto& world : zone.mWorldTiles.GetTiles())
+    {
+        tileCentres.emplace_back(
+            (glm::vec2{world.GetTile()} + glm::vec2{.5f}) * BAK::gTileSize);
+    }
+    std::sort(tileCentres.begin(), tileCentres.end(),
+        [](const auto& lhs, const auto& rhs){
+            return std::tie(lhs.y, lhs.x) < std::tie(rhs.y, rhs.x);
+        });
+
+    std::vector<glm::ivec2> path{};
+    for (unsigned i = 1; i < tileCentres.size(); i++)
+    {
+        const auto start = tileCentres[i - 1];
+        const auto end = tileCentres[i];
+        const auto steps = static_cast<unsigned>(glm::distance(start, end) / sStepSize);
+        for (unsigned step = 0; step < steps; step++)
+        {
+            path.emplace_back(glm::mix(start, end, static_cast<float>(step) / steps));
+        }
+    }
+    return path;
+}
+
+// The items GameRunner::LoadSystems adds collisions for
+void AddCollisionItems(const BAK::Zone& zone, Systems& systems)
+{
+    for (const auto& world : zone.mWorldTiles.GetTiles())
+    {
+        for (const auto& item : world.GetItems())
+        {
+            if (item.GetZoneItem().GetVertices().size() > 1)
+            {
+                AddZoneCollisionItem(systems, item);
+            }
+        }
+    }
+}
+
+// What Systems::GetNearbyCollisions did before the collision index
+std::vector<CollisionItem> LinearScan(
+    const std::vector<CollisionItem>& items,
+    glm::ivec2 playerPos,
+    float maxDistSq)
+{
+    struct Candidate {
+        CollisionItem mItem;
+        float mDistSq;
+    };
+    std::vector<Candidate> candidates;
+
+    for (const auto& item : items)
+    {
+        const auto& bakLoc = item.GetBakLocation();
+        const float dx = static_cast<float>(playerPos.x) - static_cast<float>(bakLoc.x);
+        const float dy = static_cast<float>(playerPos.y) - static_cast<float>(bakLoc.y);
+        const float distSq = dx*dx + dy*dy;
+        if (distSq > maxDistSq)
+        {
+            continue;
+        }
+        candidates.push_back({item, distSq});
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+        [](const auto& a, const auto& b) { return a.mDistSq < b.mDistSq; });
+
+    std::vector<CollisionItem> result;
+    result.reserve(candidates.size());
+    for (auto& c : candidates)
+    {
+        result.push_back(std::move(c.mItem));
+    }
+    return result;
+}
+
+struct Scenario
+{
+    Systems* mSystems;
+    std::vector<glm::ivec2> mPath;
+};
+
+template <typename Query>
+void ReplayPath(benchmark::State& state, const Scenario& scenario, Query&& query)
+{
+    std::vector<glm::ivec2> probes{};
+    for (unsigned i = 0; i < sProbeHeadings; i++)
+    {
+        const auto angle = 2 * std::numbers::pi_v<float> * i / sProbeHeadings;
+        probes.emplace_back(glm::vec2{std::cos(angle), std::sin(angle)} * float{sStepSize});
+    }
+
+    std::size_t queries = 0;
+    std::size_t itemsFound = 0;
+    for (auto _ : state)
+    {
+        for (const auto& position : scenario.mPath)
+        {
+            itemsFound += query(position);
+            for (const auto& probe : probes)
+            {
+                itemsFound += query(position + probe);
+            }
+            queries += 1 + probes.size();
+        }
+        benchmark::DoNotOptimize(itemsFound);
+    }
+
+    state.SetItemsProcessed(queries);
+    state.counters["pathSteps"] = scenario.mPath.size();
+    state.counters["itemsPerQuery"] = static_cast<double>(itemsFound) / std::max(queries, std::size_t{1});
+}
+
+void BM_LinearScan(benchmark::State& state, const Scenario* scenario)
+{
+    const auto& systems = *scenario->mSystems;
+    ReplayPath(state, *scenario, [&](glm::ivec2 position){
+        return LinearScan(systems.GetAllowables(), position, sMaxCollisionDistSq).size()
+            + LinearScan(systems.GetBlockables(), position, sMaxCollisionDistSq).size();
+    });
+}
+
+void BM_CollisionIndex(benchmark::State& state, const Scenario* scenario)
+{
+    const auto& systems = *scenario->mSystems;
+    ReplayPath(state, *scenario, [&](glm::ivec2 position){
+        return systems.GetNearbyAllowables(position, sMaxCollisionDistSq).size()
+            + systems.GetNearbyBlockables(position, sMaxCollisionDistSq).size();
+    });
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    Logging::LogState::SetLevel(Logging::LogLevel::Warn);
+    const auto& logger = Logging::LogState::GetLogger("collisionBenchmark");
+
+    if (argc < 2)
+    {
+        logger.Error() << "Usage: " << argv[0] << " [benchmark flags] zone [path]\n";
+        return 1;
+    }
+
+    const auto zone = BAK::Zone{static_cast<unsigned>(std::atoi(argv[1]))};
+    auto systems = Systems{};
+    AddCollisionItems(zone, systems);
+
+    // Only quiet while loading the zone
+    Logging::LogState::SetLevel(Logging::LogLevel::Info);
+
+    auto scenario = Scenario{
+        &systems,
+        argc > 2 ? LoadPath(argv[2]) : MakeTilePath(zone)};
+
+    logger.Info() << "Allowables: " << systems.GetAllowables().size()
+        << " blockables: " << systems.GetBlockables().size()
+        << " path steps: " << scenario.mPath.size() << "\n";
+
+    benchmark::RegisterBenchmark("CollisionLinearScan", BM_LinearScan, &scenario);
+    benchmark::RegisterBenchmark("CollisionIndex", BM_CollisionIndex, &scenario);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
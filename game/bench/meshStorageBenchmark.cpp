@@ -0,0 +1,207 @@
+#include "benchmark/benchmark.h"
+
+#include "graphics/cube.hpp"
+#include "graphics/meshObject.hpp"
+
+#include "com/logger.hpp"
+
+#include <glm/glm.hpp>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Lays out a zone's worth of synthetic item meshes, followed by the debug
+// meshes, in a MeshObjectStorage as Zone does. Compares building the
+// storage once with everything in it against building the item meshes,
+// seeding a second builder with them and building again, both for a zone
+// made from scratch and for one whose meshes came from the cache.
+//
+// Usage: meshStorageBenchmark [benchmark flags]
+
+namespace {
+
+using Meshes = std::vector<std::pair<std::string, Graphics::MeshObject>>;
+
+static constexpr unsigned sDebugMeshes = 9;
+
+Graphics::MeshObject MakeItemMesh(std::mt19937& rng, unsigned triangles)
+{
+    auto coordinate = std::uniform_real_distribution<float>{-1000.0f, 1000.0f};
+    auto builder = Graphics::MeshBuilder{};
+    for (unsigned i = 0; i < triangles; i++)
+    {
+        const auto MakeVertex = [&]{
+            return Graphics::PackVertex(
+                glm::vec3{coordinate(rng), coordinate(rng), coordinate(rng)},
+                glm::vec3{0, 1, 0},
+                glm::vec4{0.5, 0.5, 0.5, 1},
+                glm::vec3{0, 0, i % 16},
+                1.0f);
+        };
+        builder.AddTriangle(MakeVertex(), MakeVertex(), MakeVertex());
+    }
+    return std::move(builder).Build();
+}
+
+Meshes MakeItemMeshes(unsigned count, unsigned triangles)
+{
+    auto rng = std::mt19937{42};
+    auto meshes = Meshes{};
+    for (unsigned i = 0; i < count; i++)
+    {
+        meshes.emplace_back("item" + std::to_string(i), MakeItemMesh(rng, triangles));
+    }
+    return meshes;
+}
+
+Meshes MakeDebugMeshes()
+{
+    const auto cube = Graphics::Cuboid{1, 1, 50};
+    auto meshes = Meshes{};
+    for (unsigned i = 0; i < sDebugMeshes; i++)
+    {
+        meshes.emplace_back("debug" + std::to_string(i), cube.ToMeshObject(glm::vec4{1, 0, 0, .3}));
+    }
+    return meshes;
+}
+
+void AddMeshes(Graphics::MeshObjectStorageBuilder& builder, Meshes meshes)
+{
+    for (auto& [name, mesh] : meshes)
+    {
+        builder.AddObject(std::move(name), std::move(mesh));
+    }
+}
+
+struct Scenario
+{
+    Meshes mItems;
+    Meshes mDebug;
+    Graphics::MeshObjectStorage mItemStorage;
+    Graphics::MeshObjectStorage mFullStorage;
+};
+
+Scenario MakeScenario(unsigned count, unsigned triangles)
+{
+    auto scenario = Scenario{MakeItemMeshes(count, triangles), MakeDebugMeshes(), {}, {}};
+
+    auto items = Graphics::MeshObjectStorageBuilder{};
+    AddMeshes(items, scenario.mItems);
+    scenario.mItemStorage = std::move(items).Build();
+
+    auto full = Graphics::MeshObjectStorageBuilder{};
+    AddMeshes(full, scenario.mItems);
+    AddMeshes(full, scenario.mDebug);
+    scenario.mFullStorage = std::move(full).Build();
+
+    return scenario;
+}
+
+void SetCounters(benchmark::State& state, const Graphics::MeshObjectStorage& storage)
+{
+    state.counters["vertices"] = storage.GetVertices().size();
+    state.counters["indices"] = storage.GetIndices().size();
+    state.SetBytesProcessed(state.iterations() * (
+        storage.GetVertices().size() * sizeof(Graphics::Vertex)
+        + storage.GetIndices().size() * sizeof(unsigned)));
+}
+
+// Items are built, then seeded into a second builder with the debug meshes
+void BM_BuildTwice(benchmark::State& state, const Scenario* scenario)
+{
+    auto storage = Graphics::MeshObjectStorage{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto items = scenario->mItems;
+        auto debug = scenario->mDebug;
+        state.ResumeTiming();
+
+        auto builder = Graphics::MeshObjectStorageBuilder{};
+        AddMeshes(builder, std::move(items));
+        auto itemStorage = std::move(builder).Build();
+        builder = Graphics::MeshObjectStorageBuilder{std::move(itemStorage)};
+        AddMeshes(builder, std::move(debug));
+        storage = std::move(builder).Build();
+        benchmark::DoNotOptimize(storage);
+    }
+    SetCounters(state, storage);
+}
+
+void BM_BuildOnce(benchmark::State& state, const Scenario* scenario)
+{
+    auto storage = Graphics::MeshObjectStorage{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto items = scenario->mItems;
+        auto debug = scenario->mDebug;
+        state.ResumeTiming();
+
+        auto builder = Graphics::MeshObjectStorageBuilder{};
+        AddMeshes(builder, std::move(items));
+        AddMeshes(builder, std::move(debug));
+        storage = std::move(builder).Build();
+        benchmark::DoNotOptimize(storage);
+    }
+    SetCounters(state, storage);
+}
+
+// The cache held only the item meshes, so the debug meshes are appended
+void BM_CachedItems(benchmark::State& state, const Scenario* scenario)
+{
+    auto storage = Graphics::MeshObjectStorage{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto cached = scenario->mItemStorage;
+        auto debug = scenario->mDebug;
+        state.ResumeTiming();
+
+        auto builder = Graphics::MeshObjectStorageBuilder{std::move(cached)};
+        AddMeshes(builder, std::move(debug));
+        storage = std::move(builder).Build();
+        benchmark::DoNotOptimize(storage);
+    }
+    SetCounters(state, storage);
+}
+
+// The cache holds every mesh, so the storage is used as it is
+void BM_CachedAll(benchmark::State& state, const Scenario* scenario)
+{
+    auto storage = Graphics::MeshObjectStorage{};
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto cached = scenario->mFullStorage;
+        state.ResumeTiming();
+
+        auto builder = Graphics::MeshObjectStorageBuilder{std::move(cached)};
+        storage = std::move(builder).Build();
+        benchmark::DoNotOptimize(storage);
+    }
+    SetCounters(state, storage);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    Logging::LogState::SetLevel(Logging::LogLevel::Warn);
+
+    // About the number of distinct item meshes, and their size, in a zone
+    const auto scenario = MakeScenario(250, 400);
+
+    benchmark::RegisterBenchmark("MeshStorageBuildTwice", BM_BuildTwice, &scenario);
+    benchmark::RegisterBenchmark("MeshStorageBuildOnce", BM_BuildOnce, &scenario);
+    benchmark::RegisterBenchmark("MeshStorageCachedItems", BM_CachedItems, &scenario);
+    benchmark::RegisterBenchmark("MeshStorageCachedAll", BM_CachedAll, &scenario);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
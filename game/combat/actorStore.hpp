@@ -8,7 +8,9 @@
 
 #include "com/random.hpp"
 
+#include <memory>
 #include <optional>
+#include <utility>
 
 namespace Game {
 
@@ -29,7 +31,7 @@ public:
     BAK::Direction mDirection;
     std::optional<glm::vec4> mFlashColor{};
 
-    const CombatModelLoader& mCombatModelLoader;
+    std::shared_ptr<const CombatModelData> mModelData;
     glm::mat4 mModelMatrix{1.0f};
     bool mUpdateIdle{true};
     bool mAnimating{false};
@@ -38,7 +40,7 @@ public:
         BAK::EntityIndex entityId,
         glm::vec3 location,
         BAK::MonsterIndex monster,
-        const CombatModelLoader& loader)
+        std::shared_ptr<const CombatModelData> modelData)
     :
         mEntityId{entityId},
         mLocation{location},
@@ -47,7 +49,7 @@ public:
         mMonster{monster},
         mAnimationType{BAK::AnimationType::Idle},
         mDirection{BAK::Direction::South},
-        mCombatModelLoader{loader}
+        mModelData{std::move(modelData)}
     {
     }
 
@@ -172,7 +174,7 @@ public:
 
     const auto& GetRenderData() const
     {
-        return mCombatModelLoader.mCombatModelDatas[mMonster.mValue]->mRenderData;
+        return mModelData->mRenderData;
     }
 
 private:
@@ -185,12 +187,11 @@ private:
     std::optional<AnimData> GetAnimData() const
     {
         auto request = AnimationRequest{mAnimationType, BAK::ToSpriteDirection(mDirection)};
-        auto& datas = mCombatModelLoader.mCombatModelDatas[mMonster.mValue];
-        if (!datas || !datas->mOffsetMap.contains(request))
+        if (!mModelData || !mModelData->mOffsetMap.contains(request))
         {
             return std::nullopt;
         }
-        return AnimData{&(*datas), datas->mOffsetMap.at(request)};
+        return AnimData{mModelData.get(), mModelData->mOffsetMap.at(request)};
     }
 
     void ApplyFrame(const AnimData& anim)
@@ -228,7 +229,7 @@ class ActorStore
 {
 public:
     ActorStore(
-        const CombatModelLoader& loader,
+        CombatModelLoader& loader,
         Systems* systems)
     :
         mLoader{loader},
@@ -243,13 +244,14 @@ public:
     {
         assert(mSystems);
         auto entityId = mSystems->GetNextItemId();
-        assert(mLoader.mCombatModelDatas[monsterIndex.mValue]);
+        auto modelData = mLoader.GetCombatModelData(monsterIndex);
+        assert(modelData);
 
         mActors.emplace_back(
             entityId,
             BAK::ToGlCoord<float>(pos),
             monsterIndex,
-            mLoader);
+            std::move(modelData));
         mActors.back().Update();
 
         return entityId;
@@ -291,7 +293,7 @@ public:
 
 private:
     std::vector<Actor> mActors{};
-    const CombatModelLoader& mLoader;
+    CombatModelLoader& mLoader;
     Systems* mSystems;
 
 };
@@ -151,9 +151,10 @@ Combatant* CombatManager::GetCombatant(GridPos gridPos)
     return nullptr;
 }
 
-std::vector<Combatant> CombatManager::GetCombatants()
+const Combatant& CombatManager::GetActiveCombatant() const
 {
-    return mCombatants;
+    assert(mCurrentCombatant < mCombatants.size());
+    return mCombatants[mCurrentCombatant];
 }
 
 void CombatManager::BeginCombat()
@@ -199,7 +200,9 @@ void CombatManager::GridCellClicked(GridPos targetCell, bool isRightClick)
 
     if (mGrid.CanAttack(myPos, targetCell))
     {
-        auto moveTo = SelectBestAttackPosition(myPos, targetCell, mGrid);
+        auto moveTo = mDistances.GetSource() == myPos
+            ? SelectBestAttackPosition(mDistances, targetCell, mGrid)
+            : SelectBestAttackPosition(myPos, targetCell, mGrid);
         mLogger.Debug() << "Attacking: " << targetCell << " should move to: " << moveTo << "\n";
         if (!moveTo)
         {
@@ -345,6 +348,8 @@ void CombatManager::ComputeGrid()
         }
     }
 
+    mDistances = DistanceField{me.mGridPos, mGrid};
+
     for (unsigned x = 0; x < mGrid.GetCols(); x++)
     {
         for (unsigned y = 0; y < mGrid.GetRows(); y++)
@@ -355,8 +360,8 @@ void CombatManager::ComputeGrid()
                 continue;
             }
 
-            auto moves = CalculatePath(me.mGridPos, cellPos, mGrid);
-            if (moves.size() > speed)
+            const auto distance = mDistances.GetDistance(cellPos);
+            if (!distance || *distance > speed)
             {
                 auto& cell = mGrid.Get(cellPos);
                 cell.mState = SetBit(cell.mState, StateFlags::Reachable, false);
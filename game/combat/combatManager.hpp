@@ -1,6 +1,7 @@
 #pragma once
 
 #include "game/combat/grid.hpp"
+#include "game/combat/gridAlgorithms.hpp"
 #include "game/combat/actionQueue.hpp"
 #include "game/combat/types.hpp"
 #include "game/combat/ICombatStage.hpp"
@@ -73,6 +74,9 @@ public:
 
     glm::vec4 GetGridCellColor(unsigned col, unsigned row);
     const Grid& GetGrid() const { return mGrid; }
+    const std::vector<Combatant>& GetCombatants() const { return mCombatants; }
+    // The combatant whose turn it is
+    const Combatant& GetActiveCombatant() const;
     void SetGridColor(glm::vec4 color) { mGridColor = color; }
 
     void SetDisplayAllCells(bool value) { mDisplayAllCells = value; }
@@ -83,8 +87,6 @@ private:
     Combatant* GetCombatant(BAK::EntityIndex entityIndex);
     Combatant* GetCombatant(GridPos gridPos);
 
-    std::vector<Combatant> GetCombatants();
-
     Combatant& GetCurrentCombatant();
 
     void ComputeGrid();
@@ -128,6 +130,8 @@ private:
     unsigned mCurrentCombatant{0};
     ActionQueue mActions{};
     Grid mGrid{8, 13};
+    // From the current combatant, as of the last ComputeGrid
+    DistanceField mDistances{};
     ICombatStage& mStage;
     BAK::ICombatUI& mCombatUI;
     const Logging::Logger& mLogger;
@@ -23,7 +23,7 @@ namespace Game::Combat {
 CombatStage::CombatStage(
     Gui::IGuiManager& guiManager,
     const GlyphStore& glyphStore,
-    const CombatModelLoader& combatModelLoader,
+    CombatModelLoader& combatModelLoader,
     const BAK::GamePositionAndHeading& combatPlayerPos,
     double animationSpeedMultiplier)
 :
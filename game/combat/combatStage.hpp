@@ -39,7 +39,7 @@ public:
     CombatStage(
         Gui::IGuiManager& guiManager,
         const GlyphStore& glyphStore,
-        const CombatModelLoader& combatModelLoader,
+        CombatModelLoader& combatModelLoader,
         const BAK::GamePositionAndHeading& combatPlayerPos,
         double animationSpeedMultiplier);
 
@@ -94,7 +94,7 @@ private:
 
     Gui::IGuiManager& mGuiManager;
     const GlyphStore& mGlyphStore;
-    const CombatModelLoader& mCombatModelLoader;
+    CombatModelLoader& mCombatModelLoader;
     const BAK::GamePositionAndHeading& mCombatPlayerPos;
     BAK::ICombatManager* mCombatManager{nullptr};
     Systems* mSystems{nullptr};
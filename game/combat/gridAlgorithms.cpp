@@ -7,7 +7,9 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 #include <queue>
+#include <utility>
 
 namespace Game::Combat {
 
@@ -116,6 +118,15 @@ std::vector<GridPos> CalculatePath(
 
 std::optional<GridPos> SelectBestAttackPosition(GridPos src, GridPos target, const Grid& grid)
 {
+    return SelectBestAttackPosition(DistanceField{src, grid}, target, grid);
+}
+
+std::optional<GridPos> SelectBestAttackPosition(
+    const DistanceField& distances,
+    GridPos target,
+    const Grid& grid)
+{
+    const auto src = distances.GetSource();
     auto dirFromTargetToMe = BAK::GetDirectionBetween(
             BAK::GamePosition(target),
             BAK::GamePosition(src));
@@ -126,23 +137,26 @@ std::optional<GridPos> SelectBestAttackPosition(GridPos src, GridPos target, con
         return src;
     }
 
-    std::vector<GridPos> candidates{
-        target + BAK::ToDelta(BAK::Direction::North),
-        target + BAK::ToDelta(BAK::Direction::South),
-        target + BAK::ToDelta(BAK::Direction::East),
-        target + BAK::ToDelta(BAK::Direction::West),
-    };
+    std::array<std::pair<GridPos, std::optional<unsigned>>, 4> candidates{};
+    const auto directions = std::array{
+        BAK::Direction::North,
+        BAK::Direction::South,
+        BAK::Direction::East,
+        BAK::Direction::West};
+    for (unsigned i = 0; i < directions.size(); i++)
+    {
+        const auto candidate = target + BAK::ToDelta(directions[i]);
+        candidates[i] = std::make_pair(candidate, distances.GetDistance(candidate));
+    }
 
-    std::sort(candidates.begin(), candidates.end(), [&](const auto& l, const auto& r)
+    std::stable_sort(candidates.begin(), candidates.end(), [](const auto& l, const auto& r)
     {
-        auto pathL = CalculatePath(src, l, grid).size();
-        auto pathR = CalculatePath(src, r, grid).size();
-        return pathL < pathR;
+        return l.second < r.second;
     });
 
-    for (const auto& candidate : candidates)
+    for (const auto& [candidate, distance] : candidates)
     {
-        if (grid.CanMoveTo(candidate))
+        if (distance && grid.CanMoveTo(candidate))
         {
             return candidate;
         }
@@ -151,4 +165,102 @@ std::optional<GridPos> SelectBestAttackPosition(GridPos src, GridPos target, con
     return std::nullopt;
 }
 
+DistanceField::DistanceField()
+:
+    mSource{},
+    mCols{0},
+    mRows{0},
+    mDistances{},
+    mParents{}
+{}
+
+DistanceField::DistanceField(GridPos source, const Grid& grid)
+:
+    mSource{source},
+    mCols{grid.GetCols()},
+    mRows{grid.GetRows()},
+    mDistances(mCols * mRows, sUnreachable),
+    mParents(mCols * mRows)
+{
+    if (!WithinBounds(source))
+    {
+        return;
+    }
+
+    // Each cell is queued at most once, so the frontier is never more
+    // than the size of the grid
+    std::vector<GridPos> frontier{};
+    frontier.reserve(mCols * mRows);
+    mDistances[GetIndex(source)] = 0;
+    frontier.emplace_back(source);
+
+    const auto directions = GetNeighborOrder(BAK::Direction::North);
+    for (unsigned next = 0; next < frontier.size(); next++)
+    {
+        const auto current = frontier[next];
+        const auto distance = mDistances[GetIndex(current)] + 1;
+
+        for (auto dir : directions)
+        {
+            const auto candidate = current + BAK::ToDelta(dir);
+            if (!WithinBounds(candidate))
+                continue;
+
+            const auto candidateIdx = GetIndex(candidate);
+            if (mDistances[candidateIdx] != sUnreachable)
+                continue;
+
+            mDistances[candidateIdx] = distance;
+            mParents[candidateIdx] = current;
+            if (grid.CanMoveTo(candidate))
+            {
+                frontier.emplace_back(candidate);
+            }
+        }
+    }
+}
+
+GridPos DistanceField::GetSource() const
+{
+    return mSource;
+}
+
+std::optional<unsigned> DistanceField::GetDistance(GridPos dest) const
+{
+    if (!WithinBounds(dest) || mDistances[GetIndex(dest)] == sUnreachable)
+    {
+        return std::nullopt;
+    }
+    return mDistances[GetIndex(dest)];
+}
+
+std::vector<GridPos> DistanceField::GetPath(GridPos dest) const
+{
+    const auto distance = GetDistance(dest);
+    if (!distance)
+    {
+        return {};
+    }
+
+    std::vector<GridPos> path(*distance);
+    auto back = dest;
+    for (auto it = path.rbegin(); it != path.rend(); it++)
+    {
+        *it = back;
+        back = mParents[GetIndex(back)];
+    }
+    return path;
+}
+
+bool DistanceField::WithinBounds(GridPos cell) const
+{
+    return cell.x >= 0 && cell.x < static_cast<int>(mCols)
+        && cell.y >= 0 && cell.y < static_cast<int>(mRows);
+}
+
+unsigned DistanceField::GetIndex(GridPos cell) const
+{
+    return cell.y * mCols + cell.x;
+}
+
 }
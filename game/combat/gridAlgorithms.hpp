@@ -5,11 +5,46 @@
 
 #include <glm/glm.hpp>
 
+#include <limits>
+#include <optional>
+#include <vector>
+
 namespace Game::Combat {
 
+// Path lengths from one cell to every other cell, found with a single
+// breadth first search. As with CalculatePath, paths may only pass through
+// cells that can be moved to, but may end on any cell next to one of them.
+class DistanceField
+{
+public:
+    DistanceField();
+    DistanceField(GridPos source, const Grid&);
+
+    GridPos GetSource() const;
+
+    // The number of moves in the shortest path, nullopt if there is none
+    std::optional<unsigned> GetDistance(GridPos dest) const;
+
+    // A shortest path, excluding the source, empty if there is none
+    std::vector<GridPos> GetPath(GridPos dest) const;
+
+private:
+    static constexpr auto sUnreachable = std::numeric_limits<unsigned>::max();
+
+    bool WithinBounds(GridPos cell) const;
+    unsigned GetIndex(GridPos cell) const;
+
+    GridPos mSource;
+    unsigned mCols;
+    unsigned mRows;
+    std::vector<unsigned> mDistances;
+    std::vector<GridPos> mParents;
+};
+
 bool IsAdjacent(GridPos src, GridPos dest);
 unsigned ChebyshevDistance(GridPos src, GridPos dest);
 std::vector<GridPos> CalculatePath(GridPos src, GridPos dest, const Grid&);
 std::optional<GridPos> SelectBestAttackPosition(GridPos src, GridPos target, const Grid&);
+std::optional<GridPos> SelectBestAttackPosition(const DistanceField&, GridPos target, const Grid&);
 
 }
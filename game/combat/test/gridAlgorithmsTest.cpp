@@ -182,4 +182,95 @@ TEST_F(GridAlgorithmsTest, SelectBestAttackPosition_RealisticScenario)
     ASSERT_TRUE(result);
     EXPECT_EQ(*result, GridPos(2, 5));
 }
+
+TEST_F(GridAlgorithmsTest, DistanceField_MatchesCalculatePath)
+{
+    // # # # # #
+    // # x x x #
+    // # x # x #
+    // # # # x #
+    // . # # # #
+    SetUnreachable(1, 1);
+    SetUnreachable(3, 1);
+    SetUnreachable(3, 2);
+    SetUnreachable(1, 3);
+    SetUnreachable(2, 3);
+    SetUnreachable(3, 3);
+
+    const auto src = GridPos{0, 0};
+    const auto distances = DistanceField{src, grid};
+    EXPECT_EQ(distances.GetSource(), src);
+    EXPECT_EQ(distances.GetDistance(src), 0u);
+
+    for (int y = 0; y < static_cast<int>(grid.GetRows()); y++)
+    {
+        for (int x = 0; x < static_cast<int>(grid.GetCols()); x++)
+        {
+            const auto dest = GridPos{x, y};
+            if (dest == src)
+                continue;
+
+            const auto path = CalculatePath(src, dest, grid);
+            ASSERT_FALSE(path.empty()) << dest;
+            EXPECT_EQ(distances.GetDistance(dest), path.size()) << dest;
+            EXPECT_EQ(distances.GetPath(dest).size(), path.size()) << dest;
+        }
+    }
+}
+
+TEST_F(GridAlgorithmsTest, DistanceField_PathOnlyPassesThroughReachableCells)
+{
+    SetUnreachable(1, 0);
+    SetUnreachable(1, 1);
+    SetUnreachable(1, 2);
+    SetUnreachable(1, 3);
+
+    const auto src = GridPos{0, 0};
+    const auto dest = GridPos{2, 0};
+    const auto path = DistanceField{src, grid}.GetPath(dest);
+    ASSERT_EQ(path.size(), 8u);
+    EXPECT_EQ(path.back(), dest);
+
+    auto previous = src;
+    for (const auto& cell : path)
+    {
+        EXPECT_EQ(ChebyshevDistance(previous, cell), 1u);
+        EXPECT_TRUE(grid.CanMoveTo(cell)) << cell;
+        previous = cell;
+    }
+}
+
+TEST_F(GridAlgorithmsTest, DistanceField_UnreachableCellsHaveNoDistance)
+{
+    SetUnreachable(1, 1);
+    SetUnreachable(1, 0);
+    SetUnreachable(0, 1);
+
+    const auto distances = DistanceField{{0, 0}, grid};
+    // Cells that can't be moved to can still be the end of a path
+    EXPECT_EQ(distances.GetDistance({1, 1}), 1u);
+    EXPECT_FALSE(distances.GetDistance({2, 2}));
+    EXPECT_TRUE(distances.GetPath({2, 2}).empty());
+    EXPECT_FALSE(distances.GetDistance({5, 5}));
+    EXPECT_FALSE(DistanceField{}.GetDistance({0, 0}));
+}
+
+TEST_F(GridAlgorithmsTest, SelectBestAttackPosition_SkipsCellsWithNoPath)
+{
+    // # # # # .
+    // # # # # #
+    // # # # # #
+    // x x # # #
+    // # t x # #
+    const auto src = GridPos{4, 4};
+    const auto target = GridPos{1, 0};
+    SetUnreachable(0, 1);
+    SetUnreachable(1, 1);
+    SetUnreachable(2, 0);
+    SetUnreachable(1, 0);
+    std::cout << grid << "\n";
+
+    EXPECT_FALSE(SelectBestAttackPosition(src, target, grid));
+    EXPECT_FALSE(SelectBestAttackPosition(DistanceField{src, grid}, target, grid));
+}
 }
@@ -7,6 +7,7 @@
 #include "bak/model.hpp"
 #include "bak/monster.hpp"
 #include "bak/palette.hpp"
+#include "bak/resourceCache.hpp"
 #include "bak/resourceNames.hpp"
 #include "bak/textureFactory.hpp"
 #include "bak/worldFactory.hpp"
@@ -14,6 +15,7 @@
 #include "com/logger.hpp"
 #include "com/ostream.hpp"
 #include "com/string.hpp"
+#include "com/threadPool.hpp"
 
 #include "graphics/meshObject.hpp"
 #include "graphics/texture.hpp"
@@ -25,28 +27,127 @@
 
 namespace Game {
 
+struct CombatModelLoader::DecodedSprites
+{
+    Graphics::TextureStore mTextures;
+    Graphics::MeshObjectStorage mObjects;
+    std::unordered_map<AnimationRequest, AnimationMeta> mOffsetMap;
+    std::vector<Graphics::MeshObjectStorage::OffsetAndLength> mObjectDrawData;
+};
+
 CombatModelLoader::CombatModelLoader()
+:
+    mCombatModels{},
+    mCachedModels{},
+    mPendingModels{},
+    mCachedTextureBytes{0},
+    mUseCount{0},
+    mLogger{Logging::LogState::GetLogger("CombatModelLoader")}
 {
-    const auto& logger = Logging::Logger("CombatModelLoader");
     auto tblBuf = BAK::FileBufferFactory::Get().CreateDataBuffer(sCombatModels);
     auto [models, _] = BAK::LoadTBL(tblBuf);
     for (unsigned i = 0; i < models.size(); i++)
     {
         if (models[i].mEntityType == 0 && models[i].mSprite > 0)
         {
-            logger.Debug() << "Loaded Combatant Model #" << i << " " << models[i].mName << "\n";
+            mLogger.Debug() << "Loaded Combatant Model #" << i << " " << models[i].mName << "\n";
             mCombatModels.emplace_back(BAK::CombatModel{models[i]});
-            LoadMonsterSprites(BAK::MonsterIndex{i});
         }
         else
         {
             mCombatModels.emplace_back(std::nullopt);
-            mCombatModelDatas.emplace_back(std::nullopt);
         }
     }
 }
 
-void CombatModelLoader::LoadMonsterSprites(BAK::MonsterIndex m)
+CombatModelLoader::~CombatModelLoader()
+{
+    // Decoding reads mCombatModels
+    for (auto& [_, future] : mPendingModels)
+    {
+        future.wait();
+    }
+}
+
+void CombatModelLoader::Prefetch(BAK::MonsterIndex m)
+{
+    if (mCachedModels.contains(m.mValue)
+        || mPendingModels.contains(m.mValue)
+        || m.mValue >= mCombatModels.size()
+        || !mCombatModels[m.mValue])
+    {
+        return;
+    }
+
+    const auto* model = &(*mCombatModels[m.mValue]);
+    mPendingModels.emplace(
+        m.mValue,
+        ThreadPool::Get().Submit([m, model]{
+            return DecodeMonsterSprites(m, *model);
+        }));
+}
+
+std::shared_ptr<const CombatModelData> CombatModelLoader::GetCombatModelData(BAK::MonsterIndex m)
+{
+    if (auto it = mCachedModels.find(m.mValue); it != mCachedModels.end())
+    {
+        it->second.mLastUsed = ++mUseCount;
+        return it->second.mData;
+    }
+
+    if (m.mValue >= mCombatModels.size() || !mCombatModels[m.mValue])
+    {
+        return nullptr;
+    }
+
+    Prefetch(m);
+    auto pending = mPendingModels.extract(m.mValue);
+    auto sprites = pending.mapped().get();
+
+    auto& cached = mCachedModels[m.mValue];
+    if (sprites)
+    {
+        cached.mData = UploadMonsterSprites(m, *sprites);
+        const auto maxDim = std::size_t{sprites->mTextures.GetMaxDim()};
+        cached.mTextureBytes = sprites->mTextures.size() * maxDim * maxDim * sizeof(Graphics::Pixel);
+    }
+    cached.mLastUsed = ++mUseCount;
+    mCachedTextureBytes += cached.mTextureBytes;
+    auto data = cached.mData;
+
+    EvictUnused();
+    return data;
+}
+
+void CombatModelLoader::EvictUnused()
+{
+    while (mCachedTextureBytes > sMaxCachedTextureBytes)
+    {
+        // Models still held by an actor would not free anything
+        auto oldest = mCachedModels.end();
+        for (auto it = mCachedModels.begin(); it != mCachedModels.end(); ++it)
+        {
+            if (it->second.mData.use_count() == 1
+                && (oldest == mCachedModels.end() || it->second.mLastUsed < oldest->second.mLastUsed))
+            {
+                oldest = it;
+            }
+        }
+
+        if (oldest == mCachedModels.end())
+        {
+            return;
+        }
+
+        mLogger.Debug() << "Evicting model: " << oldest->first << "\n";
+        mCachedTextureBytes -= oldest->second.mTextureBytes;
+        mCachedModels.erase(oldest);
+    }
+}
+
+std::unique_ptr<CombatModelLoader::DecodedSprites> CombatModelLoader::DecodeMonsterSprites(
+    BAK::MonsterIndex m,
+    const BAK::CombatModel& model)
 {
     const auto& logger = Logging::LogState::GetLogger(__FUNCTION__);
     logger.Spam() << "Loading monster: " << m << "\n";
@@ -57,26 +158,25 @@ void CombatModelLoader::LoadMonsterSprites(BAK::MonsterIndex m)
     const auto prefix = ToUpper(monster.mPrefix);
     if (prefix.empty())
     {
-        return;
+        return nullptr;
     }
 
-    auto pal = BAK::Palette{BAK::ZoneLabel{1}.GetPalette()};
+    auto& resources = BAK::ResourceCache::Get();
+    const auto basePalette = BAK::ZoneLabel{1}.GetPalette();
+    auto pal = resources.GetPalette(basePalette);
     if (monster.mColorSwap <= 9)
     {
         auto ss = std::stringstream{};
         ss << "CS";
         ss << +monster.mColorSwap << ".DAT";
-        const auto cs = BAK::ColorSwap{ss.str()};
-        pal = BAK::Palette{pal, cs};
+        pal = resources.GetPalette(basePalette, ss.str());
     }
 
     auto LoadImages = [&](auto suffix)
     {
         std::stringstream ss{};
         ss << prefix << +suffix << ".BMX";
-        auto fb = BAK::FileBufferFactory::Get().CreateDataBuffer(ss.str());
-        const auto images = BAK::LoadImages(fb);
-        BAK::TextureFactory::AddToTextureStore(textureStore, images, pal);
+        BAK::TextureFactory::AddToTextureStore(textureStore, *resources.GetImages(ss.str()), *pal);
     };
 
     std::vector<std::size_t> offsets{0};
@@ -89,9 +189,7 @@ void CombatModelLoader::LoadMonsterSprites(BAK::MonsterIndex m)
     logger.Spam() << "Loaded all textures: " << textureStore.size()
         << " Offsets: " << offsets << "\n";
 
-    assert(mCombatModels[m.mValue]);
-    const auto& model = *mCombatModels[m.mValue];
-    Graphics::MeshObjectStorage objects{};
+    Graphics::MeshObjectStorageBuilder objects{};
     std::unordered_map<AnimationRequest, AnimationMeta> offsetMap{};
     std::vector<Graphics::MeshObjectStorage::OffsetAndLength> objectOffsets{};
     using enum BAK::Direction;
@@ -129,15 +227,27 @@ void CombatModelLoader::LoadMonsterSprites(BAK::MonsterIndex m)
         }
     }
 
+    return std::make_unique<DecodedSprites>(
+        std::move(textureStore),
+        std::move(objects).Build(),
+        std::move(offsetMap),
+        std::move(objectOffsets));
+}
+
+std::shared_ptr<const CombatModelData> CombatModelLoader::UploadMonsterSprites(
+    BAK::MonsterIndex m,
+    const DecodedSprites& sprites)
+{
     auto renderData = Graphics::RenderData{};
-    renderData.LoadData(objects, textureStore.GetTextures(), textureStore.GetMaxDim());
-    mCombatModelDatas.emplace_back(
-        std::make_optional(
-            CombatModelData{
-                std::move(renderData),
-                std::move(offsetMap),
-                std::move(objectOffsets)}));
-    Logging::LogDebug(__FUNCTION__) <<"Loaded model: " << prefix << " at index: " << mCombatModelDatas.size() - 1 << "\n";
+    renderData.LoadData(
+        sprites.mObjects,
+        sprites.mTextures.GetTextures(),
+        sprites.mTextures.GetMaxDim());
+    mLogger.Debug() << "Loaded model: " << m << " textures: " << sprites.mTextures.size() << "\n";
+    return std::make_shared<const CombatModelData>(
+        std::move(renderData),
+        sprites.mOffsetMap,
+        sprites.mObjectDrawData);
 }
 
 }
@@ -6,7 +6,13 @@
 #include "graphics/meshObject.hpp"
 #include "graphics/renderData.hpp"
 
+#include "com/logger.hpp"
+
+#include <cstdint>
+#include <future>
+#include <memory>
 #include <optional>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -50,18 +56,54 @@ struct CombatModelData
     std::vector<Graphics::MeshObjectStorage::OffsetAndLength> mObjectDrawData;
 };
 
+// Monster sprites are decoded and uploaded when first asked for, and kept
+// in a cache that drops the least recently used models no actor holds once
+// the cached textures grow past sMaxCachedTextureBytes.
 class CombatModelLoader
 {
     static constexpr auto sCombatModels = "COMBAT.TBL";
 public:
+    static constexpr std::size_t sMaxCachedTextureBytes = 128 * 1024 * 1024;
 
     CombatModelLoader();
+    ~CombatModelLoader();
+
+    CombatModelLoader(const CombatModelLoader&) = delete;
+    CombatModelLoader& operator=(const CombatModelLoader&) = delete;
+
+    // Starts decoding the monster's sprites on the thread pool, so that a
+    // later GetCombatModelData only has to upload them
+    void Prefetch(BAK::MonsterIndex m);
 
-    void LoadMonsterSprites(BAK::MonsterIndex m);
+    // Null if the monster has no sprites. Uploads to the GPU so must be
+    // called from the render thread.
+    std::shared_ptr<const CombatModelData> GetCombatModelData(BAK::MonsterIndex m);
 
     std::vector<std::optional<BAK::CombatModel>> mCombatModels{};
-    std::vector<std::optional<CombatModelData>> mCombatModelDatas{};
+
+private:
+    struct DecodedSprites;
+
+    struct CachedModel
+    {
+        std::shared_ptr<const CombatModelData> mData;
+        std::size_t mTextureBytes;
+        std::uint64_t mLastUsed;
+    };
+
+    static std::unique_ptr<DecodedSprites> DecodeMonsterSprites(
+        BAK::MonsterIndex m,
+        const BAK::CombatModel& model);
+    std::shared_ptr<const CombatModelData> UploadMonsterSprites(
+        BAK::MonsterIndex m,
+        const DecodedSprites& sprites);
+    void EvictUnused();
+
+    std::unordered_map<unsigned, CachedModel> mCachedModels;
+    std::unordered_map<unsigned, std::future<std::unique_ptr<DecodedSprites>>> mPendingModels;
+    std::size_t mCachedTextureBytes;
+    std::uint64_t mUseCount;
+    const Logging::Logger& mLogger;
 };
 
 }
-
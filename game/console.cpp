@@ -31,8 +31,7 @@ std::streamsize Console::xsputn(const char_type* s, std::streamsize n)
         if (s[i] == '\n')
         {
             mStreamBuffer += std::string{s + from, i - from};
-            AddLog(mStreamBuffer.c_str());
-            mStreamBuffer.clear();
+            QueueLog();
             from = i;
         }
     }
@@ -50,12 +49,30 @@ Console::int_type Console::overflow(int_type c)
     mStreamBuffer += std::string{1, static_cast<char_type>(c)};
     if (c == '\n')
     {
-        AddLog(mStreamBuffer.c_str());
-        mStreamBuffer.clear();
+        QueueLog();
     }
     return c;
 }
 
+// The log can be written from the async log sink's thread, so lines are
+// only added to the console when it is drawn
+void Console::QueueLog()
+{
+    auto lock = std::unique_lock{mQueuedLogsMutex};
+    mQueuedLogs.emplace_back(std::move(mStreamBuffer));
+    mStreamBuffer.clear();
+}
+
+void Console::AddQueuedLogs()
+{
+    auto lock = std::unique_lock{mQueuedLogsMutex};
+    for (const auto& line : mQueuedLogs)
+    {
+        AddLog("%s", line.c_str());
+    }
+    mQueuedLogs.clear();
+}
+
 // Console commands
 void Console::ShowTeleports(const std::vector<std::string>& words)
 {
@@ -192,6 +209,12 @@ void Console::SaveGame(const std::vector<std::string>& words)
         return;
     }
 
+    if (mGameRunner && mGameRunner->IsZoneLoading())
+    {
+        AddLog("[error] SAVE_GAME FAILED Zone is loading");
+        return;
+    }
+
     const auto saved = mGameState->Save(words[1]);
     if (saved)
         AddLog("Game saved to: %s", words[1].c_str());
@@ -599,7 +622,9 @@ void Console::DisableLogger(const std::vector<std::string>& words)
 Console::Console()
 :
     mStream{this},
-    mStreamBuffer{}
+    mStreamBuffer{},
+    mQueuedLogsMutex{},
+    mQueuedLogs{}
 {
     ClearLog();
     memset(mInputBuf, 0, sizeof(mInputBuf));
@@ -696,6 +721,8 @@ Console::Console()
 
 Console::~Console()
 {
+    if (mStreamLog)
+        Logging::LogState::RemoveStream(&mStream);
     ClearLog();
     for (int i = 0; i < mHistory.Size; i++)
         free(mHistory[i]);
@@ -731,6 +758,8 @@ void Console::AddLog(const char* fmt, ...)
 
 void Console::Draw(const char* title, bool* p_open)
 {
+    AddQueuedLogs();
+
     ImGui::SetNextWindowSize(ImVec2(520, 600), ImGuiCond_FirstUseEver);
     if (!ImGui::Begin(title, p_open))
     {
@@ -7,6 +7,9 @@
 #include "imgui/imgui.h"
 
 #include <iomanip>
+#include <mutex>
+#include <string>
+#include <vector>
 
 class Camera;
 namespace BAK {
@@ -55,6 +58,8 @@ struct Console : public std::streambuf
     ~Console();
     
     void ToggleLog();
+    void QueueLog();
+    void AddQueuedLogs();
     void ClearLog();
     void AddLog(const char* fmt, ...) IM_FMTARGS(2);
     void Draw(const char* title, bool* p_open);
@@ -76,6 +81,8 @@ struct Console : public std::streambuf
     bool                  mStreamLog;
     std::ostream          mStream;
     std::string mStreamBuffer;
+    std::mutex mQueuedLogsMutex;
+    std::vector<std::string> mQueuedLogs;
 
     Camera*  mCamera;
     Game::GameRunner*  mGameRunner;
@@ -48,6 +48,7 @@
 #include <glm/gtx/rotate_vector.hpp>
 
 #include <cassert>
+#include <cstdlib>
 #include <unordered_set>
 #include <utility>
 #include <variant>
@@ -98,6 +99,8 @@ GameRunner::GameRunner(
     mCombatPlayerPos{},
     mGlyphStore{},
     mZoneRenderData{},
+    mPendingZone{},
+    mQueuedTransition{},
     mEncounterHandler{
         mGameState,
         mGuiManager,
@@ -138,12 +141,12 @@ void GameRunner::DoTeleport(BAK::Encounter::Teleport teleport)
     mLogger.Debug() << "Teleporting to: " << teleport << "\n";
     if (teleport.mTargetZone)
     {
-        DoTransition(
+        StartTransition(
             *teleport.mTargetZone,
-            teleport.mTargetLocation);
+            teleport.mTargetLocation,
+            teleport.mTargetGDSScene);
     }
-
-    if (teleport.mTargetGDSScene)
+    else if (teleport.mTargetGDSScene)
     {
         mGuiManager.TeleportToGDS(
             *teleport.mTargetGDSScene);
@@ -238,12 +241,26 @@ void GameRunner::UpdateOrthoProjection(glm::uvec2 dims)
 
 void GameRunner::LoadZoneData(BAK::ZoneNumber zone)
 {
-    mZoneData = std::make_unique<BAK::Zone>(zone.mValue);
-    mZoneRenderData = std::make_unique<Graphics::RenderData>();
-    mZoneRenderData->LoadData(
-        mZoneData->mObjects,
-        mZoneData->mZoneTextures.GetTextures(),
-        mZoneData->mZoneTextures.GetMaxDim());
+    // Loading directly supersedes any transition still in progress
+    mPendingZone.reset();
+    mQueuedTransition.reset();
+
+    auto zoneData = mZoneStreamer.Take(zone);
+    auto renderData = std::make_unique<Graphics::RenderData>();
+    renderData->LoadData(
+        zoneData->mObjects,
+        zoneData->mZoneTextures.GetAtlas().GetLayers(),
+        zoneData->mZoneTextures.GetAtlas().GetLayerDim());
+    SetZoneData(zone, std::move(zoneData), std::move(renderData));
+}
+
+void GameRunner::SetZoneData(
+    BAK::ZoneNumber zone,
+    std::unique_ptr<BAK::Zone> zoneData,
+    std::unique_ptr<Graphics::RenderData> renderData)
+{
+    mZoneData = std::move(zoneData);
+    mZoneRenderData = std::move(renderData);
     LoadSystems();
 
     mZoomManager.LoadZoneDefaults(zone);
@@ -251,7 +268,7 @@ void GameRunner::LoadZoneData(BAK::ZoneNumber zone)
         static_cast<float>(mZoomManager.GetDefaultCameraHeight()));
 
     mCombatManager.SetGridColor(
-        mZoneData->mPalette.GetColor(BAK::LoadCombatGridColour(zone)));
+        mZoneData->mPalette->GetColor(BAK::LoadCombatGridColour(zone)));
 
     mPartyCamera.SetGameLocation(mGameState.GetLocation());
     mCurrentTile = mPartyCamera.GetGameTile();
@@ -265,12 +282,41 @@ void GameRunner::LoadZoneData(BAK::ZoneNumber zone)
         mPartyCamera.UsePerspectiveMatrix();
         mViewCamera.UsePerspectiveMatrix();
     }
+
+    PrefetchNeighbourZones(mCurrentTile);
 }
 
 void GameRunner::DoTransition(
     BAK::ZoneNumber targetZone,
     BAK::GamePositionAndHeading targetLocation)
 {
+    StartTransition(targetZone, targetLocation, std::nullopt);
+}
+
+void GameRunner::StartTransition(
+    BAK::ZoneNumber targetZone,
+    BAK::GamePositionAndHeading targetLocation,
+    std::optional<BAK::HotspotRef> targetGDSScene)
+{
+    if (mPendingZone)
+    {
+        mLogger.Debug() << "Queueing transition to: " << targetZone
+            << " while loading zone: " << mPendingZone->mZone << "\n";
+        mQueuedTransition = BAK::Encounter::Teleport{
+            targetZone, targetLocation, targetGDSScene};
+        return;
+    }
+
+    if (mAsyncZoneLoading && mZoneData
+        && mZoneStreamer.Prefetch(targetZone, {targetZone}))
+    {
+        // Combats are cleared, the location set and the GDS scene entered
+        // once the zone is swapped in, until then the old zone remains current
+        mPendingZone = PendingZone{
+            targetZone, targetLocation, targetGDSScene, nullptr, nullptr};
+        return;
+    }
+
     CleanCombatsOnNewZone();
     mGameState.SetLocation(
         BAK::Location{
@@ -279,6 +325,105 @@ void GameRunner::DoTransition(
             targetLocation});
 
     LoadZoneData(targetZone);
+
+    if (targetGDSScene)
+    {
+        mGuiManager.TeleportToGDS(*targetGDSScene);
+    }
+}
+
+void GameRunner::UpdateZoneStreaming()
+{
+    if (!mPendingZone)
+    {
+        return;
+    }
+
+    auto& pending = *mPendingZone;
+    if (!pending.mZoneData)
+    {
+        if (!mZoneStreamer.IsReady(pending.mZone))
+        {
+            return;
+        }
+
+        pending.mZoneData = mZoneStreamer.Take(pending.mZone);
+        pending.mRenderData = std::make_unique<Graphics::RenderData>();
+        pending.mRenderData->BeginLoadData(
+            pending.mZoneData->mObjects,
+            pending.mZoneData->mZoneTextures.GetAtlas().GetLayers(),
+            pending.mZoneData->mZoneTextures.GetAtlas().GetLayerDim());
+        return;
+    }
+
+    if (!pending.mRenderData->ContinueLoadData(sZoneUploadBytesPerFrame))
+    {
+        return;
+    }
+
+    auto finished = std::move(pending);
+    mPendingZone.reset();
+
+    mLogger.Debug() << "Swapping in zone: " << finished.mZone << "\n";
+    CleanCombatsOnNewZone();
+    mGameState.SetLocation(
+        BAK::Location{
+            finished.mZone,
+            BAK::GetTile(finished.mLocation.mPosition),
+            finished.mLocation});
+    SetZoneData(
+        finished.mZone,
+        std::move(finished.mZoneData),
+        std::move(finished.mRenderData));
+
+    if (finished.mGDSScene)
+    {
+        mGuiManager.TeleportToGDS(*finished.mGDSScene);
+    }
+
+    if (mQueuedTransition)
+    {
+        auto next = *mQueuedTransition;
+        mQueuedTransition.reset();
+        DoTeleport(next);
+    }
+}
+
+void GameRunner::PrefetchNeighbourZones(glm::uvec2 tile)
+{
+    if (!mAsyncZoneLoading || !mZoneData)
+    {
+        return;
+    }
+
+    const auto currentZone = mGameState.GetZone();
+    std::vector<BAK::ZoneNumber> targets{};
+    for (const auto& world : mZoneData->mWorldTiles.GetTiles())
+    {
+        const auto worldTile = world.GetTile();
+        const auto dx = std::abs(static_cast<int>(worldTile.x) - static_cast<int>(tile.x));
+        const auto dy = std::abs(static_cast<int>(worldTile.y) - static_cast<int>(tile.y));
+        if (dx > 1 || dy > 1)
+        {
+            continue;
+        }
+
+        for (const auto& encounter : world.GetEncounters(mGameState.GetChapter()))
+        {
+            const auto* zone = std::get_if<BAK::Encounter::Zone>(&encounter.GetEncounter());
+            if (zone != nullptr
+                && zone->mTargetZone != currentZone
+                && std::find(targets.begin(), targets.end(), zone->mTargetZone) == targets.end())
+            {
+                targets.emplace_back(zone->mTargetZone);
+            }
+        }
+    }
+
+    for (const auto& target : targets)
+    {
+        mZoneStreamer.Prefetch(target, targets);
+    }
 }
 
 void GameRunner::LoadSystems()
@@ -398,6 +543,8 @@ void GameRunner::LoadSystems()
                     item.GetLocation(),
                     rotation,
                     glm::vec3{static_cast<float>(zoneItem.GetScale())}};
+                renderable.SetBoundingRadius(
+                    zoneItem.GetBoundingRadius() * zoneItem.GetScale());
 
                 if (item.GetZoneItem().IsSprite())
                     mSystems->AddSprite(renderable);
@@ -415,28 +562,7 @@ void GameRunner::LoadSystems()
                 SetupCatapult(id, entityType, objectName);
                 SetupPit(id, entityType, item.GetBakLocation());
 
-                if (zoneItem.GetModelClip())
-                {
-                    auto collisionItem = CollisionItem{
-                        item.GetBakLocation(),
-                        item.GetRotation().y,
-                        static_cast<float>(zoneItem.GetScale()),
-                        &(*zoneItem.GetModelClip()),
-                        entityType};
-
-                    const bool blocks = BAK::BlocksMovement(zoneItem);
-                    const bool allows = BAK::AllowsMovement(zoneItem);
-                    const bool isDoor = entityType == BAK::EntityType::DOOR;
-
-                    if (blocks || isDoor)
-                    {
-                        mSystems->AddBlockable(collisionItem);
-                    }
-                    if (allows || isDoor)
-                    {
-                        mSystems->AddAllowable(collisionItem);
-                    }
-                }
+                AddZoneCollisionItem(*mSystems, item);
 
                 if (zoneItem.GetClickable())
                 {
@@ -725,7 +851,7 @@ void GameRunner::LoadTileActors(std::uint8_t tileIndex)
                 continue;
             }
 
-            if (!mCombatModelLoader.mCombatModelDatas[combatant.mMonster])
+            if (!mCombatModelLoader.GetCombatModelData(BAK::MonsterIndex{combatant.mMonster}))
             {
                 mLogger.Error() << "Couldn't load combat model: " << combatant.mMonster << "\n";
                 continue;
@@ -780,6 +906,28 @@ void GameRunner::UnloadWorldActors()
 
 void GameRunner::LoadWorldActors()
 {
+    // Decode every monster sprite the zone or a fight could need in
+    // parallel, LoadTileActors then only uploads them
+    for (const auto& world : mZoneData->mWorldTiles.GetTiles())
+    {
+        for (const auto& encounter : world.GetEncounters(mGameState.GetChapter()))
+        {
+            const auto* combat = std::get_if<BAK::Encounter::Combat>(&encounter.GetEncounter());
+            if (!combat)
+            {
+                continue;
+            }
+            for (const auto& combatant : combat->mCombatants)
+            {
+                mCombatModelLoader.Prefetch(BAK::MonsterIndex{combatant.mMonster});
+            }
+        }
+    }
+    mGameState.GetParty().ForEachActiveCharacter([&](const auto& character){
+        mCombatModelLoader.Prefetch(character.GetMonsterIndex());
+        return BAK::Loop::Continue;
+    });
+
     for (const auto& world : mZoneData->mWorldTiles.GetTiles())
     {
         LoadTileActors(world.GetTileIndex());
@@ -1172,6 +1320,7 @@ void GameRunner::RunGameUpdate(bool advanceTime)
 void GameRunner::OnEnterTile(glm::uvec2 tile)
 {
     mGameState.Apply(BAK::State::ClearTileRecentEncounters);
+    PrefetchNeighbourZones(tile);
 
     if (!mGameState.IsUnderground())
         return;
@@ -1355,6 +1504,7 @@ void GameRunner::HandleRightClick(unsigned entityId)
 
 void GameRunner::OnTimeDelta(double timeDelta)
 {
+    UpdateZoneStreaming();
     mCombatStage.OnTimeDelta(timeDelta);
     if (mGridVisible && mSystems) UpdateGridCellColors();
 }
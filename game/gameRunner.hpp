@@ -10,6 +10,7 @@
 #include "game/interactable/factory.hpp"
 #include "game/systems.hpp"
 #include "game/movementManager.hpp"
+#include "game/zoneStreamer.hpp"
 #include "game/zoomManager.hpp"
 
 #include "game/gateAnimator.hpp"
@@ -85,6 +86,7 @@ public:
     /* IZoneLoader */
     void DoTeleport(BAK::Encounter::Teleport teleport) override;
     void LoadGame(std::string savePath, std::optional<BAK::Chapter> chapter) override;
+    bool IsZoneLoading() const override { return mPendingZone.has_value(); }
 
     /* ICameraManager */
     void ToggleFollowRoad() override;
@@ -99,6 +101,10 @@ public:
         BAK::GamePositionAndHeading targetLocation);
     void LoadSystems();
 
+    // When enabled, transitions build the new zone in the background and
+    // upload it over several frames while the current zone keeps rendering
+    void SetAsyncZoneLoading(bool enabled) { mAsyncZoneLoading = enabled; }
+
     void DoGenericContainer(BAK::EntityType et, BAK::GenericContainer& container, BAK::EntityIndex entityIndex);
     bool CheckAndDoEncounter(glm::uvec2 position);
     
@@ -120,7 +126,7 @@ public:
     ClipDisplayMode GetClipDisplayMode() const { return mClipDisplayMode; }
     void OnDoorStateChanged(BAK::DoorIndex doorIndex, bool isOpen);
     bool IsAnimationActive() const { return mAnimationActive || mCombatStage.IsAnimationActive(); }
-    bool InputDisabled() const { return mPitDeathInProgress || IsAnimationActive(); }
+    bool InputDisabled() const { return mPitDeathInProgress || IsAnimationActive() || IsZoneLoading(); }
     void ToggleUndergroundModels();
     bool HandleGridCellClick(unsigned entityId, bool isRightClick);
 
@@ -168,6 +174,28 @@ private:
     glm::uvec2 GetOrthoViewDimensions() const;
     float GetZoneFieldOfView() const;
     void UpdateOrthoProjection(glm::uvec2 dims);
+    void SetZoneData(
+        BAK::ZoneNumber zone,
+        std::unique_ptr<BAK::Zone> zoneData,
+        std::unique_ptr<Graphics::RenderData> renderData);
+    void StartTransition(
+        BAK::ZoneNumber targetZone,
+        BAK::GamePositionAndHeading targetLocation,
+        std::optional<BAK::HotspotRef> targetGDSScene);
+    void UpdateZoneStreaming();
+    void PrefetchNeighbourZones(glm::uvec2 tile);
+
+    // Bytes of mesh and texture data uploaded per frame for a streamed zone
+    static constexpr std::size_t sZoneUploadBytesPerFrame = 8 * 1024 * 1024;
+
+    struct PendingZone
+    {
+        BAK::ZoneNumber mZone;
+        BAK::GamePositionAndHeading mLocation;
+        std::optional<BAK::HotspotRef> mGDSScene;
+        std::unique_ptr<BAK::Zone> mZoneData;
+        std::unique_ptr<Graphics::RenderData> mRenderData;
+    };
 
 public:
     Camera& mPartyCamera;
@@ -199,6 +227,11 @@ public:
     glm::vec3 mPartyMarkerScale{};
 
     std::unique_ptr<Graphics::RenderData> mZoneRenderData{};
+    ZoneStreamer mZoneStreamer{};
+    bool mAsyncZoneLoading{false};
+    std::optional<PendingZone> mPendingZone;
+    // The latest transition asked for while mPendingZone loads
+    std::optional<BAK::Encounter::Teleport> mQueuedTransition;
     EncounterHandler mEncounterHandler;
 
     std::unordered_map<BAK::CombatIndex, std::vector<BAK::EntityIndex>> mCombatActorIds{};
@@ -36,13 +36,13 @@ void GlyphStore::Init(const Gui::Font& font)
     const auto& textures = characters.GetTextures();
     const auto maxDim = characters.GetMaxDim();
 
-    Graphics::MeshObjectStorage objects;
+    Graphics::MeshObjectStorageBuilder objects;
 
     for (unsigned i = 0; i < textures.size(); i++)
     {
         const auto& tex = textures[i];
-        float maxU = static_cast<float>(tex.GetWidth())  / maxDim;
-        float maxV = static_cast<float>(tex.GetHeight()) / maxDim;
+        float maxU = static_cast<float>(tex.GetWidth());
+        float maxV = static_cast<float>(tex.GetHeight());
         float layer = static_cast<float>(i);
         char c = font.GetFont().GetFirstChar() + i;
 
@@ -61,7 +61,7 @@ void GlyphStore::Init(const Gui::Font& font)
     }
 
     mGlyphRenderData = std::make_unique<Graphics::RenderData>();
-    mGlyphRenderData->LoadData(objects, characters.GetTextures(), maxDim);
+    mGlyphRenderData->LoadData(std::move(objects).Build(), characters.GetTextures(), maxDim);
 }
 
 }
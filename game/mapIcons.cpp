@@ -36,11 +36,11 @@ void MapIcons::Init()
 
     const auto& tex = textures.GetTexture(0);
     const auto maxDim = textures.GetMaxDim();
-    const float maxU = static_cast<float>(tex.GetWidth()) / maxDim;
-    const float maxV = static_cast<float>(tex.GetHeight()) / maxDim;
+    const float maxU = static_cast<float>(tex.GetWidth());
+    const float maxV = static_cast<float>(tex.GetHeight());
     const float layer = 0.0f;
 
-    Graphics::MeshObjectStorage objects;
+    Graphics::MeshObjectStorageBuilder objects;
 
     auto obj = objects.AddObject(
         "party_arrow",
@@ -53,7 +53,7 @@ void MapIcons::Init()
     mDimensions = tex.GetDims();
 
     mMapIconRenderData = std::make_unique<Graphics::RenderData>();
-    mMapIconRenderData->LoadData(objects, textures.GetTextures(), maxDim);
+    mMapIconRenderData->LoadData(std::move(objects).Build(), textures.GetTextures(), maxDim);
 }
 
 }
@@ -75,10 +75,9 @@ bool MovementManager::CannotMoveHere(BAK::GamePosition playerPos) const
 
     const auto playerBakPos = glm::ivec2{playerPos};
 
-    for (const auto& item : mSystems->GetNearbyCollisions(
-            mSystems->GetAllowables(), playerBakPos, sMaxCollisionDistSq))
+    for (const auto* item : mSystems->GetNearbyAllowables(playerBakPos, sMaxCollisionDistSq))
     {
-        auto doorIndex = GetDoorIndex(item.GetBakLocation());
+        auto doorIndex = GetDoorIndex(item->GetBakLocation());
         if (doorIndex && !BAK::State::GetDoorState(mGameState, *doorIndex))
         {
             continue;
@@ -86,20 +85,19 @@ bool MovementManager::CannotMoveHere(BAK::GamePosition playerPos) const
 
         auto modelSpace = BAK::WorldToModelClipSpace(
             glm::vec2{playerBakPos},
-            glm::vec2{item.GetBakLocation()},
-            item.GetRotationY(),
-            item.GetScale());
+            glm::vec2{item->GetBakLocation()},
+            item->GetRotationY(),
+            item->GetScale());
 
-        if (BAK::PointInModelClip(modelSpace, item.GetModelClip()))
+        if (BAK::PointInModelClip(modelSpace, item->GetModelClip()))
         {
             return false;
         }
     }
 
-    for (const auto& item : mSystems->GetNearbyCollisions(
-            mSystems->GetBlockables(), playerBakPos, sMaxCollisionDistSq))
+    for (const auto* item : mSystems->GetNearbyBlockables(playerBakPos, sMaxCollisionDistSq))
     {
-        auto doorIndex = GetDoorIndex(item.GetBakLocation());
+        auto doorIndex = GetDoorIndex(item->GetBakLocation());
         if (doorIndex && BAK::State::GetDoorState(mGameState, *doorIndex))
         {
             continue;
@@ -107,11 +105,11 @@ bool MovementManager::CannotMoveHere(BAK::GamePosition playerPos) const
 
         auto modelSpace = BAK::WorldToModelClipSpace(
             glm::vec2{playerBakPos},
-            glm::vec2{item.GetBakLocation()},
-            item.GetRotationY(),
-            item.GetScale());
+            glm::vec2{item->GetBakLocation()},
+            item->GetRotationY(),
+            item->GetScale());
 
-        if (BAK::PointInModelClip(modelSpace, item.GetModelClip()))
+        if (BAK::PointInModelClip(modelSpace, item->GetModelClip()))
         {
             return true;
         }
@@ -192,18 +190,17 @@ bool MovementManager::IsOnRoad(BAK::GamePosition playerPos) const
 
     const auto playerBakPos = glm::ivec2{playerPos};
 
-    for (const auto& item : mSystems->GetNearbyCollisions(
-            mSystems->GetAllowables(), playerBakPos, sMaxCollisionDistSq))
+    for (const auto* item : mSystems->GetNearbyAllowables(playerBakPos, sMaxCollisionDistSq))
     {
         auto modelSpace = BAK::WorldToModelClipSpace(
             glm::vec2{playerBakPos},
-            glm::vec2{item.GetBakLocation()},
-            item.GetRotationY(),
-            item.GetScale());
+            glm::vec2{item->GetBakLocation()},
+            item->GetRotationY(),
+            item->GetScale());
 
-        if (BAK::PointInModelClip(modelSpace, item.GetModelClip()))
+        if (BAK::PointInModelClip(modelSpace, item->GetModelClip()))
         {
-            auto type = item.GetEntityType();
+            auto type = item->GetEntityType();
             return type == BAK::EntityType::EXTERIOR
                 || type == BAK::EntityType::BRIDGE;
         }
@@ -216,21 +213,20 @@ bool MovementManager::IsOnPit(glm::uvec2 pos) const
 {
     const auto playerPos = glm::ivec2{pos};
 
-    for (const auto& item : mSystems->GetNearbyCollisions(
-            mSystems->GetAllowables(), playerPos, sMaxCollisionDistSq))
+    for (const auto* item : mSystems->GetNearbyAllowables(playerPos, sMaxCollisionDistSq))
     {
-        if (item.GetEntityType() != BAK::EntityType::PIT)
+        if (item->GetEntityType() != BAK::EntityType::PIT)
         {
             continue;
         }
 
         auto modelSpace = BAK::WorldToModelClipSpace(
             glm::vec2{playerPos},
-            glm::vec2{item.GetBakLocation()},
-            item.GetRotationY(),
-            item.GetScale());
+            glm::vec2{item->GetBakLocation()},
+            item->GetRotationY(),
+            item->GetScale());
 
-        if (BAK::PointInModelClip(modelSpace, item.GetModelClip()))
+        if (BAK::PointInModelClip(modelSpace, item->GetModelClip()))
         {
             return true;
         }
@@ -248,7 +244,7 @@ std::optional<PitCross> MovementManager::GetPitCross(
     const auto direction = BAK::HeadingToDirection(heading);
     if (!BAK::IsCardinal(direction))
     {
-        mLogger.Debug() << __FUNCTION__ << " Not adjacent to pit direction is: "
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " Not adjacent to pit direction is: "
             << BAK::ToString(direction) << "\n";
         return std::nullopt;
     }
@@ -258,7 +254,7 @@ std::optional<PitCross> MovementManager::GetPitCross(
 
     if (distance > BAK::gCellSize * 2)
     {
-        mLogger.Debug() << __FUNCTION__ << " Too far from pit: " << distance
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " Too far from pit: " << distance
             << " " << cellDistance << "\n";
         return std::nullopt;
     }
@@ -277,7 +273,7 @@ std::optional<PitCross> MovementManager::GetPitCross(
         }
     }
 
-    mLogger.Spam() << __FUNCTION__ << " Pit cell center: " << pitCellPos
+    LOG_SPAM(mLogger) << __FUNCTION__ << " Pit cell center: " << pitCellPos
         << " party cell center: " << partyCellPos
         << " heading: " << heading
         << " landing: " << landingCell
@@ -335,21 +331,20 @@ float MovementManager::ComputeTerrainHeight(BAK::GamePosition playerPos) const
 
     const auto playerBakPos = glm::ivec2{playerPos};
 
-    for (const auto& item : mSystems->GetNearbyCollisions(
-            mSystems->GetAllowables(), playerBakPos, sMaxCollisionDistSq))
+    for (const auto* item : mSystems->GetNearbyAllowables(playerBakPos, sMaxCollisionDistSq))
     {
         auto modelSpace = BAK::WorldToModelClipSpace(
             glm::vec2{playerBakPos},
-            glm::vec2{item.GetBakLocation()},
-            item.GetRotationY(),
-            item.GetScale());
+            glm::vec2{item->GetBakLocation()},
+            item->GetRotationY(),
+            item->GetScale());
 
-        auto height = BAK::ComputeHeight(modelSpace, item.GetModelClip());
+        auto height = BAK::ComputeHeight(modelSpace, item->GetModelClip());
         if (height)
         {
             return BAK::ComputeWorldHeight(
                 *height,
-                item.GetScale(),
+                item->GetScale(),
                 mDefaultHeight);
         }
     }
@@ -360,11 +355,11 @@ float MovementManager::ComputeTerrainHeight(BAK::GamePosition playerPos) const
 std::optional<BAK::GameHeading> MovementManager::GetOpenDirection(
     BAK::GamePositionAndHeading playerLocation, float distance, bool followRoad) const
 {
-    mLogger.Debug() << __FUNCTION__ << " Input: " << playerLocation << " distance: " << distance << " followRoad: " << followRoad << "\n";
+    LOG_DEBUG(mLogger) << __FUNCTION__ << " Input: " << playerLocation << " distance: " << distance << " followRoad: " << followRoad << "\n";
 
     if (!mSystems)
     {
-        mLogger.Debug() << __FUNCTION__ << " No systems, returning nullopt\n";
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " No systems, returning nullopt\n";
         return std::nullopt;
     }
 
@@ -383,7 +378,7 @@ std::optional<BAK::GameHeading> MovementManager::GetOpenDirection(
     auto maxSearchAngleLeft  = BAK::RotateHeading(currentHeading, negativeNinetyDegrees);
     auto maxSearchAngleRight = BAK::RotateHeading(currentHeading, BAK::gBakNinetyDegrees);
 
-    mLogger.Debug() << __FUNCTION__ << " currentHeading: " << currentHeading
+    LOG_DEBUG(mLogger) << __FUNCTION__ << " currentHeading: " << currentHeading
         << " (" << BAK::ToString(BAK::HeadingToDirection(currentHeading)) << ")"
         << " leftStep: " << leftStep
         << " rightStep: " << rightStep
@@ -403,7 +398,7 @@ std::optional<BAK::GameHeading> MovementManager::GetOpenDirection(
     unsigned iteration = 0;
     while (currentSearchLeft != maxSearchAngleLeft)
     {
-        mLogger.Debug() << __FUNCTION__ << " [" << iteration << "]"
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " [" << iteration << "]"
             << " currentSearchLeft: " << currentSearchLeft
             << " (" << BAK::ToString(BAK::HeadingToDirection(currentSearchLeft)) << ")"
             << " currentSearchRight: " << currentSearchRight
@@ -414,17 +409,18 @@ std::optional<BAK::GameHeading> MovementManager::GetOpenDirection(
         headingToCheck.mHeading = currentSearchLeft;
         auto positionToCheck = BAK::MoveForward(headingToCheck, distance);
 
-        mLogger.Debug() << __FUNCTION__ << " [" << iteration << "]"
+        const bool cannotMoveLeft = CannotMoveHere(positionToCheck.mPosition);
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " [" << iteration << "]"
             << " Left check: heading=" << currentSearchLeft
             << " (" << BAK::ToString(BAK::HeadingToDirection(currentSearchLeft)) << ")"
             << " posToCheck=" << positionToCheck
-            << " cannotMove=" << CannotMoveHere(positionToCheck.mPosition)
+            << " cannotMove=" << cannotMoveLeft
             << "\n";
 
-        if (!CannotMoveHere(positionToCheck.mPosition))
+        if (!cannotMoveLeft)
         {
             openLeft = currentSearchLeft;
-            mLogger.Debug() << __FUNCTION__ << " [" << iteration << "]"
+            LOG_DEBUG(mLogger) << __FUNCTION__ << " [" << iteration << "]"
                 << " Left OPEN at heading " << *openLeft
                 << " (" << BAK::ToString(BAK::HeadingToDirection(*openLeft)) << ")"
                 << "\n";
@@ -434,17 +430,18 @@ std::optional<BAK::GameHeading> MovementManager::GetOpenDirection(
         headingToCheck.mHeading = currentSearchRight;
         positionToCheck = BAK::MoveForward(headingToCheck, distance);
 
-        mLogger.Debug() << __FUNCTION__ << " [" << iteration << "]"
+        const bool cannotMoveRight = CannotMoveHere(positionToCheck.mPosition);
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " [" << iteration << "]"
             << " Right check: heading=" << currentSearchRight
             << " (" << BAK::ToString(BAK::HeadingToDirection(currentSearchRight)) << ")"
             << " posToCheck=" << positionToCheck
-            << " cannotMove=" << CannotMoveHere(positionToCheck.mPosition)
+            << " cannotMove=" << cannotMoveRight
             << "\n";
 
-        if (!CannotMoveHere(positionToCheck.mPosition))
+        if (!cannotMoveRight)
         {
             openRight = currentSearchRight;
-            mLogger.Debug() << __FUNCTION__ << " [" << iteration << "]"
+            LOG_DEBUG(mLogger) << __FUNCTION__ << " [" << iteration << "]"
                 << " Right OPEN at heading " << *openRight
                 << " (" << BAK::ToString(BAK::HeadingToDirection(*openRight)) << ")"
                 << "\n";
@@ -452,7 +449,7 @@ std::optional<BAK::GameHeading> MovementManager::GetOpenDirection(
 
         if (openLeft || openRight)
         {
-            mLogger.Debug() << __FUNCTION__ << " [" << iteration << "]"
+            LOG_DEBUG(mLogger) << __FUNCTION__ << " [" << iteration << "]"
                 << " Found open direction, breaking"
                 << " openLeft=" << (openLeft ? std::to_string(*openLeft) : "nullopt")
                 << " openRight=" << (openRight ? std::to_string(*openRight) : "nullopt")
@@ -465,24 +462,24 @@ std::optional<BAK::GameHeading> MovementManager::GetOpenDirection(
 
     if (openLeft && openRight)
     {
-        mLogger.Debug() << __FUNCTION__ << " Both directions open (left=" << *openLeft
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " Both directions open (left=" << *openLeft
             << " right=" << *openRight << "), returning nullopt\n";
         return std::nullopt;
     }
     else if (openLeft)
     {
-        mLogger.Debug() << __FUNCTION__ << " Returning left heading " << *openLeft
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " Returning left heading " << *openLeft
             << " (" << BAK::ToString(BAK::HeadingToDirection(*openLeft)) << ")\n";
         return *openLeft;
     }
     else if (openRight)
     {
-        mLogger.Debug() << __FUNCTION__ << " Returning right heading " << *openRight
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " Returning right heading " << *openRight
             << " (" << BAK::ToString(BAK::HeadingToDirection(*openRight)) << ")\n";
         return *openRight;
     }
 
-    mLogger.Debug() << __FUNCTION__ << " No open direction found after " << iteration
+    LOG_DEBUG(mLogger) << __FUNCTION__ << " No open direction found after " << iteration
         << " iterations, returning nullopt\n";
     return std::nullopt;
 }
@@ -501,7 +498,7 @@ std::optional<BAK::GameHeading> MovementManager::GetOpenDirectionFollowRoad(
     const auto distToNext = gDirectionStep - distToBase;
     const auto nearest = distToBase <= distToNext ? base : next;
 
-    mLogger.Debug() << __FUNCTION__ << " current heading=" << currentHeading
+    LOG_DEBUG(mLogger) << __FUNCTION__ << " current heading=" << currentHeading
         << " (" << BAK::ToString(BAK::HeadingToDirection(currentHeading)) << ")"
         << " nearest cardinal=" << nearest
         << " (" << BAK::ToString(BAK::HeadingToDirection(nearest)) << ")"
@@ -516,7 +513,7 @@ std::optional<BAK::GameHeading> MovementManager::GetOpenDirectionFollowRoad(
         pos.mPosition = BAK::SnapPositionToCellCenter(pos.mPosition);
         const bool canMove = IsOnRoad(pos.mPosition);
 
-        mLogger.Debug() << __FUNCTION__ << " checkDirectionOpen: heading=" << candidate
+        LOG_DEBUG(mLogger) << __FUNCTION__ << " checkDirectionOpen: heading=" << candidate
             << " (" << BAK::ToString(BAK::HeadingToDirection(candidate)) << ")"
             << " posToCheck=" << pos
             << " canMove=" << canMove
@@ -766,7 +763,7 @@ bool MovementManager::Update()
     }
     else
     {
-        mLogger.Debug() << "Could move in either direction or not at all\n";
+        LOG_DEBUG(mLogger) << "Could move in either direction or not at all\n";
     }
 
     mCamera.RejectPendingMove();
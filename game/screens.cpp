@@ -57,7 +57,8 @@ void ShowDialogGui(
             ss << "Action :: " << action << std::endl;
         ImGui::TextWrapped(ss.str().c_str());
     }
-    ImGui::TextWrapped("Text:\n %s", snippet.GetText().data());
+    ImGui::TextWrapped("Text:\n %.*s",
+        static_cast<int>(snippet.GetText().size()), snippet.GetText().data());
 
     if (ImGui::Button("Back") && (!history.empty()))
     {
@@ -0,0 +1,112 @@
+#include "game/spatialGrid.hpp"
+
+#include "graphics/frustum.hpp"
+
+#include <cmath>
+
+namespace Game {
+
+SpatialGrid::SpatialGrid(float cellSize)
+:
+    mCellSize{cellSize},
+    mCells{},
+    mSize{0}
+{}
+
+void SpatialGrid::Clear()
+{
+    mCells.clear();
+    mSize = 0;
+}
+
+void SpatialGrid::Insert(unsigned index, glm::vec3 location, float radius)
+{
+    const auto extent = glm::vec3{radius};
+    auto [it, inserted] = mCells.try_emplace(
+        GetKey(GetCell(location)),
+        Cell{location - extent, location + extent, {}});
+    auto& cell = it->second;
+    if (!inserted)
+    {
+        cell.mMin = glm::min(cell.mMin, location - extent);
+        cell.mMax = glm::max(cell.mMax, location + extent);
+    }
+    cell.mItems.emplace_back(Item{index, location, radius});
+    mSize++;
+}
+
+void SpatialGrid::Query(
+    const Graphics::Frustum& frustum,
+    glm::vec3 position,
+    float maxDistance,
+    std::vector<unsigned>& result) const
+{
+    const auto lower = GetCell(position - glm::vec3{maxDistance});
+    const auto upper = GetCell(position + glm::vec3{maxDistance});
+    const auto cellsInRange = static_cast<std::size_t>(upper.x - lower.x + 1)
+        * static_cast<std::size_t>(upper.y - lower.y + 1);
+
+    // Cheaper to visit every occupied cell than every cell in range
+    if (cellsInRange > mCells.size())
+    {
+        for (const auto& [key, cell] : mCells)
+        {
+            QueryCell(cell, frustum, position, maxDistance, result);
+        }
+        return;
+    }
+
+    for (int z = lower.y; z <= upper.y; z++)
+    {
+        for (int x = lower.x; x <= upper.x; x++)
+        {
+            const auto it = mCells.find(GetKey(glm::ivec2{x, z}));
+            if (it != mCells.end())
+            {
+                QueryCell(it->second, frustum, position, maxDistance, result);
+            }
+        }
+    }
+}
+
+std::size_t SpatialGrid::size() const
+{
+    return mSize;
+}
+
+glm::ivec2 SpatialGrid::GetCell(glm::vec3 location) const
+{
+    return glm::ivec2{
+        static_cast<int>(std::floor(location.x / mCellSize)),
+        static_cast<int>(std::floor(location.z / mCellSize))};
+}
+
+std::int64_t SpatialGrid::GetKey(glm::ivec2 cell)
+{
+    return (static_cast<std::int64_t>(cell.x) << 32)
+        | static_cast<std::uint32_t>(cell.y);
+}
+
+void SpatialGrid::QueryCell(
+    const Cell& cell,
+    const Graphics::Frustum& frustum,
+    glm::vec3 position,
+    float maxDistance,
+    std::vector<unsigned>& result) const
+{
+    if (!frustum.Intersects(cell.mMin, cell.mMax))
+    {
+        return;
+    }
+
+    for (const auto& item : cell.mItems)
+    {
+        if (glm::distance(position, item.mLocation) <= maxDistance
+            && frustum.Intersects(item.mLocation, item.mRadius))
+        {
+            result.emplace_back(item.mIndex);
+        }
+    }
+}
+
+}
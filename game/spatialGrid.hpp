@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Graphics {
+class Frustum;
+}
+
+namespace Game {
+
+// Uniform grid over the ground plane (x, z). Items are referred to by an
+// index, e.g. into the vector they are stored in, and are bounded by a
+// sphere so that culling is conservative for items larger than a cell.
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(float cellSize);
+
+    void Clear();
+    void Insert(unsigned index, glm::vec3 location, float radius);
+
+    // Appends the indices of items within maxDistance of position whose
+    // bounds intersect the frustum. Only cells within maxDistance are
+    // visited, so the cost scales with the view rather than the zone.
+    void Query(
+        const Graphics::Frustum& frustum,
+        glm::vec3 position,
+        float maxDistance,
+        std::vector<unsigned>& result) const;
+
+    std::size_t size() const;
+
+private:
+    struct Item
+    {
+        unsigned mIndex;
+        glm::vec3 mLocation;
+        float mRadius;
+    };
+
+    struct Cell
+    {
+        // Bounds of the items in the cell, which may extend past the cell
+        glm::vec3 mMin;
+        glm::vec3 mMax;
+        std::vector<Item> mItems;
+    };
+
+    glm::ivec2 GetCell(glm::vec3 location) const;
+    static std::int64_t GetKey(glm::ivec2 cell);
+    void QueryCell(
+        const Cell& cell,
+        const Graphics::Frustum& frustum,
+        glm::vec3 position,
+        float maxDistance,
+        std::vector<unsigned>& result) const;
+
+    float mCellSize;
+    std::unordered_map<std::int64_t, Cell> mCells;
+    std::size_t mSize;
+};
+
+}
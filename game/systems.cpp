@@ -1,11 +1,14 @@
 #include "game/systems.hpp"
 
+#include "bak/collision.hpp"
 #include "bak/constants.hpp"
 #include "bak/model.hpp"
 #include "bak/types.hpp"
+#include "bak/worldFactory.hpp"
 
 #include "com/visit.hpp"
 
+#include "graphics/frustum.hpp"
 #include "graphics/glm.hpp"
 
 #include <glm/glm.hpp>
@@ -13,7 +16,10 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <optional>
+#include <tuple>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -161,9 +167,124 @@ float CollisionItem::GetScale() const { return mScale; }
 const BAK::ModelClip& CollisionItem::GetModelClip() const { return *mModelClip; }
 BAK::EntityType CollisionItem::GetEntityType() const { return mEntityType; }
 
+CollisionIndex::CollisionIndex()
+:
+    mItems{},
+    mCells{},
+    mCandidates{},
+    mNearby{}
+{}
+
+void CollisionIndex::Add(const CollisionItem& item)
+{
+    const auto index = static_cast<unsigned>(mItems.size());
+    mItems.emplace_back(item);
+    mCells[GetKey(GetCell(glm::vec2{item.GetBakLocation()}))].emplace_back(index);
+}
+
+std::span<const CollisionItem* const> CollisionIndex::GetNearby(
+    glm::ivec2 position,
+    float maxDistSq) const
+{
+    mCandidates.clear();
+    mNearby.clear();
+
+    const auto maxDist = std::sqrt(maxDistSq);
+    const auto lower = GetCell(glm::vec2{position} - glm::vec2{maxDist});
+    const auto upper = GetCell(glm::vec2{position} + glm::vec2{maxDist});
+    for (int y = lower.y; y <= upper.y; y++)
+    {
+        for (int x = lower.x; x <= upper.x; x++)
+        {
+            const auto it = mCells.find(GetKey(glm::ivec2{x, y}));
+            if (it == mCells.end())
+            {
+                continue;
+            }
+
+            for (const auto i : it->second)
+            {
+                const auto& bakLoc = mItems[i].GetBakLocation();
+                const float dx = static_cast<float>(position.x) - static_cast<float>(bakLoc.x);
+                const float dy = static_cast<float>(position.y) - static_cast<float>(bakLoc.y);
+                const float distSq = dx*dx + dy*dy;
+                if (distSq <= maxDistSq)
+                {
+                    mCandidates.emplace_back(Candidate{i, distSq});
+                }
+            }
+        }
+    }
+
+    // Items at the same distance stay in the order they were added
+    std::sort(mCandidates.begin(), mCandidates.end(),
+        [](const auto& a, const auto& b) {
+            return std::tie(a.mDistSq, a.mIndex) < std::tie(b.mDistSq, b.mIndex);
+        });
+
+    for (const auto& candidate : mCandidates)
+    {
+        mNearby.emplace_back(&mItems[candidate.mIndex]);
+    }
+    return mNearby;
+}
+
+const std::vector<CollisionItem>& CollisionIndex::GetItems() const
+{
+    return mItems;
+}
+
+glm::ivec2 CollisionIndex::GetCell(glm::vec2 position)
+{
+    return glm::ivec2{
+        static_cast<int>(std::floor(position.x / sCellSize)),
+        static_cast<int>(std::floor(position.y / sCellSize))};
+}
+
+std::int64_t CollisionIndex::GetKey(glm::ivec2 cell)
+{
+    return (static_cast<std::int64_t>(cell.x) << 32)
+        | static_cast<std::uint32_t>(cell.y);
+}
+
+namespace {
+
+void InsertRenderable(
+    Game::SpatialGrid& grid,
+    const std::vector<Renderable>& renderables,
+    unsigned index)
+{
+    const auto& renderable = renderables[index];
+    grid.Insert(index, renderable.GetLocation(), renderable.GetBoundingRadius());
+}
+
+void RebuildGrid(
+    Game::SpatialGrid& grid,
+    const std::vector<Renderable>& renderables)
+{
+    grid.Clear();
+    for (unsigned i = 0; i < renderables.size(); i++)
+    {
+        InsertRenderable(grid, renderables, i);
+    }
+}
+
+}
+
 Systems::Systems()
 :
-    mNextItemId{0}
+    mNextItemId{0},
+    mIntersectables{},
+    mRenderables{},
+    mSprites{},
+    mDynamicRenderables{},
+    mClickables{},
+    mBlockables{},
+    mAllowables{},
+    mTextRenderables{},
+    mRenderableGrid{BAK::gTileSize},
+    mSpriteGrid{BAK::gTileSize},
+    mCulledIndices{}
 {}
 
 BAK::EntityIndex Systems::GetNextItemId()
@@ -184,6 +305,7 @@ void Systems::AddClickable(const Clickable& item)
 void Systems::AddRenderable(const Renderable& item)
 {
     mRenderables.emplace_back(item);
+    InsertRenderable(mRenderableGrid, mRenderables, mRenderables.size() - 1);
 }
 
 void Systems::AddDynamicRenderable(const DynamicRenderable& item)
@@ -199,6 +321,8 @@ void Systems::RemoveRenderable(BAK::EntityIndex i)
     if (it != mRenderables.end())
     {
         mRenderables.erase(it);
+        // Indices after the removed renderable have all shifted
+        RebuildGrid(mRenderableGrid, mRenderables);
     }
 }
 
@@ -247,52 +371,31 @@ void Systems::RemoveClickable(BAK::EntityIndex i)
 void Systems::AddSprite(const Renderable& item)
 {
     mSprites.emplace_back(item);
+    InsertRenderable(mSpriteGrid, mSprites, mSprites.size() - 1);
 }
 
 void Systems::AddBlockable(const CollisionItem& item)
 {
-    mBlockables.emplace_back(item);
+    mBlockables.Add(item);
 }
 
 void Systems::AddAllowable(const CollisionItem& item)
 {
-    mAllowables.emplace_back(item);
+    mAllowables.Add(item);
 }
 
-std::vector<CollisionItem> Systems::GetNearbyCollisions(
-    const std::vector<CollisionItem>& items,
+std::span<const CollisionItem* const> Systems::GetNearbyBlockables(
     glm::ivec2 playerPos,
     float maxDistSq) const
 {
-    struct Candidate {
-        CollisionItem mItem;
-        float mDistSq;
-    };
-    std::vector<Candidate> candidates;
-
-    for (const auto& item : items)
-    {
-        const auto& bakLoc = item.GetBakLocation();
-        const float dx = static_cast<float>(playerPos.x) - static_cast<float>(bakLoc.x);
-        const float dy = static_cast<float>(playerPos.y) - static_cast<float>(bakLoc.y);
-        const float distSq = dx*dx + dy*dy;
-        if (distSq > maxDistSq)
-        {
-            continue;
-        }
-        candidates.push_back({item, distSq});
-    }
-
-    std::sort(candidates.begin(), candidates.end(),
-        [](const auto& a, const auto& b) { return a.mDistSq < b.mDistSq; });
+    return mBlockables.GetNearby(playerPos, maxDistSq);
+}
 
-    std::vector<CollisionItem> result;
-    result.reserve(candidates.size());
-    for (auto& c : candidates)
-    {
-        result.push_back(std::move(c.mItem));
-    }
-    return result;
+std::span<const CollisionItem* const> Systems::GetNearbyAllowables(
+    glm::ivec2 playerPos,
+    float maxDistSq) const
+{
+    return mAllowables.GetNearby(playerPos, maxDistSq);
 }
 
 void Systems::EnableSprite(BAK::EntityIndex id, bool visible)
@@ -306,6 +409,35 @@ void Systems::EnableSprite(BAK::EntityIndex id, bool visible)
     }
 }
 
+void Systems::CullRenderables(
+    const glm::mat4& viewProjection,
+    glm::vec3 position,
+    float maxDistance,
+    VisibleRenderables& visible) const
+{
+    // Renderable locations are in world units, but the view projection
+    // works on locations scaled down by the world scale
+    const auto frustum = Graphics::Frustum{
+        viewProjection * glm::scale(glm::mat4{1.0f}, glm::vec3{1.0f / BAK::gWorldScale})};
+
+    const auto Cull = [&](
+        const Game::SpatialGrid& grid,
+        const std::vector<Renderable>& renderables,
+        std::vector<const Renderable*>& result)
+    {
+        mCulledIndices.clear();
+        grid.Query(frustum, position, maxDistance, mCulledIndices);
+        result.clear();
+        for (const auto i : mCulledIndices)
+        {
+            result.emplace_back(&renderables[i]);
+        }
+    };
+
+    Cull(mRenderableGrid, mRenderables, visible.mRenderables);
+    Cull(mSpriteGrid, mSprites, visible.mSprites);
+}
+
 std::vector<BAK::EntityIndex> Systems::RunIntersection(glm::vec3 cameraPos) const
 {
     auto result = std::vector<BAK::EntityIndex>{};
@@ -369,6 +501,35 @@ const std::vector<Renderable>& Systems::GetRenderables() const { return mRendera
 const std::vector<DynamicRenderable>& Systems::GetDynamicRenderables() const { return mDynamicRenderables; }
 const std::vector<Renderable>& Systems::GetSprites() const { return mSprites; }
 const std::vector<Clickable>& Systems::GetClickables() const { return mClickables; }
-const std::vector<CollisionItem>& Systems::GetBlockables() const { return mBlockables; }
-const std::vector<CollisionItem>& Systems::GetAllowables() const { return mAllowables; }
+const std::vector<CollisionItem>& Systems::GetBlockables() const { return mBlockables.GetItems(); }
+const std::vector<CollisionItem>& Systems::GetAllowables() const { return mAllowables.GetItems(); }
 
+void AddZoneCollisionItem(Systems& systems, const BAK::WorldItemInstance& item)
+{
+    const auto& zoneItem = item.GetZoneItem();
+    if (!zoneItem.GetModelClip())
+    {
+        return;
+    }
+
+    const auto entityType = zoneItem.GetEntityType();
+    auto collisionItem = CollisionItem{
+        item.GetBakLocation(),
+        item.GetRotation().y,
+        static_cast<float>(zoneItem.GetScale()),
+        &(*zoneItem.GetModelClip()),
+        entityType};
+
+    const bool blocks = BAK::BlocksMovement(zoneItem);
+    const bool allows = BAK::AllowsMovement(zoneItem);
+    const bool isDoor = entityType == BAK::EntityType::DOOR;
+
+    if (blocks || isDoor)
+    {
+        systems.AddBlockable(collisionItem);
+    }
+    if (allows || isDoor)
+    {
+        systems.AddAllowable(collisionItem);
+    }
+}
@@ -6,6 +6,8 @@
 
 #include "com/visit.hpp"
 
+#include "game/spatialGrid.hpp"
+
 #include "graphics/glm.hpp"
 #include "graphics/renderer.hpp"
 
@@ -14,10 +16,17 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cstdint>
 #include <optional>
+#include <span>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
+namespace BAK {
+class WorldItemInstance;
+}
+
 namespace BAK {
 struct ModelClip;
 }
@@ -72,6 +81,9 @@ private:
 class Renderable
 {
 public:
+    // Used for culling when the size of the object is not known
+    static constexpr float sDefaultBoundingRadius = BAK::gTileSize;
+
     Renderable(
         BAK::EntityIndex itemId,
         std::pair<unsigned, unsigned> object,
@@ -94,6 +106,8 @@ public:
     void SetVisible(bool visible) { mVisible = visible; }
     bool GetVisible() const { return mVisible; }
     void SetObject(std::pair<unsigned, unsigned> object) { mObject = object; }
+    void SetBoundingRadius(float radius) { mBoundingRadius = radius; }
+    float GetBoundingRadius() const { return mBoundingRadius; }
 private:
     glm::mat4 CalculateModelMatrix();
 
@@ -108,6 +122,7 @@ private:
 
     const std::optional<glm::vec4>* mInstanceColor{nullptr};
     bool mVisible{true};
+    float mBoundingRadius{sDefaultBoundingRadius};
 };
 
 class Tickable
@@ -184,6 +199,50 @@ private:
     BAK::EntityType mEntityType;
 };
 
+// Collision items bucketed by the cell they are in, so that finding the
+// items near the player only looks at the cells around them
+class CollisionIndex
+{
+public:
+    static constexpr float sCellSize = BAK::gTileSize;
+
+    CollisionIndex();
+
+    void Add(const CollisionItem& item);
+
+    // The items within sqrt(maxDistSq) of position, nearest first. The span
+    // refers to storage that is reused, so it is only valid until the next
+    // call to GetNearby or Add.
+    std::span<const CollisionItem* const> GetNearby(
+        glm::ivec2 position,
+        float maxDistSq) const;
+
+    const std::vector<CollisionItem>& GetItems() const;
+
+private:
+    struct Candidate
+    {
+        unsigned mIndex;
+        float mDistSq;
+    };
+
+    static glm::ivec2 GetCell(glm::vec2 position);
+    static std::int64_t GetKey(glm::ivec2 cell);
+
+    std::vector<CollisionItem> mItems;
+    std::unordered_map<std::int64_t, std::vector<unsigned>> mCells;
+    mutable std::vector<Candidate> mCandidates;
+    mutable std::vector<const CollisionItem*> mNearby;
+};
+
+// Renderables that may be seen from a camera, for the renderer to draw
+// instead of every renderable in the zone
+struct VisibleRenderables
+{
+    std::vector<const Renderable*> mRenderables;
+    std::vector<const Renderable*> mSprites;
+};
+
 class Systems
 {
 public:
@@ -203,12 +262,24 @@ public:
     void EnableSprite(BAK::EntityIndex id, bool visible);
     void AddBlockable(const CollisionItem& item);
     void AddAllowable(const CollisionItem& item);
-    std::vector<CollisionItem> GetNearbyCollisions(
-        const std::vector<CollisionItem>& items,
+    // See CollisionIndex::GetNearby
+    std::span<const CollisionItem* const> GetNearbyBlockables(
+        glm::ivec2 playerPos,
+        float maxDistSq) const;
+    std::span<const CollisionItem* const> GetNearbyAllowables(
         glm::ivec2 playerPos,
         float maxDistSq) const;
     std::vector<BAK::EntityIndex> RunIntersection(glm::vec3 cameraPos) const;
 
+    // Finds the renderables and sprites within maxDistance of position
+    // and inside the view volume of viewProjection. The pointers are valid
+    // until renderables are next added or removed.
+    void CullRenderables(
+        const glm::mat4& viewProjection,
+        glm::vec3 position,
+        float maxDistance,
+        VisibleRenderables& visible) const;
+
     BAK::EntityIndex AddTextRenderable(Graphics::TextRenderable r);
     Graphics::TextRenderable* GetTextRenderable(BAK::EntityIndex id);
     void RemoveTextRenderable(BAK::EntityIndex id);
@@ -231,7 +302,16 @@ private:
     std::vector<Renderable> mSprites;
     std::vector<DynamicRenderable> mDynamicRenderables;
     std::vector<Clickable> mClickables;
-    std::vector<CollisionItem> mBlockables;
-    std::vector<CollisionItem> mAllowables;
+    CollisionIndex mBlockables;
+    CollisionIndex mAllowables;
     std::vector<Graphics::TextRenderable> mTextRenderables;
+
+    Game::SpatialGrid mRenderableGrid;
+    Game::SpatialGrid mSpriteGrid;
+    // Scratch space for CullRenderables
+    mutable std::vector<unsigned> mCulledIndices;
 };
+
+// Adds the collision of a zone item to systems, as a blockable and/or an
+// allowable. Items without a model clip have no collision.
+void AddZoneCollisionItem(Systems& systems, const BAK::WorldItemInstance& item);
@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include "game/systems.hpp"
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+static constexpr auto sCellSize = static_cast<unsigned>(CollisionIndex::sCellSize);
+
+CollisionItem MakeItem(glm::uvec2 location)
+{
+    return CollisionItem{location, 0, 1, nullptr, BAK::EntityType::TREE};
+}
+
+// Indices of the items within range, nearest first then in insertion order
+std::vector<unsigned> BruteForce(
+    const std::vector<CollisionItem>& items,
+    glm::ivec2 position,
+    float maxDistSq)
+{
+    std::vector<std::pair<float, unsigned>> candidates{};
+    for (unsigned i = 0; i < items.size(); i++)
+    {
+        const auto& bakLoc = items[i].GetBakLocation();
+        const float dx = static_cast<float>(position.x) - static_cast<float>(bakLoc.x);
+        const float dy = static_cast<float>(position.y) - static_cast<float>(bakLoc.y);
+        const float distSq = dx*dx + dy*dy;
+        if (distSq <= maxDistSq)
+        {
+            candidates.emplace_back(distSq, i);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    std::vector<unsigned> result{};
+    for (const auto& [distSq, i] : candidates)
+    {
+        result.emplace_back(i);
+    }
+    return result;
+}
+
+std::vector<unsigned> ToIndices(
+    const std::vector<CollisionItem>& items,
+    std::span<const CollisionItem* const> nearby)
+{
+    std::vector<unsigned> result{};
+    for (const auto* item : nearby)
+    {
+        result.emplace_back(static_cast<unsigned>(item - items.data()));
+    }
+    return result;
+}
+
+}
+
+TEST(CollisionIndexTest, MatchesBruteForceAroundCellBoundaries)
+{
+    auto index = CollisionIndex{};
+    // Items on, and either side of, the cell edges
+    for (unsigned cellY = 0; cellY < 4; cellY++)
+    {
+        for (unsigned cellX = 0; cellX < 4; cellX++)
+        {
+            const auto edge = glm::uvec2{cellX, cellY} * sCellSize;
+            for (const auto offset : {0u, 1u})
+            {
+                index.Add(MakeItem(edge + glm::uvec2{offset, 0}));
+                index.Add(MakeItem(edge + glm::uvec2{0, offset}));
+                if (edge.x > 0) index.Add(MakeItem(edge - glm::uvec2{offset + 1, 0}));
+                if (edge.y > 0) index.Add(MakeItem(edge - glm::uvec2{0, offset + 1}));
+            }
+        }
+    }
+    const auto& items = index.GetItems();
+
+    const auto ranges = std::vector<float>{
+        1.0f,
+        sCellSize / 2.0f,
+        static_cast<float>(sCellSize),
+        1.5f * sCellSize};
+    for (const auto range : ranges)
+    {
+        const auto maxDistSq = range * range;
+        for (int y = -1; y < 5; y++)
+        {
+            for (int x = -1; x < 5; x++)
+            {
+                const auto edge = glm::ivec2{x, y} * static_cast<int>(sCellSize);
+                for (const auto offset : {glm::ivec2{0}, glm::ivec2{-1}, glm::ivec2{1, -1}})
+                {
+                    const auto position = edge + offset;
+                    EXPECT_EQ(
+                        ToIndices(items, index.GetNearby(position, maxDistSq)),
+                        BruteForce(items, position, maxDistSq))
+                        << "position: " << position.x << ", " << position.y
+                        << " range: " << range;
+                }
+            }
+        }
+    }
+}
+
+TEST(CollisionIndexTest, MatchesBruteForceForRandomItems)
+{
+    auto rng = std::mt19937{42};
+    auto coordinate = std::uniform_int_distribution<unsigned>{0, 8 * sCellSize};
+
+    auto systems = Systems{};
+    for (unsigned i = 0; i < 500; i++)
+    {
+        const auto item = MakeItem(glm::uvec2{coordinate(rng), coordinate(rng)});
+        systems.AddBlockable(item);
+        if (i % 3 == 0)
+        {
+            systems.AddAllowable(item);
+        }
+    }
+
+    for (unsigned i = 0; i < 200; i++)
+    {
+        const auto position = glm::ivec2{coordinate(rng), coordinate(rng)};
+        EXPECT_EQ(
+            ToIndices(systems.GetBlockables(), systems.GetNearbyBlockables(position, sMaxCollisionDistSq)),
+            BruteForce(systems.GetBlockables(), position, sMaxCollisionDistSq));
+        EXPECT_EQ(
+            ToIndices(systems.GetAllowables(), systems.GetNearbyAllowables(position, sMaxCollisionDistSq)),
+            BruteForce(systems.GetAllowables(), position, sMaxCollisionDistSq));
+    }
+}
+
+TEST(CollisionIndexTest, DuplicateLocationsKeepInsertionOrder)
+{
+    auto index = CollisionIndex{};
+    const auto location = glm::uvec2{sCellSize, sCellSize};
+    index.Add(MakeItem(location));
+    index.Add(MakeItem(location + glm::uvec2{10, 0}));
+    index.Add(MakeItem(location));
+
+    EXPECT_EQ(
+        ToIndices(index.GetItems(), index.GetNearby(glm::ivec2{location}, 100 * 100)),
+        (std::vector<unsigned>{0, 2, 1}));
+}
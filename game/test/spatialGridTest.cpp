@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+#include "game/spatialGrid.hpp"
+
+#include "graphics/frustum.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace Game {
+
+namespace {
+
+// Looks down -z from the origin, 20 units wide and 100 deep
+Graphics::Frustum MakeFrustum()
+{
+    return Graphics::Frustum{
+        glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, 1.0f, 100.0f)
+        * glm::lookAt(
+            glm::vec3{0, 0, 0},
+            glm::vec3{0, 0, -1},
+            glm::vec3{0, 1, 0})};
+}
+
+std::vector<unsigned> Query(
+    const SpatialGrid& grid,
+    glm::vec3 position,
+    float maxDistance)
+{
+    auto result = std::vector<unsigned>{};
+    grid.Query(MakeFrustum(), position, maxDistance, result);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}
+
+TEST(SpatialGridTest, ReturnsItemsInsideTheFrustumAndDistance)
+{
+    auto grid = SpatialGrid{10.0f};
+    grid.Insert(0, glm::vec3{0, 0, -5}, 1.0f);
+    grid.Insert(1, glm::vec3{50, 0, -5}, 1.0f);
+    grid.Insert(2, glm::vec3{0, 0, 20}, 1.0f);
+    grid.Insert(3, glm::vec3{0, 0, -60}, 1.0f);
+    // Outside the frustum, but large enough to reach into it
+    grid.Insert(4, glm::vec3{15, 0, -5}, 10.0f);
+    grid.Insert(5, glm::vec3{-3, 2, -35}, 1.0f);
+
+    EXPECT_EQ(grid.size(), 6u);
+    EXPECT_EQ(Query(grid, glm::vec3{0}, 40.0f), (std::vector<unsigned>{0, 4, 5}));
+    EXPECT_EQ(Query(grid, glm::vec3{0}, 1000.0f), (std::vector<unsigned>{0, 3, 4, 5}));
+}
+
+TEST(SpatialGridTest, ClearRemovesEverything)
+{
+    auto grid = SpatialGrid{10.0f};
+    grid.Insert(0, glm::vec3{0, 0, -5}, 1.0f);
+    grid.Clear();
+
+    EXPECT_EQ(grid.size(), 0u);
+    EXPECT_TRUE(Query(grid, glm::vec3{0}, 1000.0f).empty());
+}
+
+}
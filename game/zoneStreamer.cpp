@@ -0,0 +1,112 @@
+#include "game/zoneStreamer.hpp"
+
+#include "bak/zone.hpp"
+
+#include "com/stopwatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Game {
+
+namespace {
+
+bool IsFinished(const std::future<std::unique_ptr<BAK::Zone>>& future)
+{
+    return future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+}
+
+}
+
+ZoneStreamer::ZoneStreamer()
+:
+    mZones{},
+    mLogger{Logging::LogState::GetLogger("Game::ZoneStreamer")}
+{}
+
+ZoneStreamer::~ZoneStreamer()
+{
+    // Futures from std::async block on destruction anyway, this just
+    // makes the wait explicit
+    for (auto& entry : mZones)
+    {
+        entry.mData.wait();
+    }
+}
+
+bool ZoneStreamer::Prefetch(
+    BAK::ZoneNumber zone,
+    const std::vector<BAK::ZoneNumber>& keep)
+{
+    if (Find(zone) != mZones.end())
+    {
+        return true;
+    }
+
+    if (mZones.size() >= sMaxZones)
+    {
+        // Only drop zones that have finished loading, dropping one that is
+        // still loading would block until it was done
+        const auto it = std::find_if(mZones.begin(), mZones.end(),
+            [&](const auto& entry){
+                return IsFinished(entry.mData)
+                    && std::find(keep.begin(), keep.end(), entry.mZone) == keep.end();
+            });
+        if (it == mZones.end())
+        {
+            mLogger.Debug() << "No room to prefetch zone: " << zone << "\n";
+            return false;
+        }
+        mLogger.Debug() << "Dropping prefetched zone: " << it->mZone << "\n";
+        mZones.erase(it);
+    }
+
+    mLogger.Debug() << "Prefetching zone: " << zone << "\n";
+    mZones.emplace_back(
+        zone,
+        std::async(std::launch::async, [zone]{
+            return std::make_unique<BAK::Zone>(zone.mValue);
+        }));
+    return true;
+}
+
+bool ZoneStreamer::IsLoading(BAK::ZoneNumber zone) const
+{
+    return Find(zone) != mZones.end();
+}
+
+bool ZoneStreamer::IsReady(BAK::ZoneNumber zone) const
+{
+    const auto it = Find(zone);
+    return it != mZones.end() && IsFinished(it->mData);
+}
+
+std::unique_ptr<BAK::Zone> ZoneStreamer::Take(BAK::ZoneNumber zone)
+{
+    auto it = Find(zone);
+    if (it == mZones.end())
+    {
+        return std::make_unique<BAK::Zone>(zone.mValue);
+    }
+
+    auto stopwatch = Stopwatch{};
+    auto future = std::move(it->mData);
+    mZones.erase(it);
+    auto data = future.get();
+    mLogger.Debug() << "Took zone: " << zone << " waited: " << stopwatch.Lap() << "ms\n";
+    return data;
+}
+
+std::vector<ZoneStreamer::Entry>::iterator ZoneStreamer::Find(BAK::ZoneNumber zone)
+{
+    return std::find_if(mZones.begin(), mZones.end(),
+        [&](const auto& entry){ return entry.mZone == zone; });
+}
+
+std::vector<ZoneStreamer::Entry>::const_iterator ZoneStreamer::Find(BAK::ZoneNumber zone) const
+{
+    return std::find_if(mZones.begin(), mZones.end(),
+        [&](const auto& entry){ return entry.mZone == zone; });
+}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "bak/types.hpp"
+
+#include "com/logger.hpp"
+
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace BAK {
+class Zone;
+}
+
+namespace Game {
+
+// Builds BAK::Zones on background threads so that a zone can be prepared
+// while the current one is still being played.
+class ZoneStreamer
+{
+public:
+    // Each zone holds all its textures and meshes, so keep only a few
+    static constexpr auto sMaxZones = 3;
+
+    ZoneStreamer();
+    ~ZoneStreamer();
+
+    ZoneStreamer(const ZoneStreamer&) = delete;
+    ZoneStreamer& operator=(const ZoneStreamer&) = delete;
+
+    // Starts loading the zone if it isn't already loaded or loading.
+    // Finished zones not in the keep list are dropped to make room.
+    // Returns false if there was no room.
+    bool Prefetch(
+        BAK::ZoneNumber zone,
+        const std::vector<BAK::ZoneNumber>& keep = {});
+
+    bool IsLoading(BAK::ZoneNumber zone) const;
+    bool IsReady(BAK::ZoneNumber zone) const;
+
+    // Hands over the zone, waiting for it if it is still loading, or
+    // loading it on this thread if it was never requested.
+    std::unique_ptr<BAK::Zone> Take(BAK::ZoneNumber zone);
+
+private:
+    struct Entry
+    {
+        BAK::ZoneNumber mZone;
+        std::future<std::unique_ptr<BAK::Zone>> mData;
+    };
+
+    std::vector<Entry>::iterator Find(BAK::ZoneNumber zone);
+    std::vector<Entry>::const_iterator Find(BAK::ZoneNumber zone) const;
+
+    std::vector<Entry> mZones;
+    const Logging::Logger& mLogger;
+};
+
+}
@@ -0,0 +1,112 @@
+#include "graphics/drawBatch.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace Graphics {
+
+DrawBatchBuilder::DrawBatchBuilder()
+:
+    mPending{},
+    mAdded{},
+    mInstances{},
+    mBatches{},
+    mListBatches{},
+    mListCount{0}
+{}
+
+void DrawBatchBuilder::Clear()
+{
+    mPending.clear();
+    mAdded.clear();
+    mInstances.clear();
+    mBatches.clear();
+    mListBatches.clear();
+    mListCount = 0;
+}
+
+DrawBatchBuilder::List DrawBatchBuilder::BeginList()
+{
+    return mListCount++;
+}
+
+void DrawBatchBuilder::AddInstance(
+    Object object,
+    const glm::mat4& modelMatrix,
+    const std::optional<glm::vec4>& color,
+    std::uint32_t entityId)
+{
+    if (mListCount == 0)
+    {
+        BeginList();
+    }
+
+    mPending.emplace_back(
+        PendingInstance{
+            mListCount - 1,
+            object,
+            static_cast<unsigned>(mAdded.size())});
+    mAdded.emplace_back(
+        InstanceData{
+            modelMatrix,
+            color.value_or(glm::vec4{0}),
+            color.has_value() ? 1.0f : 0.0f,
+            entityId});
+}
+
+void DrawBatchBuilder::Build()
+{
+    std::stable_sort(mPending.begin(), mPending.end(),
+        [](const auto& lhs, const auto& rhs){
+            return std::tie(lhs.mList, lhs.mObject) < std::tie(rhs.mList, rhs.mObject);
+        });
+
+    mInstances.clear();
+    mBatches.clear();
+    mListBatches.assign(mListCount, std::make_pair(0u, 0u));
+    for (const auto& pending : mPending)
+    {
+        const auto first = static_cast<unsigned>(mInstances.size());
+        mInstances.emplace_back(mAdded[pending.mIndex]);
+
+        auto& listBatches = mListBatches[pending.mList];
+        if (listBatches.second > 0
+            && mBatches.back().mOffset == pending.mObject.first
+            && mBatches.back().mLength == pending.mObject.second)
+        {
+            mBatches.back().mInstanceCount++;
+        }
+        else
+        {
+            if (listBatches.second == 0)
+            {
+                listBatches.first = static_cast<unsigned>(mBatches.size());
+            }
+            listBatches.second++;
+            mBatches.emplace_back(
+                DrawBatch{pending.mObject.first, pending.mObject.second, first, 1});
+        }
+    }
+}
+
+const std::vector<DrawBatch>& DrawBatchBuilder::GetBatches() const
+{
+    return mBatches;
+}
+
+std::span<const DrawBatch> DrawBatchBuilder::GetBatches(List list) const
+{
+    if (list >= mListBatches.size())
+    {
+        return {};
+    }
+    const auto [first, count] = mListBatches[list];
+    return std::span{mBatches}.subspan(first, count);
+}
+
+const std::vector<InstanceData>& DrawBatchBuilder::GetInstances() const
+{
+    return mInstances;
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Graphics {
+
+// Per instance vertex attributes, in the layout the world and pick
+// shaders read them
+struct InstanceData
+{
+    glm::mat4 mModelMatrix;
+    glm::vec4 mColor;
+    float mUseColor;
+    std::uint32_t mEntityId;
+};
+
+struct DrawBatch
+{
+    // Index offset and length of the mesh object in the render data
+    unsigned mOffset;
+    unsigned mLength;
+    unsigned mFirstInstance;
+    unsigned mInstanceCount;
+};
+
+// Groups renderables that share a mesh object so that each group can be
+// drawn with a single instanced draw call. Storage is kept between frames
+// so that rebuilding the batches does not allocate once warmed up.
+//
+// Instances are added to lists, e.g. one for each draw in a render pass.
+// Lists are batched separately but their instances are kept together so
+// that a pass can upload them all at once.
+class DrawBatchBuilder
+{
+public:
+    using Object = std::pair<unsigned, unsigned>;
+    using List = unsigned;
+
+    DrawBatchBuilder();
+
+    void Clear();
+    // Instances added after this belong to the new list. Instances added
+    // before any list is begun go into list 0.
+    List BeginList();
+    void AddInstance(
+        Object object,
+        const glm::mat4& modelMatrix,
+        const std::optional<glm::vec4>& color,
+        std::uint32_t entityId = 0);
+
+    // Sorts the added instances into batches ordered by list then object.
+    // Instances of the same object keep the order in which they were added.
+    void Build();
+
+    // The batches of every list
+    const std::vector<DrawBatch>& GetBatches() const;
+    std::span<const DrawBatch> GetBatches(List list) const;
+    const std::vector<InstanceData>& GetInstances() const;
+
+private:
+    struct PendingInstance
+    {
+        List mList;
+        Object mObject;
+        unsigned mIndex;
+    };
+
+    std::vector<PendingInstance> mPending;
+    std::vector<InstanceData> mAdded;
+    std::vector<InstanceData> mInstances;
+    std::vector<DrawBatch> mBatches;
+    // First batch and number of batches of each list
+    std::vector<std::pair<unsigned, unsigned>> mListBatches;
+    unsigned mListCount;
+};
+
+}
@@ -0,0 +1,61 @@
+#include "graphics/frustum.hpp"
+
+namespace Graphics {
+
+Frustum::Frustum(const glm::mat4& viewProjection)
+:
+    mPlanes{}
+{
+    // Gribb and Hartmann: each clip plane is the sum or difference of
+    // the last row of the matrix with one of the other rows
+    const auto Row = [&](int i){
+        return glm::vec4{
+            viewProjection[0][i],
+            viewProjection[1][i],
+            viewProjection[2][i],
+            viewProjection[3][i]};
+    };
+
+    const auto w = Row(3);
+    for (int i = 0; i < 3; i++)
+    {
+        mPlanes[i * 2] = w + Row(i);
+        mPlanes[i * 2 + 1] = w - Row(i);
+    }
+
+    for (auto& plane : mPlanes)
+    {
+        plane /= glm::length(glm::vec3{plane});
+    }
+}
+
+bool Frustum::Intersects(const glm::vec3& centre, float radius) const
+{
+    for (const auto& plane : mPlanes)
+    {
+        if (glm::dot(glm::vec3{plane}, centre) + plane.w < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::Intersects(const glm::vec3& boxMin, const glm::vec3& boxMax) const
+{
+    for (const auto& plane : mPlanes)
+    {
+        // The corner furthest along the plane normal
+        const auto corner = glm::vec3{
+            plane.x < 0 ? boxMin.x : boxMax.x,
+            plane.y < 0 ? boxMin.y : boxMax.y,
+            plane.z < 0 ? boxMin.z : boxMax.z};
+        if (glm::dot(glm::vec3{plane}, corner) + plane.w < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
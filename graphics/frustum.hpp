@@ -0,0 +1,23 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace Graphics {
+
+// The view volume of a view projection matrix, as six inward facing planes.
+// Works for both perspective and orthographic projections.
+class Frustum
+{
+public:
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    bool Intersects(const glm::vec3& centre, float radius) const;
+    bool Intersects(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+private:
+    std::array<glm::vec4, 6> mPlanes;
+};
+
+}
@@ -2,8 +2,212 @@
 
 #include "graphics/sphere.hpp"
 
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
 namespace Graphics {
 
+Vertex PackVertex(
+    glm::vec3 position,
+    glm::vec3 normal,
+    glm::vec4 color,
+    glm::vec3 textureCoord,
+    float textureBlend)
+{
+    // Texel coordinates can go past the layer for textures that repeat
+    constexpr auto maxCoord = static_cast<float>(std::numeric_limits<std::uint16_t>::max());
+    return Vertex{
+        position,
+        glm::packSnorm3x10_1x2(glm::vec4{normal, 0.0f}),
+        glm::u8vec4{glm::round(glm::clamp(color, 0.0f, 1.0f) * 255.0f)},
+        glm::u16vec3{glm::round(glm::clamp(textureCoord, 0.0f, maxCoord))},
+        static_cast<std::uint16_t>(
+            std::round(std::clamp(textureBlend, 0.0f, 1.0f) * maxCoord))};
+}
+
+std::size_t VertexHash::operator()(const Vertex& vertex) const noexcept
+{
+    // -0.0f and 0.0f compare equal but differ in their sign bit, so they
+    // must hash the same for welding to find the existing vertex
+    auto canonical = vertex;
+    for (unsigned i = 0; i < 3; i++)
+    {
+        if (canonical.mPosition[i] == 0.0f)
+        {
+            canonical.mPosition[i] = 0.0f;
+        }
+    }
+    return std::hash<std::string_view>{}(
+        std::string_view{reinterpret_cast<const char*>(&canonical), sizeof(Vertex)});
+}
+
+MeshObject::MeshObject(
+    const std::vector<glm::vec3>& vertices,
+    const std::vector<glm::vec3>& normals,
+    const std::vector<glm::vec4>& colors,
+    const std::vector<glm::vec3>& textureCoords,
+    const std::vector<float>& textureBlends,
+    const std::vector<unsigned>& indices)
+:
+    mVertices{},
+    mIndices{}
+{
+    auto builder = MeshBuilder{};
+    for (const auto i : indices)
+    {
+        builder.AddVertex(PackVertex(
+            vertices[i],
+            normals[i],
+            colors[i],
+            textureCoords[i],
+            textureBlends[i]));
+    }
+    *this = std::move(builder).Build();
+}
+
+MeshObject::MeshObject(
+    std::vector<Vertex> vertices,
+    std::vector<unsigned> indices)
+:
+    mVertices{std::move(vertices)},
+    mIndices{std::move(indices)}
+{
+}
+
+MeshBuilder::MeshBuilder()
+:
+    mVertices{},
+    mIndices{},
+    mVertexIndices{}
+{
+}
+
+unsigned MeshBuilder::AddVertex(const Vertex& vertex)
+{
+    const auto [it, inserted] = mVertexIndices.try_emplace(
+        vertex,
+        static_cast<unsigned>(mVertices.size()));
+    if (inserted)
+    {
+        mVertices.emplace_back(vertex);
+    }
+    mIndices.emplace_back(it->second);
+    return it->second;
+}
+
+void MeshBuilder::AddTriangle(const Vertex& a, const Vertex& b, const Vertex& c)
+{
+    AddVertex(a);
+    AddVertex(b);
+    AddVertex(c);
+}
+
+void MeshBuilder::AddMesh(const MeshObject& mesh)
+{
+    for (const auto i : mesh.mIndices)
+    {
+        AddVertex(mesh.mVertices[i]);
+    }
+}
+
+MeshObject MeshBuilder::Build() &&
+{
+    return MeshObject{std::move(mVertices), std::move(mIndices)};
+}
+
+MeshObjectStorage::MeshObjectStorage()
+:
+    mObjects{},
+    mVertices{},
+    mIndices{}
+{
+}
+
+MeshObjectStorage::MeshObjectStorage(
+    Objects objects,
+    std::vector<Vertex> vertices,
+    std::vector<unsigned> indices)
+:
+    mObjects{std::move(objects)},
+    mVertices{std::move(vertices)},
+    mIndices{std::move(indices)}
+{
+}
+
+MeshObjectStorage::OffsetAndLength MeshObjectStorage::GetObject(const std::string& id) const
+{
+    const auto it = mObjects.find(id);
+    if (it == mObjects.end())
+    {
+        std::stringstream ss{};
+        ss << "Couldn't find: " << id;
+        throw std::runtime_error(ss.str());
+    }
+    return it->second;
+}
+
+MeshObjectStorageBuilder::MeshObjectStorageBuilder()
+:
+    MeshObjectStorageBuilder{MeshObjectStorage{}}
+{
+}
+
+MeshObjectStorageBuilder::MeshObjectStorageBuilder(MeshObjectStorage&& storage)
+:
+    mStorage{std::move(storage)},
+    mPending{},
+    mVertexCount{mStorage.mVertices.size()},
+    mIndexCount{mStorage.mIndices.size()}
+{
+}
+
+MeshObjectStorageBuilder::OffsetAndLength MeshObjectStorageBuilder::AddObject(
+    std::string id,
+    MeshObject&& obj)
+{
+    const auto offsetAndLength = std::make_pair(
+        static_cast<unsigned>(mIndexCount),
+        static_cast<unsigned>(obj.mIndices.size()));
+    const auto [it, inserted] = mStorage.mObjects.try_emplace(std::move(id), offsetAndLength);
+    if (!inserted)
+    {
+        Logging::LogDebug("MeshObjectStore") << it->first << " already loaded\n";
+        return it->second;
+    }
+
+    mVertexCount += obj.mVertices.size();
+    mIndexCount += obj.mIndices.size();
+    mPending.emplace_back(std::move(obj));
+    return offsetAndLength;
+}
+
+MeshObjectStorage MeshObjectStorageBuilder::Build() &&
+{
+    auto& vertices = mStorage.mVertices;
+    auto& indices = mStorage.mIndices;
+    vertices.reserve(mVertexCount);
+    indices.reserve(mIndexCount);
+
+    for (const auto& obj : mPending)
+    {
+        const auto baseVertex = static_cast<unsigned>(vertices.size());
+        vertices.insert(vertices.end(), obj.mVertices.begin(), obj.mVertices.end());
+        for (const auto index : obj.mIndices)
+        {
+            indices.emplace_back(baseVertex + index);
+        }
+    }
+
+    mPending.clear();
+    return std::move(mStorage);
+}
+
 MeshObject SphereToMeshObject(const Sphere& sphere, glm::vec4 color)
 {
     std::vector<glm::vec3> vertices{};
@@ -6,34 +6,65 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_precision.hpp>
 #include "graphics/glm.hpp"
 
-#include <algorithm>
-#include <vector>
+#include <cstdint>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 
 namespace Graphics {
 
+// A vertex as it is uploaded, with its attributes interleaved and packed
+struct Vertex
+{
+    glm::vec3 mPosition;
+    // Signed normalized 10:10:10:2
+    std::uint32_t mNormal;
+    glm::u8vec4 mColor;
+    // Texel within the texture array layer, and the layer
+    glm::u16vec3 mTextureCoord;
+    // Ratio of texture to material color - solution to having textured
+    // and non-textured objects, unsigned normalized
+    std::uint16_t mTextureBlend;
+
+    bool operator==(const Vertex&) const = default;
+};
+
+static_assert(sizeof(Vertex) == 28, "Vertex must not contain padding");
+
+Vertex PackVertex(
+    glm::vec3 position,
+    glm::vec3 normal,
+    glm::vec4 color,
+    glm::vec3 textureCoord,
+    float textureBlend);
+
+struct VertexHash
+{
+    std::size_t operator()(const Vertex& vertex) const noexcept;
+};
+
+// An indexed mesh in which each distinct vertex appears once
 class MeshObject
 {
 public:
+    // One entry in each attribute per index, as they are generated. Vertices
+    // with identical attributes are welded together.
     MeshObject(
-        std::vector<glm::vec3> vertices,
-        std::vector<glm::vec3> normals,
-        std::vector<glm::vec4> colors,
-        std::vector<glm::vec3> textureCoords,
-        std::vector<float> textureBlends,
-        std::vector<unsigned> indices)
-    :
-        mVertices{vertices},
-        mNormals{normals},
-        mColors{colors},
-        mTextureCoords{textureCoords},
-        mTextureBlends{textureBlends},
-        mIndices{indices}
-    {
-    }
+        const std::vector<glm::vec3>& vertices,
+        const std::vector<glm::vec3>& normals,
+        const std::vector<glm::vec4>& colors,
+        const std::vector<glm::vec3>& textureCoords,
+        const std::vector<float>& textureBlends,
+        const std::vector<unsigned>& indices);
+
+    MeshObject(
+        std::vector<Vertex> vertices,
+        std::vector<unsigned> indices);
 
     unsigned long GetNumVertices() const
     {
@@ -41,96 +72,96 @@ public:
     }
 
 //private:
-    std::vector<glm::vec3> mVertices;
-    std::vector<glm::vec3> mNormals;
-    std::vector<glm::vec4> mColors;
-    std::vector<glm::vec3> mTextureCoords;
-    // Ratio of texture to material color 
-    // - solution to having textured and
-    // non-textured objects (should I use diff shaders?)
-    std::vector<float> mTextureBlends;
+    std::vector<Vertex> mVertices;
     std::vector<unsigned> mIndices;
-
 };
 
 MeshObject SphereToMeshObject(const Sphere& sphere, glm::vec4 color);
 
+// Builds a MeshObject a vertex at a time, welding identical vertices
+class MeshBuilder
+{
+public:
+    MeshBuilder();
+
+    // Index of the vertex, which is only stored the first time it is seen
+    unsigned AddVertex(const Vertex& vertex);
+    void AddTriangle(const Vertex& a, const Vertex& b, const Vertex& c);
+    // Appends another mesh's triangles
+    void AddMesh(const MeshObject& mesh);
+
+    std::size_t GetNumIndices() const { return mIndices.size(); }
+
+    MeshObject Build() &&;
+
+private:
+    std::vector<Vertex> mVertices;
+    std::vector<unsigned> mIndices;
+    std::unordered_map<Vertex, unsigned, VertexHash> mVertexIndices;
+};
+
+// Meshes laid out one after the other in a single vertex and index
+// buffer. Made by a MeshObjectStorageBuilder and read only after.
 class MeshObjectStorage
 {
 public:
+    // The first index of an object and its number of indices. Indices
+    // refer to the whole storage so objects are drawn without a base vertex.
     using OffsetAndLength = std::pair<unsigned, unsigned>;
+    using Objects = std::unordered_map<std::string, OffsetAndLength>;
 
-    MeshObjectStorage()
-    :
-        mOffset{0},
-        mVertices{},
-        mNormals{},
-        mColors{},
-        mTextureCoords{},
-        mTextureBlends{},
-        mIndices{}
-    {
-    }
+    MeshObjectStorage();
+    MeshObjectStorage(
+        Objects objects,
+        std::vector<Vertex> vertices,
+        std::vector<unsigned> indices);
 
-    OffsetAndLength AddObject(
-        const std::string& id,
-        const MeshObject& obj)
-    {
-        if (mObjects.find(id) != mObjects.end())
-        {
-            mLog.Debug() << id << " already loaded" << std::endl;
-            return GetObject(id);
-        }
+    OffsetAndLength GetObject(const std::string& id) const;
 
-        auto length = obj.GetNumVertices();
-        const auto offsetAndLength = std::make_pair(mOffset, length);
+    const Objects& GetObjects() const { return mObjects; }
+    const std::vector<Vertex>& GetVertices() const { return mVertices; }
+    const std::vector<unsigned>& GetIndices() const { return mIndices; }
 
-        mObjects.emplace(id, offsetAndLength);
+    std::size_t size() const
+    {
+        return mObjects.size();
+    }
 
-        std::copy(obj.mVertices.begin(), obj.mVertices.end(), std::back_inserter(mVertices));
-        std::copy(obj.mNormals.begin(), obj.mNormals.end(), std::back_inserter(mNormals));
-        std::copy(obj.mColors.begin(), obj.mColors.end(), std::back_inserter(mColors));
-        std::copy(obj.mTextureCoords.begin(), obj.mTextureCoords.end(), std::back_inserter(mTextureCoords));
-        std::copy(obj.mTextureBlends.begin(), obj.mTextureBlends.end(), std::back_inserter(mTextureBlends));
-        std::copy(obj.mIndices.begin(), obj.mIndices.end(), std::back_inserter(mIndices));
+private:
+    friend class MeshObjectStorageBuilder;
 
-        mLog.Debug() << __FUNCTION__ << " " << id << " off: " << mOffset 
-            << " len: " << length << std::endl;
+    Objects mObjects;
+    std::vector<Vertex> mVertices;
+    std::vector<unsigned> mIndices;
+};
 
-        mOffset += obj.GetNumVertices();
+// Builds a MeshObjectStorage in two passes. Adding a mesh only takes it
+// and works out where it will go, Build then sizes the storage once and
+// copies each mesh into its place.
+class MeshObjectStorageBuilder
+{
+public:
+    using OffsetAndLength = MeshObjectStorage::OffsetAndLength;
 
-        return offsetAndLength;
-    }
+    MeshObjectStorageBuilder();
+    // Meshes are added after those already in the storage
+    explicit MeshObjectStorageBuilder(MeshObjectStorage&& storage);
 
-    OffsetAndLength GetObject(const std::string& id)
-    {   
-        if (mObjects.find(id) == mObjects.end())
-        {
-            std::stringstream ss{};
-            ss << "Couldn't find: " << id;
-            throw std::runtime_error(ss.str());
-        }
-        return mObjects.find(id)->second;
-    }
+    // A mesh whose id was already added is dropped and the existing one returned
+    OffsetAndLength AddObject(std::string id, MeshObject&& obj);
 
     std::size_t size() const
     {
-        return mObjects.size();
+        return mStorage.size();
     }
 
-//private:
-    unsigned long mOffset;
-    std::unordered_map<std::string, OffsetAndLength> mObjects;
-
-    std::vector<glm::vec3> mVertices;
-    std::vector<glm::vec3> mNormals;
-    std::vector<glm::vec4> mColors;
-    std::vector<glm::vec3> mTextureCoords;
-    std::vector<float> mTextureBlends;
-    std::vector<unsigned> mIndices;
+    MeshObjectStorage Build() &&;
 
-    const Logging::Logger& mLog{
-        Logging::LogState::GetLogger("MeshObjectStore")};
+private:
+    MeshObjectStorage mStorage;
+    std::vector<MeshObject> mPending;
+    std::size_t mVertexCount;
+    std::size_t mIndexCount;
 };
 
 }
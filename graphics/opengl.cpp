@@ -7,6 +7,7 @@
 
 #include <GL/glew.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace Graphics {
@@ -135,7 +136,29 @@ void GLBuffers::AddBuffer(
             bindPoint,
             dataType,
             updateType,
-            GenBufferGL()});
+            GenBufferGL(),
+            {},
+            0});
+
+    BindAttribArrayGL(GetGLBuffer(name));
+}
+
+void GLBuffers::AddInterleavedArrayBuffer(
+    const std::string& name,
+    std::size_t stride,
+    std::vector<GLVertexAttrib> attribs)
+{
+    mBuffers.emplace(
+        name,
+        GLBuffer{
+            GLNullLocation,
+            GLElems{0},
+            GLBindPoint::ArrayBuffer,
+            GLDataType{0},
+            GLUpdateType::StaticDraw,
+            GenBufferGL(),
+            std::move(attribs),
+            stride});
 
     BindAttribArrayGL(GetGLBuffer(name));
 }
@@ -153,6 +176,38 @@ void GLBuffers::AddTextureBuffer(
 }
 
 
+void GLBuffers::AllocateBufferDataGL(
+    const std::string& name,
+    std::size_t bytes)
+{
+    const auto& buffer = GetGLBuffer(name);
+    glBindBuffer(
+        ToGlEnum(buffer.mGLBindPoint),
+        buffer.mBuffer.mValue);
+    glBufferData(
+        ToGlEnum(buffer.mGLBindPoint),
+        bytes,
+        nullptr,
+        ToGlEnum(buffer.mUpdateType));
+}
+
+void GLBuffers::LoadBufferSubDataGL(
+    const std::string& name,
+    std::size_t offset,
+    const void* data,
+    std::size_t bytes)
+{
+    const auto& buffer = GetGLBuffer(name);
+    glBindBuffer(
+        ToGlEnum(buffer.mGLBindPoint),
+        buffer.mBuffer.mValue);
+    glBufferSubData(
+        ToGlEnum(buffer.mGLBindPoint),
+        offset,
+        bytes,
+        data);
+}
+
 GLBufferId GLBuffers::GenBufferGL()
 {
     GLuint buffer;
@@ -162,7 +217,22 @@ GLBufferId GLBuffers::GenBufferGL()
 
 void GLBuffers::BindAttribArrayGL(const GLBuffer& buffer)
 {
-    if (buffer.mLocation != GLNullLocation)
+    if (!buffer.mAttribs.empty())
+    {
+        glBindBuffer(ToGlEnum(buffer.mGLBindPoint), buffer.mBuffer.mValue);
+        for (const auto& attrib : buffer.mAttribs)
+        {
+            glEnableVertexAttribArray(attrib.mLocation.mValue);
+            glVertexAttribPointer(
+                attrib.mLocation.mValue,
+                attrib.mElems.mValue,
+                attrib.mDataType.mValue,
+                attrib.mNormalized ? GL_TRUE : GL_FALSE,
+                buffer.mStride,
+                (void*) attrib.mOffset);
+        }
+    }
+    else if (buffer.mLocation != GLNullLocation)
     {
         glEnableVertexAttribArray(buffer.mLocation.mValue);
         glBindBuffer(ToGlEnum(buffer.mGLBindPoint), buffer.mBuffer.mValue);
@@ -285,45 +355,75 @@ void TextureBuffer::LoadTexturesGL(
     const std::vector<Texture>& textures,
     unsigned maxDim)
 {
-    if (textures.size() > sMaxTextures)
+    AllocateTexturesGL(textures.size(), maxDim);
+
+    unsigned index = 0;
+    for (const auto& tex : textures)
+    {
+        LoadTextureGL(index, tex, maxDim);
+        index++;
+    }
+    
+    SetTextureParametersGL();
+}
+
+void TextureBuffer::AllocateTexturesGL(std::size_t textureCount, unsigned maxDim)
+{
+    if (textureCount > sMaxTextures)
         throw std::runtime_error("Too many textures");
 
     BindGL();
 
+    // Only allocate the layers that will be used
     glTexStorage3D(
         mTextureType,
         1,              // levels
         GL_RGBA8,       // Internal format
         maxDim, maxDim, // width,height
-        sMaxTextures     // Number of layers
+        std::max<GLsizei>(textureCount, 1) // Number of layers
     );
 
+    UnbindGL();
+}
 
-    unsigned index = 0;
-    for (const auto& tex : textures)
+void TextureBuffer::LoadTextureGL(unsigned index, const Texture& tex, unsigned maxDim)
+{
+    const auto* pixels = tex.GetTexture().data();
+    std::vector<Pixel> paddedTex{};
+    if (tex.GetWidth() != maxDim || tex.GetHeight() != maxDim)
     {
-        std::vector<glm::vec4> paddedTex(
-            maxDim * maxDim,
-            glm::vec4{0});
-
-        // Chuck the image in the padded sized texture
-        // GetPixel() will wrap and fill the texture
-        for (unsigned x = 0; x < maxDim; x++)
-            for (unsigned y = 0; y < maxDim; y++)
-                paddedTex[x + y * maxDim] = tex.GetPixel(x, y);
-
-        glTexSubImage3D(
-            mTextureType,
-            0,                 // Mipmap number
-            0, 0, index,       // xoffset, yoffset, zoffset
-            maxDim, maxDim, 1, // width, height, depth
-            GL_RGBA,           // format
-            GL_FLOAT,          // type
-            paddedTex.data()); // pointer to data
-
-        index++;
+        // Chuck the image in the padded sized texture,
+        // repeating textures are tiled to fill it
+        paddedTex.resize(maxDim * maxDim, Pixel{0});
+        if (tex.GetRepeat())
+        {
+            tex.Tile(paddedTex, maxDim, glm::uvec2{0}, glm::uvec2{maxDim});
+        }
+        else
+        {
+            tex.Blit(paddedTex, maxDim, glm::uvec2{0});
+        }
+        pixels = paddedTex.data();
     }
-    
+
+    BindGL();
+
+    glTexSubImage3D(
+        mTextureType,
+        0,                 // Mipmap number
+        0, 0, index,       // xoffset, yoffset, zoffset
+        maxDim, maxDim, 1, // width, height, depth
+        GL_RGBA,           // format
+        GL_UNSIGNED_BYTE,  // type
+        pixels);           // pointer to data
+
+    UnbindGL();
+}
+
+void TextureBuffer::SetTextureParametersGL()
+{
+    BindGL();
+
     // Doesn't actually look very good with mipmaps...
     //glGenerateMipmap(mTextureType);
     constexpr auto interpolation = GL_NEAREST;
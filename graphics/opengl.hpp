@@ -33,6 +33,18 @@ enum class GLUpdateType
 
 GLenum ToGlEnum(GLUpdateType);
 
+// One attribute of a buffer holding interleaved vertices
+struct GLVertexAttrib
+{
+    GLLocation mLocation;
+    GLElems mElems;
+    GLDataType mDataType;
+    // Whether integers map to [0, 1], or [-1, 1] when signed
+    bool mNormalized;
+    // Bytes from the start of the vertex
+    std::size_t mOffset;
+};
+
 struct GLBuffer
 {
     // Location in the shader
@@ -47,6 +59,10 @@ struct GLBuffer
     GLUpdateType mUpdateType;
     // GL assigned buffer id
     GLBufferId mBuffer;
+    // Attributes of an interleaved buffer, which has no single location
+    std::vector<GLVertexAttrib> mAttribs;
+    // Bytes per vertex of an interleaved buffer
+    std::size_t mStride;
 };
 
 class VertexArrayObject
@@ -116,6 +132,12 @@ public:
         AddBuffer(name, location, GLElems{T::length()}, dataType, GLBindPoint::ArrayBuffer, GLUpdateType::StaticDraw);
     }
 
+    // A static array buffer of vertices with several attributes each
+    void AddInterleavedArrayBuffer(
+        const std::string& name,
+        std::size_t stride,
+        std::vector<GLVertexAttrib> attribs);
+
     void AddElementBuffer(const std::string& name);
     void AddTextureBuffer(const std::string& name);
     
@@ -144,6 +166,17 @@ public:
             ToGlEnum(buffer.mUpdateType));
     }
 
+    // Reserves storage to be filled by LoadBufferSubDataGL
+    void AllocateBufferDataGL(
+        const std::string& name,
+        std::size_t bytes);
+
+    void LoadBufferSubDataGL(
+        const std::string& name,
+        std::size_t offset,
+        const void* data,
+        std::size_t bytes);
+
     template <typename T>
     void ModifyBufferDataGL(
         const std::string& name,
@@ -205,6 +238,11 @@ public:
         const std::vector<Texture>& textures,
         unsigned maxDim);
 
+    // LoadTexturesGL in steps, so the upload can be spread over frames
+    void AllocateTexturesGL(std::size_t textureCount, unsigned maxDim);
+    void LoadTextureGL(unsigned index, const Texture& texture, unsigned maxDim);
+    void SetTextureParametersGL();
+
 private:
     GLuint mTextureBuffer;
     GLenum mTextureType;
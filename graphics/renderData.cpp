@@ -7,39 +7,69 @@
 
 #include "com/logger.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+
 namespace Graphics {
 
+namespace {
+
+struct BufferSource
+{
+    const char* mName;
+    std::span<const std::byte> mData;
+};
+
+std::array<BufferSource, 2> GetBufferSources(const MeshObjectStorage& objectStore)
+{
+    return {
+        BufferSource{"vertex", std::as_bytes(std::span{objectStore.GetVertices()})},
+        BufferSource{"elements", std::as_bytes(std::span{objectStore.GetIndices()})}};
+}
+
+}
+
 RenderData::RenderData()
 :
     mVertexArrayObject{},
     mGLBuffers{},
-    mTextureBuffer{GL_TEXTURE_2D_ARRAY}
+    mTextureBuffer{GL_TEXTURE_2D_ARRAY},
+    mPendingLoad{}
 {
 }
 
-void RenderData::LoadData(
-    const MeshObjectStorage& objectStore,
-    const std::vector<Texture>& textures,
-    unsigned maxDimension)
+void RenderData::AddBuffersGL()
 {
-    Logging::LogInfo(__FUNCTION__) << "Loading render data. Textures: " << textures.size() << " max dim: " << maxDimension << "\n";
     // FIXME Issue 48: Need to do destruct and restruct all the buffers
     // when we load new data...
     mVertexArrayObject.BindGL();
 
-    mGLBuffers.AddStaticArrayBuffer<glm::vec3>("vertex", GLLocation{0});
-    mGLBuffers.AddStaticArrayBuffer<glm::vec3>("normal", GLLocation{1});
-    mGLBuffers.AddStaticArrayBuffer<glm::vec4>("color", GLLocation{2});
-    mGLBuffers.AddStaticArrayBuffer<glm::vec3>("textureCoord", GLLocation{3});
-    mGLBuffers.AddStaticArrayBuffer<glm::vec1>("textureBlend", GLLocation{4});
+    mGLBuffers.AddInterleavedArrayBuffer(
+        "vertex",
+        sizeof(Vertex),
+        {
+            GLVertexAttrib{GLLocation{0}, GLElems{3}, GLDataType{GL_FLOAT}, false, offsetof(Vertex, mPosition)},
+            GLVertexAttrib{GLLocation{1}, GLElems{4}, GLDataType{GL_INT_2_10_10_10_REV}, true, offsetof(Vertex, mNormal)},
+            GLVertexAttrib{GLLocation{2}, GLElems{4}, GLDataType{GL_UNSIGNED_BYTE}, true, offsetof(Vertex, mColor)},
+            // Texels, normalized by the layer size in the shaders
+            GLVertexAttrib{GLLocation{3}, GLElems{3}, GLDataType{GL_UNSIGNED_SHORT}, false, offsetof(Vertex, mTextureCoord)},
+            GLVertexAttrib{GLLocation{4}, GLElems{1}, GLDataType{GL_UNSIGNED_SHORT}, true, offsetof(Vertex, mTextureBlend)}
+        });
     mGLBuffers.AddElementBuffer("elements");
+}
+
+void RenderData::LoadData(
+    const MeshObjectStorage& objectStore,
+    const std::vector<Texture>& textures,
+    unsigned maxDimension)
+{
+    Logging::LogInfo(__FUNCTION__) << "Loading render data. Textures: " << textures.size() << " max dim: " << maxDimension << "\n";
+    AddBuffersGL();
 
-    mGLBuffers.LoadBufferDataGL("vertex", objectStore.mVertices);
-    mGLBuffers.LoadBufferDataGL("normal", objectStore.mNormals);
-    mGLBuffers.LoadBufferDataGL("color", objectStore.mColors);
-    mGLBuffers.LoadBufferDataGL("textureCoord", objectStore.mTextureCoords);
-    mGLBuffers.LoadBufferDataGL("textureBlend", objectStore.mTextureBlends);
-    mGLBuffers.LoadBufferDataGL("elements", objectStore.mIndices);
+    mGLBuffers.LoadBufferDataGL("vertex", objectStore.GetVertices());
+    mGLBuffers.LoadBufferDataGL("elements", objectStore.GetIndices());
 
     mGLBuffers.BindArraysGL();
 
@@ -48,6 +78,94 @@ void RenderData::LoadData(
         maxDimension);
 }
 
+void RenderData::BeginLoadData(
+    const MeshObjectStorage& objectStore,
+    const std::vector<Texture>& textures,
+    unsigned maxDimension)
+{
+    Logging::LogInfo(__FUNCTION__) << "Loading render data incrementally. Textures: " << textures.size() << " max dim: " << maxDimension << "\n";
+    AddBuffersGL();
+
+    for (const auto& source : GetBufferSources(objectStore))
+    {
+        mGLBuffers.AllocateBufferDataGL(source.mName, source.mData.size());
+    }
+
+    mGLBuffers.BindArraysGL();
+    mVertexArrayObject.UnbindGL();
+
+    mTextureBuffer.AllocateTexturesGL(textures.size(), maxDimension);
+
+    mPendingLoad = PendingLoad{
+        &objectStore,
+        &textures,
+        maxDimension,
+        0,
+        0,
+        0};
+}
+
+bool RenderData::ContinueLoadData(std::size_t byteBudget)
+{
+    if (!mPendingLoad)
+    {
+        return true;
+    }
+
+    auto& load = *mPendingLoad;
+    // The element buffer binding belongs to the vertex array, so make sure
+    // it is ours that gets modified and not whichever was last drawn
+    mVertexArrayObject.BindGL();
+
+    std::size_t uploaded = 0;
+    const auto sources = GetBufferSources(*load.mObjectStore);
+    while (load.mBuffer < sources.size() && uploaded < byteBudget)
+    {
+        const auto& source = sources[load.mBuffer];
+        const auto bytes = std::min(
+            source.mData.size() - load.mBufferOffset,
+            byteBudget - uploaded);
+        if (bytes > 0)
+        {
+            mGLBuffers.LoadBufferSubDataGL(
+                source.mName,
+                load.mBufferOffset,
+                source.mData.data() + load.mBufferOffset,
+                bytes);
+        }
+
+        uploaded += bytes;
+        load.mBufferOffset += bytes;
+        if (load.mBufferOffset == source.mData.size())
+        {
+            load.mBuffer++;
+            load.mBufferOffset = 0;
+        }
+    }
+
+    mVertexArrayObject.UnbindGL();
+
+    const std::size_t textureBytes = load.mMaxDimension * load.mMaxDimension * sizeof(Pixel);
+    while (load.mTexture < load.mTextures->size() && uploaded < byteBudget)
+    {
+        mTextureBuffer.LoadTextureGL(
+            load.mTexture,
+            (*load.mTextures)[load.mTexture],
+            load.mMaxDimension);
+        uploaded += textureBytes;
+        load.mTexture++;
+    }
+
+    if (load.mBuffer < sources.size() || load.mTexture < load.mTextures->size())
+    {
+        return false;
+    }
+
+    mTextureBuffer.SetTextureParametersGL();
+    mPendingLoad.reset();
+    return true;
+}
+
 void RenderData::Bind(GLuint textureTarget) const
 {
     mVertexArrayObject.BindGL();
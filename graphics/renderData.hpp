@@ -2,6 +2,9 @@
 
 #include "graphics/opengl.hpp"
 
+#include <cstddef>
+#include <optional>
+
 namespace Graphics {
 class MeshObjectStorage;
 class Texture;
@@ -16,11 +19,36 @@ public:
         const std::vector<Texture>& textures,
         unsigned maxDimension);
 
+    // Incremental version of LoadData. Allocates the GL storage, after which
+    // ContinueLoadData is called once per frame until it returns true.
+    // The object store and textures must outlive the load.
+    void BeginLoadData(
+        const MeshObjectStorage& objectStore,
+        const std::vector<Texture>& textures,
+        unsigned maxDimension);
+
+    // Uploads roughly byteBudget bytes of the pending data.
+    // Returns true once everything has been uploaded.
+    bool ContinueLoadData(std::size_t byteBudget);
+
     void Bind(GLuint textureTarget) const;
 private:
+    void AddBuffersGL();
+
+    struct PendingLoad
+    {
+        const MeshObjectStorage* mObjectStore;
+        const std::vector<Texture>* mTextures;
+        unsigned mMaxDimension;
+        unsigned mBuffer;
+        std::size_t mBufferOffset;
+        unsigned mTexture;
+    };
+
     VertexArrayObject mVertexArrayObject;
     GLBuffers mGLBuffers;
     TextureBuffer mTextureBuffer;
+    std::optional<PendingLoad> mPendingLoad;
 };
 
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "graphics/drawBatch.hpp"
 #include "graphics/meshObject.hpp"
 #include "graphics/opengl.hpp"
 #include "graphics/framebuffer.hpp"
@@ -8,6 +9,7 @@
 
 #include "bak/types.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 
@@ -36,9 +38,7 @@ struct Light
 struct PickShaderUniforms
 {
     GLuint mTexture0;
-    GLuint mMVP;
-    GLuint mEntityId;
-    GLuint mM;
+    GLuint mVP;
     GLuint mCameraPosition_worldSpace;
 };
 
@@ -54,11 +54,8 @@ struct WorldShaderUniforms
     GLuint mLightSpecularColor;
     GLuint mLightSpaceMatrix;
     GLuint mCameraPosition_worldspace;
-    GLuint mMVP;
-    GLuint mM;
+    GLuint mVP;
     GLuint mV;
-    GLuint mUseInstanceColor;
-    GLuint mInstanceColor;
 };
 
 struct Text3DShaderUniforms
@@ -76,13 +73,20 @@ struct DepthMapShaderUniforms
 {
     GLuint mTexture0;
     GLuint mLightSpaceMatrix;
-    GLuint mM;
 };
 
 class Renderer
 {
     static constexpr auto sClickDistance = 16000;
+
+    struct AcceptAll
+    {
+        template <typename T>
+        bool operator()(const T&) const { return true; }
+    };
 public:
+    using DrawList = DrawBatchBuilder::List;
+
     Renderer(
         float screenWidth,
         float screenHeight,
@@ -108,11 +112,8 @@ public:
             mModelShader.GetUniformLocation("light.mSpecularColor"),
             mModelShader.GetUniformLocation("lightSpaceMatrix"),
             mModelShader.GetUniformLocation("cameraPosition_worldspace"),
-            mModelShader.GetUniformLocation("MVP"),
-            mModelShader.GetUniformLocation("M"),
-            mModelShader.GetUniformLocation("V"),
-            mModelShader.GetUniformLocation("useInstanceColor"),
-            mModelShader.GetUniformLocation("instanceColor")
+            mModelShader.GetUniformLocation("VP"),
+            mModelShader.GetUniformLocation("V")
         },
         mSpriteShader{std::invoke([]{
             auto shader = ShaderProgram{
@@ -131,11 +132,8 @@ public:
             mSpriteShader.GetUniformLocation("light.mSpecularColor"),
             mSpriteShader.GetUniformLocation("lightSpaceMatrix"),
             mSpriteShader.GetUniformLocation("cameraPosition_worldspace"),
-            mSpriteShader.GetUniformLocation("MVP"),
-            mSpriteShader.GetUniformLocation("M"),
-            mSpriteShader.GetUniformLocation("V"),
-            mSpriteShader.GetUniformLocation("useInstanceColor"),
-            mSpriteShader.GetUniformLocation("instanceColor")
+            mSpriteShader.GetUniformLocation("VP"),
+            mSpriteShader.GetUniformLocation("V")
         },
         mPickShader{std::invoke([]{
             auto shader = ShaderProgram{
@@ -145,9 +143,7 @@ public:
         })},
         mPickShaderUniforms{
             mPickShader.GetUniformLocation("texture0"),
-            mPickShader.GetUniformLocation("MVP"),
-            mPickShader.GetUniformLocation("entityId"),
-            0,
+            mPickShader.GetUniformLocation("VP"),
             0
         },
         mPickSpriteShader{std::invoke([]{
@@ -158,9 +154,7 @@ public:
         })},
         mPickSpriteShaderUniforms{
             mPickSpriteShader.GetUniformLocation("texture0"),
-            mPickSpriteShader.GetUniformLocation("MVP"),
-            mPickSpriteShader.GetUniformLocation("entityId"),
-            mPickSpriteShader.GetUniformLocation("M"),
+            mPickSpriteShader.GetUniformLocation("VP"),
             mPickSpriteShader.GetUniformLocation("cameraPosition_worldspace")
         },
         mShadowMapShader{std::invoke([]{
@@ -172,8 +166,7 @@ public:
         })},
         mShadowMapShaderUniforms{
             mShadowMapShader.GetUniformLocation("texture0"),
-            mShadowMapShader.GetUniformLocation("lightSpaceMatrix"),
-            mShadowMapShader.GetUniformLocation("M")
+            mShadowMapShader.GetUniformLocation("lightSpaceMatrix")
         },
         mNormalShader{std::invoke([]{
             auto shader = ShaderProgram{
@@ -198,6 +191,8 @@ public:
             mText3DShader.GetUniformLocation("glyphOffset"),
             mText3DShader.GetUniformLocation("glyphSize")
         },
+        mDrawBatches{},
+        mInstanceBuffers{},
         mPickFB{},
         mPickTexture{GL_TEXTURE_2D},
         mPickDepth{GL_TEXTURE_2D},
@@ -215,6 +210,14 @@ public:
 
         mHoverPBO.Allocate<glm::vec4>(GL_DYNAMIC_READ);
 
+        mInstanceBuffers.AddBuffer(
+            "instances",
+            GLNullLocation,
+            GLElems{sizeof(InstanceData) / sizeof(float)},
+            GLDataType{GL_FLOAT},
+            GLBindPoint::ArrayBuffer,
+            GLUpdateType::DynamicDraw);
+
         mDepthBuffer.MakeDepthBuffer(
             mDepthMapDims.x,
             mDepthMapDims.y);
@@ -225,89 +228,110 @@ public:
         glCullFace(GL_FRONT);
     }
 
-    template <typename Renderables, typename DynamicRenderables, typename Camera>
-    void DrawForPicking(
-        const RenderData& renderData,
+    // A pass collects the renderables of each draw into a list, uploads
+    // the instances of every list once in EndPass, and then draws the
+    // lists. The lists of a pass are valid until the next BeginPass.
+    void BeginPass()
+    {
+        mDrawBatches.Clear();
+    }
+
+    // Adds the visible renderables within draw distance that pass the filter
+    template <typename Renderables, typename Camera, typename Filter = AcceptAll>
+    DrawList AddDrawList(
         const Renderables& renderables,
-        const Renderables& sprites,
-        const DynamicRenderables& dynamicRenderables,
         const Camera& camera,
-        bool cullFaces = false)
+        Filter&& filter = {})
     {
-        renderData.Bind(GL_TEXTURE0);
+        const auto list = mDrawBatches.BeginList();
+        for (const auto& renderable : renderables)
+        {
+            const auto& item = Deref(renderable);
+            if (glm::distance(camera.GetPosition(), item.GetLocation()) > mDrawDistance || !item.GetVisible()) continue;
+            if (!filter(item)) continue;
+            mDrawBatches.AddInstance(
+                item.GetObject(),
+                item.GetModelMatrix(),
+                item.GetInstanceColor());
+        }
+        return list;
+    }
+
+    // Adds the renderables within click distance that pass the filter,
+    // tagged with their entity id
+    template <typename Renderables, typename Camera, typename Filter = AcceptAll>
+    DrawList AddPickList(
+        const Renderables& renderables,
+        const Camera& camera,
+        Filter&& filter = {})
+    {
+        const auto list = mDrawBatches.BeginList();
+        for (const auto& renderable : renderables)
+        {
+            const auto& item = Deref(renderable);
+            if (glm::distance(camera.GetPosition(), item.GetLocation()) > sClickDistance) continue;
+            if (!filter(item)) continue;
+            mDrawBatches.AddInstance(
+                item.GetObject(),
+                item.GetModelMatrix(),
+                std::nullopt,
+                item.GetId().mValue);
+        }
+        return list;
+    }
 
+    void EndPass()
+    {
+        mDrawBatches.Build();
+        const auto& instances = mDrawBatches.GetInstances();
+        if (instances.empty()) return;
+        mInstanceBuffers.LoadBufferDataGL("instances", instances);
+    }
+
+    void BeginPickDraw()
+    {
         mPickFB.BindGL();
         glViewport(mZoneViewport.x, mZoneViewport.y, mZoneViewport.z, mZoneViewport.w);
 
         glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
 
-        auto* shader = &mPickShader;
-        auto* uniforms = &mPickShaderUniforms;
-        shader->UseProgramGL();
+    void EndPickDraw()
+    {
+        mPickFB.UnbindGL();
+    }
 
-        shader->SetUniform(uniforms->mTexture0, 0);
+    template <typename Camera>
+    void DrawForPicking(
+        const RenderData& renderData,
+        DrawList list,
+        const Camera& camera,
+        bool isSprite,
+        bool cullFaces = false)
+    {
+        renderData.Bind(GL_TEXTURE0);
 
-        const auto& viewMatrix = camera.GetViewMatrix();
-        glm::mat4 MVP;
+        auto& shader = isSprite ? mPickSpriteShader : mPickShader;
+        auto& uniforms = isSprite ? mPickSpriteShaderUniforms : mPickShaderUniforms;
+        shader.UseProgramGL();
 
-        const auto RenderItem = [&](const auto& item, bool isSprite)
+        shader.SetUniform(uniforms.mTexture0, 0);
+        shader.SetUniform(uniforms.mVP, camera.GetProjectionMatrix() * camera.GetViewMatrix());
+        if (isSprite)
         {
-            if (glm::distance(camera.GetPosition(), item.GetLocation()) > sClickDistance) return;
-
-            const auto [offset, length] = item.GetObject();
-            const auto& modelMatrix = item.GetModelMatrix();
-
-            MVP = camera.GetProjectionMatrix() * viewMatrix * modelMatrix;
-
-            shader->SetUniform(uniforms->mMVP, MVP);
-            shader->SetUniform(uniforms->mEntityId, item.GetId().mValue);
-            if (isSprite)
-            {
-                shader->SetUniform(uniforms->mM, modelMatrix);
-                shader->SetUniform(uniforms->mCameraPosition_worldSpace, camera.GetNormalisedPosition());
-            }
-
-            glDrawElementsBaseVertex(
-                GL_TRIANGLES,
-                length,
-                GL_UNSIGNED_INT,
-                (void*) (offset * sizeof(GLuint)),
-                offset
-            );
-        };
+            shader.SetUniform(uniforms.mCameraPosition_worldSpace, camera.GetNormalisedPosition());
+        }
 
         if (cullFaces) glEnable(GL_CULL_FACE);
-        for (const auto& item : renderables)
-        {
-            RenderItem(item, false);
-        }
+        DrawBatchesGL(list);
         if (cullFaces) glDisable(GL_CULL_FACE);
-
-        shader = &mPickSpriteShader;
-        uniforms = &mPickSpriteShaderUniforms;
-        shader->UseProgramGL();
-
-        shader->SetUniform(uniforms->mEntityId, 0u);
-
-        for (const auto& item : sprites)
-        {
-            RenderItem(item, true);
-        }
-
-        for (const auto& item : dynamicRenderables)
-        {
-            item.GetRenderData()->Bind(GL_TEXTURE0);
-            RenderItem(item, true);
-        }
-
-        mPickFB.UnbindGL();
     }
 
-    template <typename Renderables, typename Camera>
+    template <typename Camera>
     void DrawWithShadow(
         const RenderData& renderData,
-        const Renderables& renderables,
+        DrawList list,
         const Light& light,
         const Camera& lightCamera,
         const Camera& camera,
@@ -340,44 +364,20 @@ public:
 
         shader.SetUniform(uniforms.mCameraPosition_worldspace, camera.GetNormalisedPosition());
 
-        const auto mvpMatrixId = uniforms.mMVP;
-        const auto modelMatrixId = uniforms.mM;
-        const auto viewMatrixId = uniforms.mV;
-
         const auto& viewMatrix = camera.GetViewMatrix();
-        glm::mat4 MVP;
+        shader.SetUniform(uniforms.mVP, camera.GetProjectionMatrix() * viewMatrix);
+        shader.SetUniform(uniforms.mV, viewMatrix);
 
         if (cullFaces) glEnable(GL_CULL_FACE);
-
-        for (const auto& item : renderables)
-        {
-            if (glm::distance(camera.GetPosition(), item.GetLocation()) > mDrawDistance || !item.GetVisible()) continue;
-            const auto [offset, length] = item.GetObject();
-            const auto& modelMatrix = item.GetModelMatrix();
-
-            MVP = camera.GetProjectionMatrix() * viewMatrix * modelMatrix;
-
-            shader.SetUniform(mvpMatrixId, MVP);
-            shader.SetUniform(modelMatrixId, modelMatrix);
-            shader.SetUniform(viewMatrixId, viewMatrix);
-
-            auto instanceColor = item.GetInstanceColor();
-            shader.SetUniform(uniforms.mUseInstanceColor, instanceColor.has_value() ? 1 : 0);
-            if (instanceColor)
-                shader.SetUniform(uniforms.mInstanceColor, *instanceColor);
-
-            glDrawElementsBaseVertex(
-                GL_TRIANGLES,
-                length,
-                GL_UNSIGNED_INT,
-                (void*) (offset * sizeof(GLuint)),
-                offset
-            );
-        }
-
+        DrawBatchesGL(list);
         if (cullFaces) glDisable(GL_CULL_FACE);
     }
 
+    int GetDrawDistance() const
+    {
+        return mDrawDistance;
+    }
+
     unsigned GetClickedEntity(glm::vec2 click)
     {
         mPickFB.BindGL();
@@ -422,10 +422,10 @@ public:
         mDepthFB.UnbindGL();
     }
 
-    template <typename Renderables, typename Camera>
+    template <typename Camera>
     void DrawDepthMap(
         const RenderData& renderData,
-        const Renderables& renderables,
+        DrawList list,
         const Camera& lightCamera)
     {
         renderData.Bind(GL_TEXTURE0);
@@ -440,24 +440,7 @@ public:
             lightSpaceMatrixId,
             lightCamera.GetProjectionMatrix() * lightCamera.GetViewMatrix());
 
-        const auto modelMatrixId = mShadowMapShaderUniforms.mM;
-
-        for (const auto& item : renderables)
-        {
-            if (glm::distance(lightCamera.GetPosition(), item.GetLocation()) > mDrawDistance || !item.GetVisible()) continue;
-            const auto [offset, length] = item.GetObject();
-            const auto& modelMatrix = item.GetModelMatrix();
-
-            shader.SetUniform(modelMatrixId, modelMatrix);
-
-            glDrawElementsBaseVertex(
-                GL_TRIANGLES,
-                length,
-                GL_UNSIGNED_INT,
-                (void*) (offset * sizeof(GLuint)),
-                offset
-            );
-        }
+        DrawBatchesGL(list);
     }
 
     template <typename Camera>
@@ -489,12 +472,11 @@ public:
             mText3DShader.SetUniform(mText3DShaderUniforms.mGlyphSize, item.mGlyphSize);
 
             const auto [offset, length] = item.mObject;
-            glDrawElementsBaseVertex(
+            glDrawElements(
                 GL_TRIANGLES,
                 length,
                 GL_UNSIGNED_INT,
-                (void*)(offset * sizeof(GLuint)),
-                offset);
+                (void*)(offset * sizeof(GLuint)));
         }
 
         glDepthMask(GL_TRUE);
@@ -502,6 +484,75 @@ public:
     }
 
 private:
+    // Shader location of the first per instance attribute
+    static constexpr unsigned sInstanceLocation = 5;
+
+    // Renderables may be passed by value or as pointers from a culled list
+    template <typename T>
+    static const T& Deref(const T& item) { return item; }
+    template <typename T>
+    static const T& Deref(const T* item) { return *item; }
+
+    // Expects the render data to be bound and the pass to have ended
+    void DrawBatchesGL(DrawList list)
+    {
+        for (const auto& batch : mDrawBatches.GetBatches(list))
+        {
+            // No base instance before GL 4.2, so point the instance
+            // attributes at the first instance of the batch instead
+            BindInstanceAttribsGL(batch.mFirstInstance);
+            glDrawElementsInstanced(
+                GL_TRIANGLES,
+                batch.mLength,
+                GL_UNSIGNED_INT,
+                (void*) (batch.mOffset * sizeof(GLuint)),
+                batch.mInstanceCount);
+        }
+    }
+
+    void BindInstanceAttribsGL(unsigned firstInstance)
+    {
+        const auto& buffer = mInstanceBuffers.GetGLBuffer("instances");
+        glBindBuffer(GL_ARRAY_BUFFER, buffer.mBuffer.mValue);
+
+        const auto stride = sizeof(InstanceData);
+        const auto base = firstInstance * stride;
+        const auto BindAttrib = [&](unsigned location, unsigned elems, std::size_t offset)
+        {
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(
+                location,
+                elems,
+                GL_FLOAT,
+                GL_FALSE,
+                stride,
+                (void*) (base + offset));
+            glVertexAttribDivisor(location, 1);
+        };
+
+        // A mat4 attribute takes a location per column
+        for (unsigned i = 0; i < 4; i++)
+        {
+            BindAttrib(
+                sInstanceLocation + i,
+                4,
+                offsetof(InstanceData, mModelMatrix) + i * sizeof(glm::vec4));
+        }
+        BindAttrib(sInstanceLocation + 4, 4, offsetof(InstanceData, mColor));
+        BindAttrib(sInstanceLocation + 5, 1, offsetof(InstanceData, mUseColor));
+
+        // Integer attribute, so it is not converted to float
+        const auto entityIdLocation = sInstanceLocation + 6;
+        glEnableVertexAttribArray(entityIdLocation);
+        glVertexAttribIPointer(
+            entityIdLocation,
+            1,
+            GL_UNSIGNED_INT,
+            stride,
+            (void*) (base + offsetof(InstanceData, mEntityId)));
+        glVertexAttribDivisor(entityIdLocation, 1);
+    }
+
     static unsigned DecodeEntityId(const glm::vec4& data)
     {
         return static_cast<unsigned>(data.r)
@@ -549,6 +600,9 @@ private:
     ShaderProgramHandle mText3DShader;
     Text3DShaderUniforms mText3DShaderUniforms;
 
+    DrawBatchBuilder mDrawBatches;
+    GLBuffers mInstanceBuffers;
+
     FrameBuffer mPickFB;
     TextureBuffer mPickTexture;
     TextureBuffer mPickDepth;
@@ -3,6 +3,7 @@
 #include "com/logger.hpp"
 
 #include "graphics/glm.hpp"
+#include "graphics/textureAtlas.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -50,6 +51,33 @@ SpriteQuad::SpriteQuad(
         {0, 1, 2, 3, 4, 5}}
 {}
 
+SpriteQuad::SpriteQuad(
+    const TextureAtlas& atlas,
+    std::size_t textureIndex)
+:
+    SpriteQuad{
+        std::vector<glm::vec3>{
+            {0, 1, 0},
+            {0, 0, 0},
+            {1, 0, 0},
+            {0, 1, 0},
+            {1, 0, 0},
+            {1, 1, 0}},
+        std::invoke([&](){
+            const auto dims = glm::vec2{atlas.GetRegion(textureIndex).mDims};
+            const auto min = atlas.GetCoords(textureIndex, glm::vec2{0});
+            const auto max = atlas.GetCoords(textureIndex, dims);
+            return std::vector<glm::vec3>{
+                {min.x, min.y, min.z},
+                {min.x, max.y, min.z},
+                {max.x, max.y, min.z},
+                {min.x, min.y, min.z},
+                {max.x, max.y, min.z},
+                {max.x, min.y, min.z}};
+        }),
+        {0, 1, 2, 3, 4, 5}}
+{}
+
 SpriteQuad::SpriteQuad(
     std::vector<glm::vec3> vertices,
     std::vector<glm::vec3> textureCoords,
@@ -14,6 +14,8 @@
 
 namespace Graphics {
 
+class TextureAtlas;
+
 class SpriteQuad
 {
 public:
@@ -23,6 +25,11 @@ public:
         double maxDim,
         unsigned textureIndex);
 
+    // Quad showing all of texture i of the atlas
+    SpriteQuad(
+        const TextureAtlas& atlas,
+        std::size_t textureIndex);
+
     SpriteQuad(
         std::vector<glm::vec3> vertices,
         std::vector<glm::vec3> textureCoords,
@@ -3,6 +3,8 @@
 #include "com/assert.hpp"
 #include "com/logger.hpp"
 
+#include "graphics/textureAtlas.hpp"
+
 #include <GL/glew.h>
 
 #include <memory>
@@ -58,9 +60,10 @@ void Sprites::UnbindGL() const
 
 void Sprites::LoadTexturesGL(const TextureStore& textures)
 {
+    const auto atlas = TextureAtlas{textures.GetTextures()};
     mTextureBuffer.LoadTexturesGL(
-        textures.GetTextures(),
-        textures.GetMaxDim());
+        atlas.GetLayers(),
+        atlas.GetLayerDim());
 
     // Normal quad for use as arbitrary rectangle
     mObjects.AddObject(SpriteQuad{1.0, 1.0, 1.0, 0});
@@ -69,12 +72,7 @@ void Sprites::LoadTexturesGL(const TextureStore& textures)
     for (unsigned i = 0; i < textures.GetTextures().size(); i++)
     {
         const auto& tex = textures.GetTexture(i);
-        mObjects.AddObject(
-            SpriteQuad{
-                static_cast<double>(tex.GetWidth()),
-                static_cast<double>(tex.GetHeight()),
-                static_cast<double>(textures.GetMaxDim()),
-                i});
+        mObjects.AddObject(SpriteQuad{atlas, i});
         mSpriteDimensions.emplace_back(
             tex.GetTargetWidth(),
             tex.GetTargetHeight());
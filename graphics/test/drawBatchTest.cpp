@@ -0,0 +1,131 @@
+#include "gtest/gtest.h"
+
+#include "graphics/drawBatch.hpp"
+
+#include <glm/glm.hpp>
+
+namespace Graphics {
+
+namespace {
+
+glm::mat4 Translation(float x)
+{
+    auto matrix = glm::mat4{1.0f};
+    matrix[3] = glm::vec4{x, 0, 0, 1};
+    return matrix;
+}
+
+}
+
+TEST(DrawBatchTest, GroupsInstancesOfTheSameObject)
+{
+    auto builder = DrawBatchBuilder{};
+    builder.AddInstance({30, 6}, Translation(1), std::nullopt);
+    builder.AddInstance({0, 12}, Translation(2), std::nullopt);
+    builder.AddInstance({30, 6}, Translation(3), glm::vec4{1, 0, 0, .5});
+    builder.AddInstance({0, 12}, Translation(4), std::nullopt);
+    builder.AddInstance({30, 6}, Translation(5), std::nullopt);
+    builder.Build();
+
+    const auto& batches = builder.GetBatches();
+    const auto& instances = builder.GetInstances();
+    ASSERT_EQ(batches.size(), 2u);
+    ASSERT_EQ(instances.size(), 5u);
+
+    EXPECT_EQ(batches[0].mOffset, 0u);
+    EXPECT_EQ(batches[0].mLength, 12u);
+    EXPECT_EQ(batches[0].mFirstInstance, 0u);
+    EXPECT_EQ(batches[0].mInstanceCount, 2u);
+
+    EXPECT_EQ(batches[1].mOffset, 30u);
+    EXPECT_EQ(batches[1].mLength, 6u);
+    EXPECT_EQ(batches[1].mFirstInstance, 2u);
+    EXPECT_EQ(batches[1].mInstanceCount, 3u);
+
+    // Instances keep the order they were added in within a batch
+    const auto expectedX = std::vector<float>{2, 4, 1, 3, 5};
+    for (unsigned i = 0; i < instances.size(); i++)
+    {
+        EXPECT_FLOAT_EQ(instances[i].mModelMatrix[3].x, expectedX[i]) << i;
+    }
+}
+
+TEST(DrawBatchTest, RecordsInstanceColor)
+{
+    auto builder = DrawBatchBuilder{};
+    builder.AddInstance({0, 3}, Translation(0), std::nullopt);
+    builder.AddInstance({0, 3}, Translation(0), glm::vec4{.25, .5, .75, 1});
+    builder.Build();
+
+    const auto& instances = builder.GetInstances();
+    ASSERT_EQ(instances.size(), 2u);
+    EXPECT_FLOAT_EQ(instances[0].mUseColor, 0.0f);
+    EXPECT_FLOAT_EQ(instances[1].mUseColor, 1.0f);
+    EXPECT_FLOAT_EQ(instances[1].mColor.y, .5f);
+    EXPECT_FLOAT_EQ(instances[1].mColor.z, .75f);
+}
+
+TEST(DrawBatchTest, ClearRemovesPreviousFrame)
+{
+    auto builder = DrawBatchBuilder{};
+    builder.AddInstance({0, 3}, Translation(0), std::nullopt);
+    builder.Build();
+    builder.Clear();
+    builder.Build();
+
+    EXPECT_TRUE(builder.GetBatches().empty());
+    EXPECT_TRUE(builder.GetInstances().empty());
+
+    builder.AddInstance({3, 3}, Translation(0), std::nullopt);
+    builder.Build();
+    ASSERT_EQ(builder.GetBatches().size(), 1u);
+    EXPECT_EQ(builder.GetBatches()[0].mInstanceCount, 1u);
+}
+
+TEST(DrawBatchTest, ListsAreBatchedSeparately)
+{
+    auto builder = DrawBatchBuilder{};
+    const auto models = builder.BeginList();
+    builder.AddInstance({0, 3}, Translation(0), std::nullopt);
+    builder.AddInstance({3, 6}, Translation(1), std::nullopt);
+    const auto sprites = builder.BeginList();
+    builder.AddInstance({0, 3}, Translation(2), std::nullopt);
+    const auto empty = builder.BeginList();
+    builder.Build();
+
+    ASSERT_EQ(builder.GetBatches().size(), 3u);
+
+    const auto modelBatches = builder.GetBatches(models);
+    ASSERT_EQ(modelBatches.size(), 2u);
+    EXPECT_EQ(modelBatches[0].mOffset, 0u);
+    EXPECT_EQ(modelBatches[0].mInstanceCount, 1u);
+    EXPECT_EQ(modelBatches[1].mOffset, 3u);
+
+    const auto spriteBatches = builder.GetBatches(sprites);
+    ASSERT_EQ(spriteBatches.size(), 1u);
+    EXPECT_EQ(spriteBatches[0].mOffset, 0u);
+    EXPECT_EQ(spriteBatches[0].mInstanceCount, 1u);
+    const auto& instance = builder.GetInstances()[spriteBatches[0].mFirstInstance];
+    EXPECT_FLOAT_EQ(instance.mModelMatrix[3].x, 2.0f);
+
+    EXPECT_TRUE(builder.GetBatches(empty).empty());
+    EXPECT_TRUE(builder.GetBatches(empty + 1).empty());
+}
+
+TEST(DrawBatchTest, KeepsEntityIdOfEachInstance)
+{
+    auto builder = DrawBatchBuilder{};
+    builder.AddInstance({3, 3}, Translation(0), std::nullopt, 7);
+    builder.AddInstance({0, 3}, Translation(1), std::nullopt, 8);
+    builder.AddInstance({3, 3}, Translation(2), std::nullopt, 9);
+    builder.Build();
+
+    const auto& batches = builder.GetBatches();
+    ASSERT_EQ(batches.size(), 2u);
+    const auto& instances = builder.GetInstances();
+    EXPECT_EQ(instances[batches[0].mFirstInstance].mEntityId, 8u);
+    EXPECT_EQ(instances[batches[1].mFirstInstance].mEntityId, 7u);
+    EXPECT_EQ(instances[batches[1].mFirstInstance + 1].mEntityId, 9u);
+}
+
+}
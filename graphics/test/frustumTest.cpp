@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+
+#include "graphics/frustum.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Graphics {
+
+namespace {
+
+// Looking down -z from the origin
+glm::mat4 MakeView()
+{
+    return glm::lookAt(
+        glm::vec3{0, 0, 0},
+        glm::vec3{0, 0, -1},
+        glm::vec3{0, 1, 0});
+}
+
+}
+
+TEST(FrustumTest, OrthographicVolume)
+{
+    const auto frustum = Frustum{
+        glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, 1.0f, 100.0f) * MakeView()};
+
+    EXPECT_TRUE(frustum.Intersects(glm::vec3{0, 0, -50}, 0.0f));
+    EXPECT_TRUE(frustum.Intersects(glm::vec3{9, -9, -99}, 0.0f));
+    // Behind, beside and beyond the far plane
+    EXPECT_FALSE(frustum.Intersects(glm::vec3{0, 0, 50}, 0.0f));
+    EXPECT_FALSE(frustum.Intersects(glm::vec3{20, 0, -50}, 0.0f));
+    EXPECT_FALSE(frustum.Intersects(glm::vec3{0, 0, -150}, 0.0f));
+
+    // Spheres and boxes that only overlap the edge of the volume
+    EXPECT_TRUE(frustum.Intersects(glm::vec3{11, 0, -50}, 2.0f));
+    EXPECT_FALSE(frustum.Intersects(glm::vec3{13, 0, -50}, 2.0f));
+    EXPECT_TRUE(frustum.Intersects(glm::vec3{5, 0, -60}, glm::vec3{30, 1, -40}));
+    EXPECT_FALSE(frustum.Intersects(glm::vec3{11, 0, -60}, glm::vec3{30, 1, -40}));
+}
+
+TEST(FrustumTest, PerspectiveVolume)
+{
+    const auto frustum = Frustum{
+        glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f) * MakeView()};
+
+    EXPECT_TRUE(frustum.Intersects(glm::vec3{0, 0, -10}, 0.0f));
+    // The volume is 20 wide 10 units in front of the camera
+    EXPECT_TRUE(frustum.Intersects(glm::vec3{9, 0, -10}, 0.0f));
+    EXPECT_FALSE(frustum.Intersects(glm::vec3{12, 0, -10}, 0.0f));
+    EXPECT_TRUE(frustum.Intersects(glm::vec3{60, 0, -70}, 0.0f));
+    EXPECT_FALSE(frustum.Intersects(glm::vec3{0, 0, -0.5f}, 0.0f));
+    EXPECT_FALSE(frustum.Intersects(glm::vec3{0, 0, -200}, 0.0f));
+}
+
+}
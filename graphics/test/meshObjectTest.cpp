@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "graphics/meshObject.hpp"
+#include "graphics/quad.hpp"
+
+#include <glm/glm.hpp>
+
+#include <stdexcept>
+
+namespace Graphics {
+
+namespace {
+
+MeshObject MakeQuad(float x)
+{
+    return Quad{
+        {{{x, 0, 0}, {x, 1, 0}, {x + 1, 1, 0}, {x + 1, 0, 0}}},
+        {{{0, 0, 0}, {0, 8, 0}, {8, 8, 0}, {8, 0, 0}}}
+    }.ToMeshObject(1.0f);
+}
+
+}
+
+TEST(MeshObjectTest, WeldsSharedCorners)
+{
+    const auto quad = MakeQuad(0);
+    EXPECT_EQ(quad.GetNumVertices(), 4u);
+    ASSERT_EQ(quad.mIndices.size(), 6u);
+    EXPECT_EQ(quad.mIndices[0], quad.mIndices[3]);
+    EXPECT_EQ(quad.mIndices[2], quad.mIndices[4]);
+}
+
+TEST(MeshObjectTest, KeepsVerticesThatDifferInAnyAttribute)
+{
+    auto builder = MeshBuilder{};
+    const auto a = PackVertex({0, 0, 0}, {0, 1, 0}, glm::vec4{1}, {0, 0, 0}, 0.0f);
+    const auto b = PackVertex({0, 0, 0}, {0, 1, 0}, glm::vec4{1}, {1, 0, 0}, 0.0f);
+    EXPECT_EQ(builder.AddVertex(a), 0u);
+    EXPECT_EQ(builder.AddVertex(b), 1u);
+    EXPECT_EQ(builder.AddVertex(a), 0u);
+    EXPECT_EQ(builder.GetNumIndices(), 3u);
+    EXPECT_EQ(std::move(builder).Build().GetNumVertices(), 2u);
+}
+
+TEST(MeshObjectTest, WeldsNegativeAndPositiveZero)
+{
+    const auto a = PackVertex({0, -0.0f, 1}, {0, 1, 0}, glm::vec4{1}, {0, 0, 0}, 0.0f);
+    const auto b = PackVertex({-0.0f, 0, 1}, {0, 1, 0}, glm::vec4{1}, {0, 0, 0}, 0.0f);
+    ASSERT_EQ(a, b);
+    EXPECT_EQ(VertexHash{}(a), VertexHash{}(b));
+
+    auto builder = MeshBuilder{};
+    EXPECT_EQ(builder.AddVertex(a), 0u);
+    EXPECT_EQ(builder.AddVertex(b), 0u);
+    EXPECT_EQ(std::move(builder).Build().GetNumVertices(), 1u);
+}
+
+TEST(MeshObjectTest, PacksAttributes)
+{
+    const auto vertex = PackVertex(
+        {1, 2, 3},
+        {0, 1, 0},
+        glm::vec4{1, 0, 0.5, 1},
+        {400, 2, 3},
+        1.0f);
+    EXPECT_EQ(vertex.mPosition, glm::vec3(1, 2, 3));
+    EXPECT_EQ(vertex.mColor, glm::u8vec4(255, 0, 128, 255));
+    // Repeating textures have coordinates past the layer
+    EXPECT_EQ(vertex.mTextureCoord, glm::u16vec3(400, 2, 3));
+    EXPECT_EQ(vertex.mTextureBlend, 0xffff);
+}
+
+TEST(MeshObjectTest, StorageIndicesReferToAllVertices)
+{
+    auto builder = MeshObjectStorageBuilder{};
+    const auto first = builder.AddObject("first", MakeQuad(0));
+    const auto second = builder.AddObject("second", MakeQuad(2));
+    EXPECT_EQ(builder.AddObject("first", MakeQuad(4)), first);
+
+    EXPECT_EQ(first, std::make_pair(0u, 6u));
+    EXPECT_EQ(second, std::make_pair(6u, 6u));
+
+    const auto storage = std::move(builder).Build();
+    EXPECT_EQ(storage.size(), 2u);
+    EXPECT_EQ(storage.GetObject("second"), second);
+    ASSERT_EQ(storage.GetVertices().size(), 8u);
+    ASSERT_EQ(storage.GetIndices().size(), 12u);
+    for (unsigned i = second.first; i < second.first + second.second; i++)
+    {
+        const auto index = storage.GetIndices()[i];
+        EXPECT_GE(index, 4u);
+        EXPECT_GE(storage.GetVertices()[index].mPosition.x, 2.0f);
+    }
+}
+
+TEST(MeshObjectTest, BuilderAppendsToExistingStorage)
+{
+    auto builder = MeshObjectStorageBuilder{};
+    builder.AddObject("first", MakeQuad(0));
+    auto extended = MeshObjectStorageBuilder{std::move(builder).Build()};
+    const auto second = extended.AddObject("second", MakeQuad(2));
+    EXPECT_EQ(second, std::make_pair(6u, 6u));
+
+    const auto storage = std::move(extended).Build();
+    EXPECT_EQ(storage.GetObject("first"), std::make_pair(0u, 6u));
+    EXPECT_EQ(storage.GetVertices().size(), 8u);
+    EXPECT_EQ(storage.GetIndices()[second.first], 4u + storage.GetIndices()[0]);
+    EXPECT_THROW(storage.GetObject("third"), std::runtime_error);
+}
+
+}
@@ -0,0 +1,165 @@
+#include "gtest/gtest.h"
+
+#include "graphics/textureAtlas.hpp"
+#include "graphics/texture.hpp"
+
+#include <glm/glm.hpp>
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Graphics {
+
+namespace {
+
+Texture MakeTexture(unsigned width, unsigned height, std::uint8_t value)
+{
+    return Texture{
+        Texture::TextureType(width * height, Pixel{value}),
+        width, height, width, height};
+}
+
+bool Overlaps(const AtlasRegion& lhs, const AtlasRegion& rhs)
+{
+    return lhs.mLayer == rhs.mLayer
+        && lhs.mOffset.x < rhs.mOffset.x + rhs.mDims.x
+        && rhs.mOffset.x < lhs.mOffset.x + lhs.mDims.x
+        && lhs.mOffset.y < rhs.mOffset.y + rhs.mDims.y
+        && rhs.mOffset.y < lhs.mOffset.y + lhs.mDims.y;
+}
+
+}
+
+TEST(TextureAtlasTest, PacksSmallTexturesIntoOneLayerWithoutOverlap)
+{
+    auto textures = std::vector<Texture>{};
+    for (unsigned i = 0; i < 20; i++)
+    {
+        textures.emplace_back(MakeTexture(10 + i, 30 - i, i + 1));
+    }
+
+    const auto atlas = TextureAtlas{textures, {}, 128};
+
+    ASSERT_EQ(atlas.size(), textures.size());
+    EXPECT_EQ(atlas.GetLayers().size(), 1u);
+    for (unsigned i = 0; i < textures.size(); i++)
+    {
+        const auto& region = atlas.GetRegion(i);
+        EXPECT_EQ(region.mDims, glm::uvec2(textures[i].GetWidth(), textures[i].GetHeight()));
+        EXPECT_LE(region.mOffset.x + region.mDims.x, 128u);
+        EXPECT_LE(region.mOffset.y + region.mDims.y, 128u);
+
+        const auto& layer = atlas.GetLayers()[region.mLayer];
+        EXPECT_EQ(layer.GetPixel(region.mOffset.x, region.mOffset.y), Pixel(i + 1));
+        EXPECT_EQ(
+            layer.GetPixel(
+                region.mOffset.x + region.mDims.x - 1,
+                region.mOffset.y + region.mDims.y - 1),
+            Pixel(i + 1));
+
+        for (unsigned j = 0; j < i; j++)
+        {
+            EXPECT_FALSE(Overlaps(region, atlas.GetRegion(j))) << i << " " << j;
+        }
+    }
+}
+
+TEST(TextureAtlasTest, WrappingTexturesAreTiledInTheirOwnLayer)
+{
+    auto wrapping = Texture{2, 2, 2, 2};
+    wrapping.SetPixel(0, 0, Pixel{1});
+    wrapping.SetPixel(1, 0, Pixel{2});
+    wrapping.SetPixel(0, 1, Pixel{3});
+    wrapping.SetPixel(1, 1, Pixel{4});
+    const auto textures = std::vector<Texture>{
+        MakeTexture(4, 4, 9), wrapping, MakeTexture(4, 4, 8)};
+
+    const auto atlas = TextureAtlas{textures, {false, true, false}, 16};
+
+    ASSERT_EQ(atlas.GetLayers().size(), 2u);
+    const auto& region = atlas.GetRegion(1);
+    EXPECT_EQ(region.mOffset, glm::uvec2(0));
+    EXPECT_NE(region.mLayer, atlas.GetRegion(0).mLayer);
+    EXPECT_EQ(atlas.GetRegion(0).mLayer, atlas.GetRegion(2).mLayer);
+
+    const auto& layer = atlas.GetLayers()[region.mLayer];
+    for (unsigned y = 0; y < 16; y++)
+    {
+        for (unsigned x = 0; x < 16; x++)
+        {
+            EXPECT_EQ(layer.GetPixel(x, y), wrapping.GetPixel(x % 2, y % 2));
+        }
+    }
+}
+
+TEST(TextureAtlasTest, LayersAreAMultipleOfEachWrappingTexture)
+{
+    // Enough area that the layers would otherwise be sized to fit it
+    auto textures = std::vector<Texture>{};
+    auto wrap = std::vector<bool>{};
+    for (unsigned i = 0; i < 30; i++)
+    {
+        textures.emplace_back(MakeTexture(17 + i, 13 + i, 1));
+        wrap.emplace_back(false);
+    }
+    for (const auto& [width, height] : {std::pair{64u, 64u}, {48u, 32u}, {40u, 40u}})
+    {
+        textures.emplace_back(MakeTexture(width, height, 2));
+        wrap.emplace_back(true);
+    }
+
+    const auto atlas = TextureAtlas{textures, wrap};
+
+    const auto layerDim = atlas.GetLayerDim();
+    for (unsigned i = 0; i < textures.size(); i++)
+    {
+        if (wrap[i])
+        {
+            EXPECT_EQ(layerDim % textures[i].GetWidth(), 0u) << layerDim << " " << i;
+            EXPECT_EQ(layerDim % textures[i].GetHeight(), 0u) << layerDim << " " << i;
+        }
+    }
+}
+
+TEST(TextureAtlasTest, ThrowsWhenWrappingTextureDoesNotTileLayers)
+{
+    auto atlas = TextureAtlas{64};
+    EXPECT_NO_THROW(atlas.AddTexture(MakeTexture(32, 16, 1), true));
+    EXPECT_THROW(atlas.AddTexture(MakeTexture(24, 16, 1), true), std::runtime_error);
+    EXPECT_NO_THROW(atlas.AddTexture(MakeTexture(24, 16, 1), false));
+}
+
+TEST(TextureAtlasTest, MapsTexelsToLayerCoordinates)
+{
+    auto atlas = TextureAtlas{64};
+    atlas.AddTexture(MakeTexture(16, 8, 1));
+    const auto second = atlas.AddTexture(MakeTexture(8, 8, 2));
+
+    const auto& region = atlas.GetRegion(second);
+    const auto coords = atlas.GetCoords(second, glm::vec2{8, 8});
+    EXPECT_FLOAT_EQ(coords.x, (region.mOffset.x + 8) / 64.0f);
+    EXPECT_FLOAT_EQ(coords.y, (region.mOffset.y + 8) / 64.0f);
+    EXPECT_FLOAT_EQ(coords.z, static_cast<float>(region.mLayer));
+}
+
+TEST(TextureAtlasTest, MapsTexelsToLayerTexels)
+{
+    auto atlas = TextureAtlas{64};
+    atlas.AddTexture(MakeTexture(16, 8, 1));
+    const auto second = atlas.AddTexture(MakeTexture(8, 8, 2));
+
+    const auto& region = atlas.GetRegion(second);
+    const auto coords = atlas.GetTexelCoords(second, glm::vec2{7, 3});
+    EXPECT_FLOAT_EQ(coords.x, region.mOffset.x + 7.0f);
+    EXPECT_FLOAT_EQ(coords.y, region.mOffset.y + 3.0f);
+    EXPECT_FLOAT_EQ(coords.z, static_cast<float>(region.mLayer));
+}
+
+TEST(TextureAtlasTest, ThrowsWhenTextureIsLargerThanLayers)
+{
+    auto atlas = TextureAtlas{32};
+    EXPECT_THROW(atlas.AddTexture(MakeTexture(33, 4, 1)), std::runtime_error);
+}
+
+}
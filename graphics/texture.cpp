@@ -4,19 +4,31 @@
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Graphics {
 
+Pixel ToPixel(glm::vec4 color)
+{
+    return Pixel{glm::round(glm::clamp(color, 0.0f, 1.0f) * 255.0f)};
+}
+
+glm::vec4 ToColor(Pixel pixel)
+{
+    return glm::vec4{pixel} / 255.0f;
+}
+
 Texture::Texture(
-    const TextureType& texture,
+    TextureType texture,
     unsigned width,
     unsigned height,
     unsigned targetWidth,
     unsigned targetHeight)
 :
-    mTexture{texture},
+    mTexture{std::move(texture)},
     mWidth{width},
     mHeight{height},
     mTargetWidth{targetWidth},
@@ -29,7 +41,7 @@ Texture::Texture(
     unsigned targetWidth,
     unsigned targetHeight)
 :
-    mTexture{width * height, glm::vec4{0}},
+    mTexture(width * height, Pixel{0}),
     mWidth{width},
     mHeight{height},
     mTargetWidth{targetWidth},
@@ -38,7 +50,7 @@ Texture::Texture(
 }
 
 // Get pixel wrapping access
-glm::vec4 Texture::GetPixel(unsigned x, unsigned y) const
+Pixel Texture::GetPixel(unsigned x, unsigned y) const
 {
     if (mRepeat)
     {
@@ -50,7 +62,7 @@ glm::vec4 Texture::GetPixel(unsigned x, unsigned y) const
     {
         if (x > GetWidth() || (y > GetHeight()))
         {
-            return glm::vec4{};
+            return Pixel{0};
         }
         return mTexture[
             (x % GetWidth())
@@ -58,11 +70,16 @@ glm::vec4 Texture::GetPixel(unsigned x, unsigned y) const
     }
 }
 
-void Texture::SetPixel(unsigned x, unsigned y, glm::vec4 color)
+void Texture::SetPixel(unsigned x, unsigned y, Pixel pixel)
 {
     mTexture[
         (x % GetWidth()) 
-        + (y % GetHeight()) * GetWidth()] = color;
+        + (y % GetHeight()) * GetWidth()] = pixel;
+}
+
+void Texture::SetPixel(unsigned x, unsigned y, glm::vec4 color)
+{
+    SetPixel(x, y, ToPixel(color));
 }
 
 void Texture::Invert()
@@ -87,6 +104,41 @@ Texture Texture::GetRegion(glm::ivec2 pos, glm::uvec2 dims) const
     return newTexture;
 }
 
+void Texture::Blit(
+    std::vector<Pixel>& target,
+    unsigned targetWidth,
+    glm::uvec2 offset) const
+{
+    for (unsigned y = 0; y < GetHeight(); y++)
+    {
+        const auto source = mTexture.begin() + y * GetWidth();
+        std::copy(
+            source,
+            source + GetWidth(),
+            target.begin() + (offset.y + y) * targetWidth + offset.x);
+    }
+}
+
+void Texture::Tile(
+    std::vector<Pixel>& target,
+    unsigned targetWidth,
+    glm::uvec2 offset,
+    glm::uvec2 dims) const
+{
+    if (GetWidth() == 0 || GetHeight() == 0) return;
+
+    for (unsigned y = 0; y < dims.y; y++)
+    {
+        const auto source = mTexture.begin() + (y % GetHeight()) * GetWidth();
+        auto destination = target.begin() + (offset.y + y) * targetWidth + offset.x;
+        for (unsigned x = 0; x < dims.x; x += GetWidth())
+        {
+            const auto length = std::min(GetWidth(), dims.x - x);
+            destination = std::copy(source, source + length, destination);
+        }
+    }
+}
+
 unsigned Texture::GetWidth() const { return mWidth; }
 unsigned Texture::GetHeight() const { return mHeight; }
 unsigned Texture::GetTargetWidth() const { return mTargetWidth; }
@@ -104,13 +156,18 @@ TextureStore::TextureStore()
 {}
 
 void TextureStore::AddTexture(const Texture& texture)
+{
+    AddTexture(Texture{texture});
+}
+
+void TextureStore::AddTexture(Texture&& texture)
 {
     if (texture.GetHeight() > mMaxHeight)
         mMaxHeight = texture.GetHeight();
     if (texture.GetWidth() > mMaxWidth)
         mMaxWidth = texture.GetWidth();
     mMaxDim = std::max(mMaxHeight, mMaxWidth);
-    mTextures.emplace_back(texture);
+    mTextures.emplace_back(std::move(texture));
 }
 
 const std::vector<Texture>& TextureStore::GetTextures() const { return mTextures; }
@@ -122,4 +179,14 @@ unsigned TextureStore::GetMaxHeight() const { return mMaxHeight; }
 unsigned TextureStore::GetMaxWidth() const { return mMaxWidth; }
 std::size_t TextureStore::size() const { return mTextures.size(); }
 
+std::size_t TextureStore::GetSizeInBytes() const
+{
+    std::size_t bytes = 0;
+    for (const auto& texture : mTextures)
+    {
+        bytes += texture.GetTexture().size() * sizeof(Pixel);
+    }
+    return bytes;
+}
+
 }
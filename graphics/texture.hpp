@@ -3,19 +3,27 @@
 #include "com/assert.hpp"
 
 #include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace Graphics {
 
+// 8 bit RGBA, the format textures are stored in on the GPU
+using Pixel = glm::u8vec4;
+
+Pixel ToPixel(glm::vec4 color);
+glm::vec4 ToColor(Pixel pixel);
+
 class Texture
 {
 public:
-    using TextureType = std::vector<glm::vec4>;
+    using TextureType = std::vector<Pixel>;
 
     Texture(
-        const TextureType& texture,
+        TextureType texture,
         unsigned width,
         unsigned height,
         unsigned targetWidth,
@@ -28,12 +36,25 @@ public:
         unsigned targetHeight);
 
     // Get pixel wrapping access
-    glm::vec4 GetPixel(unsigned x, unsigned y) const;
+    Pixel GetPixel(unsigned x, unsigned y) const;
+    void SetPixel(unsigned x, unsigned y, Pixel pixel);
     void SetPixel(unsigned x, unsigned y, glm::vec4 color);
     void Invert();
 
     Texture GetRegion(glm::ivec2 pos, glm::uvec2 dims) const;
 
+    // Copy into a row major target at offset, a row at a time
+    void Blit(
+        std::vector<Pixel>& target,
+        unsigned targetWidth,
+        glm::uvec2 offset) const;
+    // Fill a region of a row major target by repeating the texture
+    void Tile(
+        std::vector<Pixel>& target,
+        unsigned targetWidth,
+        glm::uvec2 offset,
+        glm::uvec2 dims) const;
+
     unsigned GetWidth() const;
     unsigned GetHeight() const;
     unsigned GetTargetWidth() const;
@@ -43,6 +64,7 @@ public:
     TextureType& GetTexture();
 
     void SetRepeat(bool state) { mRepeat = state; }
+    bool GetRepeat() const { return mRepeat; }
 private:
     TextureType mTexture;
     unsigned mWidth;
@@ -58,6 +80,7 @@ public:
     TextureStore();
 
     void AddTexture(const Texture& texture);
+    void AddTexture(Texture&& texture);
 
     const std::vector<Texture>& GetTextures() const;
     const Texture& GetTexture(std::size_t i) const;
@@ -67,6 +90,8 @@ public:
     unsigned GetMaxHeight() const;
     unsigned GetMaxWidth() const;
     std::size_t size() const;
+    // Bytes of pixel data held, excluding the padding added on upload
+    std::size_t GetSizeInBytes() const;
 
 private:
     std::vector<Texture> mTextures;
@@ -0,0 +1,209 @@
+#include "graphics/textureAtlas.hpp"
+
+#include "com/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace Graphics {
+
+namespace {
+
+bool Wraps(const std::vector<bool>& wrap, std::size_t i)
+{
+    return i < wrap.size() && wrap[i];
+}
+
+// Big enough for the largest texture, and for everything to fit in a few
+// layers without each being excessively large. GL_REPEAT wraps at the
+// layer edge, so it is also a multiple of every wrapping texture's size.
+unsigned ChooseLayerDim(
+    const std::vector<Texture>& textures,
+    const std::vector<bool>& wrap)
+{
+    unsigned maxDim = 0;
+    unsigned wrapMultiple = 1;
+    std::size_t area = 0;
+    for (std::size_t i = 0; i < textures.size(); i++)
+    {
+        const auto& texture = textures[i];
+        maxDim = std::max({maxDim, texture.GetWidth(), texture.GetHeight()});
+        area += (texture.GetWidth() + TextureAtlas::sGutter)
+            * (texture.GetHeight() + TextureAtlas::sGutter);
+        if (Wraps(wrap, i))
+        {
+            wrapMultiple = std::lcm(wrapMultiple, texture.GetWidth());
+            wrapMultiple = std::lcm(wrapMultiple, texture.GetHeight());
+        }
+    }
+    const auto side = static_cast<unsigned>(std::ceil(std::sqrt(area)));
+    const auto layerDim = std::max(maxDim, std::min(side, TextureAtlas::sMaxPackedLayerDim));
+    return (layerDim + wrapMultiple - 1) / wrapMultiple * wrapMultiple;
+}
+
+}
+
+TextureAtlas::TextureAtlas()
+:
+    TextureAtlas{0}
+{}
+
+TextureAtlas::TextureAtlas(unsigned layerDim)
+:
+    mLayerDim{layerDim},
+    mLayers{},
+    mLayerHeights{},
+    mShelves{},
+    mRegions{}
+{}
+
+TextureAtlas::TextureAtlas(
+    const std::vector<Texture>& textures,
+    const std::vector<bool>& wrap)
+:
+    TextureAtlas{textures, wrap, ChooseLayerDim(textures, wrap)}
+{}
+
+TextureAtlas::TextureAtlas(
+    const std::vector<Texture>& textures,
+    const std::vector<bool>& wrap,
+    unsigned layerDim)
+:
+    TextureAtlas{layerDim}
+{
+    for (std::size_t i = 0; i < textures.size(); i++)
+    {
+        CheckFits(textures[i], Wraps(wrap, i));
+    }
+
+    std::vector<std::size_t> order(textures.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&](auto lhs, auto rhs){
+            return textures[lhs].GetHeight() > textures[rhs].GetHeight();
+        });
+
+    mRegions.resize(textures.size());
+    for (const auto i : order)
+    {
+        mRegions[i] = Pack(textures[i], Wraps(wrap, i));
+    }
+}
+
+std::size_t TextureAtlas::AddTexture(const Texture& texture, bool wrap)
+{
+    CheckFits(texture, wrap);
+    mRegions.emplace_back(Pack(texture, wrap));
+    return mRegions.size() - 1;
+}
+
+const AtlasRegion& TextureAtlas::GetRegion(std::size_t i) const
+{
+    ASSERT(i < mRegions.size());
+    return mRegions[i];
+}
+
+glm::vec3 TextureAtlas::GetCoords(std::size_t i, glm::vec2 texel) const
+{
+    const auto& region = GetRegion(i);
+    const auto coords = (glm::vec2{region.mOffset} + texel)
+        / static_cast<float>(mLayerDim);
+    return glm::vec3{coords, region.mLayer};
+}
+
+glm::vec3 TextureAtlas::GetTexelCoords(std::size_t i, glm::vec2 texel) const
+{
+    const auto& region = GetRegion(i);
+    return glm::vec3{glm::vec2{region.mOffset} + texel, region.mLayer};
+}
+
+unsigned TextureAtlas::GetLayerDim() const { return mLayerDim; }
+const std::vector<Texture>& TextureAtlas::GetLayers() const { return mLayers; }
+std::size_t TextureAtlas::size() const { return mRegions.size(); }
+
+void TextureAtlas::CheckFits(const Texture& texture, bool wrap) const
+{
+    if (texture.GetWidth() > mLayerDim || texture.GetHeight() > mLayerDim)
+    {
+        std::stringstream ss{};
+        ss << __FUNCTION__ << " Texture (" << texture.GetWidth() << ", "
+            << texture.GetHeight() << ") does not fit in atlas layers of "
+            << mLayerDim;
+        throw std::runtime_error(ss.str());
+    }
+
+    // Otherwise there would be a seam where the layer wraps
+    if (wrap && (mLayerDim % texture.GetWidth() != 0 || mLayerDim % texture.GetHeight() != 0))
+    {
+        std::stringstream ss{};
+        ss << __FUNCTION__ << " Wrapping texture (" << texture.GetWidth() << ", "
+            << texture.GetHeight() << ") does not tile atlas layers of "
+            << mLayerDim;
+        throw std::runtime_error(ss.str());
+    }
+}
+
+AtlasRegion TextureAtlas::Pack(const Texture& texture, bool wrap)
+{
+    const auto dims = glm::uvec2{texture.GetWidth(), texture.GetHeight()};
+
+    if (wrap)
+    {
+        const auto layer = AddLayer();
+        mLayerHeights[layer] = mLayerDim;
+        texture.Tile(
+            mLayers[layer].GetTexture(),
+            mLayerDim,
+            glm::uvec2{0},
+            glm::uvec2{mLayerDim});
+        return AtlasRegion{layer, glm::uvec2{0}, dims};
+    }
+
+    const auto packed = glm::uvec2{
+        std::min(dims.x + sGutter, mLayerDim),
+        std::min(dims.y + sGutter, mLayerDim)};
+
+    auto shelf = std::find_if(mShelves.begin(), mShelves.end(),
+        [&](const auto& shelf){
+            return packed.y <= shelf.mHeight
+                && shelf.mX + packed.x <= mLayerDim;
+        });
+
+    if (shelf == mShelves.end())
+    {
+        auto layer = static_cast<unsigned>(mLayers.size());
+        for (unsigned i = 0; i < mLayers.size(); i++)
+        {
+            if (mLayerHeights[i] + packed.y <= mLayerDim)
+            {
+                layer = i;
+                break;
+            }
+        }
+        if (layer == mLayers.size())
+        {
+            layer = AddLayer();
+        }
+
+        mShelves.emplace_back(Shelf{layer, mLayerHeights[layer], packed.y, 0});
+        mLayerHeights[layer] += packed.y;
+        shelf = mShelves.end() - 1;
+    }
+
+    const auto offset = glm::uvec2{shelf->mX, shelf->mY};
+    shelf->mX += packed.x;
+    texture.Blit(mLayers[shelf->mLayer].GetTexture(), mLayerDim, offset);
+    return AtlasRegion{shelf->mLayer, offset, dims};
+}
+
+unsigned TextureAtlas::AddLayer()
+{
+    mLayers.emplace_back(Texture{mLayerDim, mLayerDim, mLayerDim, mLayerDim});
+    mLayerHeights.emplace_back(0);
+    return mLayers.size() - 1;
+}
+
+}
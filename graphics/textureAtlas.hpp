@@ -0,0 +1,83 @@
+#pragma once
+
+#include "graphics/texture.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace Graphics {
+
+struct AtlasRegion
+{
+    unsigned mLayer;
+    glm::uvec2 mOffset;
+    glm::uvec2 mDims;
+};
+
+// Packs textures onto shelves in as few square layers as possible, rather
+// than giving every texture a layer padded to the size of the largest.
+//
+// Textures that need to wrap get a layer to themselves, tiled to fill it,
+// so that GL_REPEAT on the texture array still repeats them. The layers
+// must be a multiple of their size for the tiles to meet at the wrap.
+class TextureAtlas
+{
+public:
+    // Layers are never made larger than this unless a texture needs it
+    static constexpr unsigned sMaxPackedLayerDim = 256;
+    // Empty texels to the right of and above each packed texture
+    static constexpr unsigned sGutter = 1;
+
+    TextureAtlas();
+    explicit TextureAtlas(unsigned layerDim);
+
+    // Packs the textures tallest first, choosing a layer size that fits
+    // the largest and that the wrapping ones tile. wrap is indexed by
+    // texture and may be empty.
+    explicit TextureAtlas(
+        const std::vector<Texture>& textures,
+        const std::vector<bool>& wrap = {});
+
+    TextureAtlas(
+        const std::vector<Texture>& textures,
+        const std::vector<bool>& wrap,
+        unsigned layerDim);
+
+    // Returns the index of the new texture. Throws if it is larger than
+    // the layers, or wraps and does not tile them exactly.
+    std::size_t AddTexture(const Texture& texture, bool wrap = false);
+
+    const AtlasRegion& GetRegion(std::size_t i) const;
+    // Maps texel coordinates within texture i to texture array coordinates
+    glm::vec3 GetCoords(std::size_t i, glm::vec2 texel) const;
+    // As GetCoords, but in texels of the layer rather than normalized
+    glm::vec3 GetTexelCoords(std::size_t i, glm::vec2 texel) const;
+
+    unsigned GetLayerDim() const;
+    const std::vector<Texture>& GetLayers() const;
+    std::size_t size() const;
+
+private:
+    struct Shelf
+    {
+        unsigned mLayer;
+        unsigned mY;
+        unsigned mHeight;
+        unsigned mX;
+    };
+
+    void CheckFits(const Texture& texture, bool wrap) const;
+    AtlasRegion Pack(const Texture& texture, bool wrap);
+    unsigned AddLayer();
+
+    unsigned mLayerDim;
+    std::vector<Texture> mLayers;
+    // Height taken by shelves in each layer
+    std::vector<unsigned> mLayerHeights;
+    std::vector<Shelf> mShelves;
+    std::vector<AtlasRegion> mRegions;
+};
+
+}
@@ -79,7 +79,7 @@ Backgrounds::Backgrounds(
         {
             if (pixel.a == 0)
             {
-                pixel = Color::black;
+                pixel = Graphics::ToPixel(Color::black);
             }
         }
         const auto vp = BAK::LoadZoneViewport();
@@ -9,6 +9,7 @@
 #include "gui/fontManager.hpp"
 
 #include "bak/dialogSources.hpp"
+#include "bak/resourceCache.hpp"
 #include "bak/textureFactory.hpp"
 #include "bak/scene/ttmRenderer.hpp"
 #include "bak/dialog.hpp"
@@ -223,7 +224,7 @@ bool DynamicTTM::AdvanceFrame()
                 },
                 [&](const BAK::LoadPalette& p){
                     mPaletteSlots.erase(mCurrentPaletteSlot);
-                    mPaletteSlots.emplace(mCurrentPaletteSlot, BAK::Palette{p.mPalette});
+                    mPaletteSlots.emplace(mCurrentPaletteSlot, BAK::ResourceCache::Get().GetPalette(p.mPalette));
                 },
                 [&](const BAK::PlaySoundS& sound){
                     if (sound.mSoundIndex < 255)
@@ -263,7 +264,7 @@ glm::vec3 DynamicTTM::GetPaletteColor(unsigned index) const
         return glm::vec3{0};
     }
 
-    return glm::vec3{mPaletteSlots.at(mCurrentPaletteSlot).GetColor(index)};
+    return glm::vec3{mPaletteSlots.at(mCurrentPaletteSlot)->GetColor(index)};
 }
 
 bool DynamicTTM::StartFade(unsigned startColor, unsigned endColor, unsigned durationIndex, bool fadeIn)
@@ -13,6 +13,7 @@
 
 #include <glm/glm.hpp>
 
+#include <memory>
 #include <optional>
 #include <unordered_map>
 #include <vector>
@@ -75,7 +76,7 @@ private:
     bool mFramePresented = false;
     double mDelay = 0;
 
-    std::unordered_map<unsigned, BAK::Palette> mPaletteSlots;
+    std::unordered_map<unsigned, std::shared_ptr<const BAK::Palette>> mPaletteSlots;
     unsigned mCurrentPaletteSlot{0};
 
     Graphics::TextureStore mRenderedFrames;
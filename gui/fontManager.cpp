@@ -1,7 +1,7 @@
 #include "gui/fontManager.hpp"
 
 #include "bak/font.hpp"
-#include "bak/fileBufferFactory.hpp"
+#include "bak/resourceCache.hpp"
 
 #include "graphics/sprites.hpp"
 
@@ -11,10 +11,7 @@ Font::Font(
     const std::string& font,
     Graphics::SpriteManager& spriteManager)
 :
-    mFont{std::invoke([&]{
-        auto fb = BAK::FileBufferFactory::Get().CreateDataBuffer(font);
-        return BAK::LoadFont(fb);
-    })},
+    mFont{*BAK::ResourceCache::Get().GetFont(font)},
     mSpriteSheet{spriteManager.AddSpriteSheet()}
 {
     spriteManager.GetSpriteSheet(mSpriteSheet)
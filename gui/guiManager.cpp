@@ -197,13 +197,32 @@ void GuiManager::LoadGame(std::string save, std::optional<BAK::Chapter> chapter)
 
 void GuiManager::SaveGame(const BAK::SaveFile& saveFile)
 {
-    mGameState.Save(saveFile);
+    SaveInBackground(saveFile);
     EnterMainView();
 }
 
 void GuiManager::SaveBookmark()
 {
-    mGameState.Save(mMainMenu.SaveBookmark());
+    SaveInBackground(mMainMenu.SaveBookmark());
+}
+
+void GuiManager::SaveInBackground(const BAK::SaveFile& saveFile)
+{
+    if (mZoneLoader && mZoneLoader->IsZoneLoading())
+    {
+        mLogger.Error() << "Not saving to: " << saveFile.mPath
+            << " while a zone is loading" << std::endl;
+        return;
+    }
+
+    mGameState.SaveAsync(
+        saveFile,
+        [this, path=saveFile.mPath](bool saved){
+            if (!saved)
+            {
+                mLogger.Error() << "Game was not saved to: " << path << std::endl;
+            }
+        });
 }
 
 void GuiManager::SetZoneLoader(BAK::IZoneLoader* zoneLoader)
@@ -315,6 +334,7 @@ void GuiManager::TeleportToGDS(
 
 void GuiManager::OnTimeDelta(double delta)
 {
+    mGameState.GetGameData().RunSaveCompletions();
     mAnimatorStore.OnTimeDelta(delta);
 }
 
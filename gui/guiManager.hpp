@@ -152,6 +152,7 @@ public:
     IMainView& GetMainView() override;
 
 private:
+    void SaveInBackground(const BAK::SaveFile& saveFile);
     void CacheState();
     bool NotifyPartyChanges();
     void FadeInDone();
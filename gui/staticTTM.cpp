@@ -1,6 +1,7 @@
 #include "gui/staticTTM.hpp"
 
 #include "bak/palette.hpp"
+#include "bak/resourceCache.hpp"
 #include "bak/textureFactory.hpp"
 #include "bak/scene/scene.hpp"
 #include "bak/scene/sceneData.hpp"
@@ -43,7 +44,7 @@ StaticTTM::StaticTTM(
 
     constexpr auto SCENE_PALETTE_SLOT = 0;
     constexpr auto ACTOR_IMAGE_SLOT = 1;
-    std::optional<BAK::Palette> scenePalette{};
+    std::shared_ptr<const BAK::Palette> scenePalette{};
     std::optional<std::string> scenePaletteName{};
     std::optional<std::string> actorImageName{};
 
@@ -53,7 +54,7 @@ StaticTTM::StaticTTM(
         const auto scenePal = scene.mPalettes.find(SCENE_PALETTE_SLOT);
         if (scenePal != scene.mPalettes.end())
         {
-            scenePalette.emplace(scenePal->second);
+            scenePalette = BAK::ResourceCache::Get().GetPalette(scenePal->second);
             scenePaletteName = scenePal->second;
         }
 
@@ -17,6 +17,8 @@ in vec4 vertexColor;
 in vec3 uvCoords;
 in float texBlend;
 in float DistanceFromCamera;
+flat in vec4 instanceColor;
+flat in int useInstanceColor;
 
 // Ouput data
 out vec4 color;
@@ -27,8 +29,6 @@ uniform Light light;
 uniform sampler2DArray texture0;
 uniform sampler2D shadowMap;
 uniform mat4 lightSpaceMatrix;
-uniform int useInstanceColor;
-uniform vec4 instanceColor;
 
 float ShadowCalculation(vec4 fragPosLightSpace)
 {
@@ -13,6 +13,10 @@ layout(location = 1) in vec3  vertexNormal_modelspace;
 layout(location = 2) in vec4  vertexColor_modelspace;
 layout(location = 3) in vec3  textureCoords;
 layout(location = 4) in float texBlendVec;
+// Per instance
+layout(location = 5) in mat4  M;
+layout(location = 9) in vec4  instanceColorVec;
+layout(location = 10) in float useInstanceColorVec;
 
 // Output data ; will be interpolated for each fragment.
 out vec3 Position_lightSpace;
@@ -24,18 +28,21 @@ out vec4 vertexColor;
 out vec3 uvCoords;
 out float texBlend;
 out float DistanceFromCamera;
+flat out vec4 instanceColor;
+flat out int useInstanceColor;
 
 // Values that stay constant for the whole mesh.
-uniform mat4 MVP;
+uniform mat4 VP;
 uniform mat4 V;
-uniform mat4 M;
 uniform Light light;
 uniform vec3 cameraPosition_worldspace;
 uniform mat4 lightSpaceMatrix;
+// Texture coordinates arrive in texels
+uniform sampler2DArray texture0;
 
 void main(){
-	// Output position of the vertex, in clip space : MVP * position
-	gl_Position =  MVP * vec4(vertexPosition_modelspace, 1);
+	// Output position of the vertex, in clip space : VP * M * position
+	gl_Position =  VP * M * vec4(vertexPosition_modelspace, 1);
 	
 	// Position of the vertex, in worldspace : M * position
 	vec3 Position_worldspace = (M * vec4(vertexPosition_modelspace, 1)).xyz;
@@ -54,8 +61,10 @@ void main(){
 	Normal_cameraspace = normalize((V * M * vec4(vertexNormal_modelspace, 0)).xyz);
 	
 	vertexColor = vertexColor_modelspace;
-    uvCoords = textureCoords.xyz;
+    uvCoords = vec3(textureCoords.xy / vec2(textureSize(texture0, 0).xy), textureCoords.z);
     texBlend = texBlendVec;
+    instanceColor = instanceColorVec;
+    useInstanceColor = int(useInstanceColorVec);
 
     DistanceFromCamera = distance(Position_worldspace, cameraPosition_worldspace);
 }
@@ -2,12 +2,12 @@
 
 in vec3 uvCoords;
 in float texBlend;
+flat in uint entityId;
 
 // Ouput data
 out vec4 color;
 
 uniform sampler2DArray texture0;
-uniform uint entityId;
 
 void main()
 {
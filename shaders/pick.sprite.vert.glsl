@@ -5,13 +5,18 @@ layout(location = 1) in vec3  vertexNormal_modelspace;
 layout(location = 2) in vec4  vertexColor_modelspace;
 layout(location = 3) in vec3  textureCoords;
 layout(location = 4) in float texBlendVec;
+// Per instance
+layout(location = 5) in mat4  M;
+layout(location = 11) in uint instanceEntityId;
 
 out vec3 uvCoords;
 out float texBlend;
+flat out uint entityId;
 
-uniform mat4 MVP;
-uniform mat4 M;
+uniform mat4 VP;
 uniform vec3 cameraPosition_worldspace;
+// Texture coordinates arrive in texels
+uniform sampler2DArray texture0;
 
 void main(){
     vec3 vertexPosition_worldspace = (M * vec4(vertexPosition_modelspace, 1.0)).xyz;
@@ -26,8 +31,9 @@ void main(){
 
     vec4 billboardPosition = billboardRotationMatrix * vec4(vertexPosition_modelspace, 1.0);
 
-    gl_Position = MVP * billboardPosition;
+    gl_Position = VP * M * billboardPosition;
 
-    uvCoords = textureCoords.xyz;
+    uvCoords = vec3(textureCoords.xy / vec2(textureSize(texture0, 0).xy), textureCoords.z);
     texBlend = texBlendVec;
+    entityId = instanceEntityId;
 }
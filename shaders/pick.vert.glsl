@@ -5,17 +5,24 @@ layout(location = 1) in vec3  vertexNormal_modelspace;
 layout(location = 2) in vec4  vertexColor_modelspace;
 layout(location = 3) in vec3  textureCoords;
 layout(location = 4) in float texBlendVec;
+// Per instance
+layout(location = 5) in mat4  M;
+layout(location = 11) in uint instanceEntityId;
 
 // Output data ; will be interpolated for each fragment.
 out vec3 uvCoords;
 out float texBlend;
+flat out uint entityId;
 
 // Values that stay constant for the whole mesh.
-uniform mat4 MVP;
+uniform mat4 VP;
+// Texture coordinates arrive in texels
+uniform sampler2DArray texture0;
 
 void main(){
     // Output position of the vertex, in clip space : MVP * position
-    gl_Position =  MVP * vec4(vertexPosition_modelspace, 1);
-    uvCoords = textureCoords.xyz;
+    gl_Position =  VP * M * vec4(vertexPosition_modelspace, 1);
+    uvCoords = vec3(textureCoords.xy / vec2(textureSize(texture0, 0).xy), textureCoords.z);
     texBlend = texBlendVec;
+    entityId = instanceEntityId;
 }
@@ -5,20 +5,23 @@ layout(location = 1) in vec3  vertexNormal_modelspace;
 layout(location = 2) in vec4  vertexColor_modelspace;
 layout(location = 3) in vec3  textureCoords;
 layout(location = 4) in float texBlendVec;
+// Per instance
+layout(location = 5) in mat4  M;
 
 out float texBlend;
 out vec3 uvCoords;
 out vec4 vertexColor;
 
 uniform mat4 lightSpaceMatrix;
-uniform mat4 M;
+// Texture coordinates arrive in texels
+uniform sampler2DArray texture0;
 
 void main()
 {
     gl_Position = lightSpaceMatrix * M * vec4(vertexPosition_modelspace, 1.0);
 
     vertexColor = vertexColor_modelspace;
-    uvCoords = textureCoords.xyz;
+    uvCoords = vec3(textureCoords.xy / vec2(textureSize(texture0, 0).xy), textureCoords.z);
     texBlend = texBlendVec;
 }  
 
@@ -13,6 +13,10 @@ layout(location = 1) in vec3  vertexNormal_modelspace;
 layout(location = 2) in vec4  vertexColor_modelspace;
 layout(location = 3) in vec3  textureCoords;
 layout(location = 4) in float texBlendVec;
+// Per instance
+layout(location = 5) in mat4  M;
+layout(location = 9) in vec4  instanceColorVec;
+layout(location = 10) in float useInstanceColorVec;
 
 out vec3 Position_lightSpace;
 out vec3 Normal_cameraspace;
@@ -23,13 +27,16 @@ out vec4 vertexColor;
 out vec3 uvCoords;
 out float texBlend;
 out float DistanceFromCamera;
+flat out vec4 instanceColor;
+flat out int useInstanceColor;
 
-uniform mat4 MVP;
+uniform mat4 VP;
 uniform mat4 V;
-uniform mat4 M;
 uniform Light light;
 uniform vec3 cameraPosition_worldspace;
 uniform mat4 lightSpaceMatrix;
+// Texture coordinates arrive in texels
+uniform sampler2DArray texture0;
 
 void main() {
     vec3 vertexPosition_worldspace = (M * vec4(vertexPosition_modelspace, 1.0)).xyz;
@@ -45,7 +52,7 @@ void main() {
 
     vec4 billboardPosition = billboardRotationMatrix * vec4(vertexPosition_modelspace, 1.0);
 
-    gl_Position = MVP * billboardPosition;
+    gl_Position = VP * M * billboardPosition;
 
     Position_lightSpace = (lightSpaceMatrix * vec4(vertexPosition_worldspace, 1.0)).xyz;
 
@@ -57,8 +64,10 @@ void main() {
     Normal_cameraspace = normalize((V * M * vec4(vertexNormal_modelspace, 0)).xyz);
     
     vertexColor = vertexColor_modelspace;
-    uvCoords = textureCoords.xyz;
+    uvCoords = vec3(textureCoords.xy / vec2(textureSize(texture0, 0).xy), textureCoords.z);
     texBlend = texBlendVec;
+    instanceColor = instanceColorVec;
+    useInstanceColor = int(useInstanceColorVec);
 
     DistanceFromCamera = distance(vertexPosition_worldspace, cameraPosition_worldspace);
 }
@@ -10,6 +10,8 @@ uniform vec3 cameraPosition_worldspace;
 uniform vec3 billboardCenter;
 uniform vec2 glyphOffset;
 uniform vec2 glyphSize;
+// Texture coordinates arrive in texels
+uniform sampler2DArray texture0;
 
 void main() {
     vec3 toCamera = cameraPosition_worldspace - billboardCenter;
@@ -30,5 +32,5 @@ void main() {
 
     gl_Position = VP * vec4(position_worldspace, 1.0);
 
-    uvCoords = textureCoords;
+    uvCoords = vec3(textureCoords.xy / vec2(textureSize(texture0, 0).xy), textureCoords.z);
 }